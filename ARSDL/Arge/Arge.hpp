@@ -2,12 +2,16 @@
 #include "ArGenericError.hpp"
 #include "ArSDLError.hpp"
 #include "Renderer.hpp"
+#include "EventBus.hpp"
+#include "InputLog.hpp"
 #include "Engine.hpp"
 #include "Font.hpp"
 #include "Surface.hpp"
 #include "Texture.hpp"
 #include "Util/Array2D.hpp"
 #include "Util/Grid.hpp"
+#include "Util/ChunkedGrid.hpp"
 #include "Util/Camera.hpp"
+#include "Util/TransformPoints.hpp"
 #include "Util/CameraDragger.hpp"
 #include "Util/CameraWheelScalar.hpp"
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include <numbers>
 #include <variant>
 #include <array>
+#include <span>
 #include <stack>
 #include <format>
 #include <exception>
@@ -31,6 +32,7 @@
 #include <random>
 #include <charconv>
 #include <iomanip>
+#include <bit>
 
 #define ARGE_DA(_cond) assert(_cond)
 
@@ -21,6 +21,8 @@ namespace Arge {
 
 	void Engine::Initialize()
 	{
+		if (m_bHeadless)
+			SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
 		ARGE_ERROR_HANDLE_NEG(SDL_Init(SDL_INIT_VIDEO));
 		ARGE_ERROR_HANDLE_NEG(TTF_Init());
 
@@ -31,8 +33,24 @@ namespace Arge {
 		auto const& [wt, ww, wh] {m_windowCache};
 		m_pWindow = std::make_unique<Window>(wt, ww, wh);
 		m_pRenderer = std::make_unique<Renderer>(*m_pWindow);
+		m_keyboard.RefreshKeymap();
 
-		m_optEventCache.emplace();
+		// There are no motion events until the mouse moves, so it would sit at (0, 0) until then.
+		// Played back, the recording already has the event pushed here.
+		if (!m_playFile.is_open())
+		{
+			int x{}, y{};
+			SDL_GetMouseState(&x, &y);
+			m_mouse.pos = {static_cast<float>(x), static_cast<float>(y)};
+
+			// Also goes through the events, so recordings start out where the mouse was.
+			SDL_Event motion{};
+			motion.motion.type = SDL_MOUSEMOTION;
+			motion.motion.windowID = SDL_GetWindowID(m_pWindow->ptr);
+			motion.motion.x = x;
+			motion.motion.y = y;
+			ARGE_ERROR_HANDLE_NEG(SDL_PushEvent(&motion));
+		}
 	}
 
 	void Engine::Run()
@@ -43,15 +61,24 @@ namespace Arge {
 			OnSetup();
 			for (;;)
 			{
-				auto const frameDelta {GetFrameDelta()};
+				auto frameDelta {GetFrameDelta()};
+
+				// Mouse and keyboard only change through the events, so this goes first.
+				UpdateInput();
+				if (!m_playFile.is_open())
+					HandleEvents();
+				else if (!PlayFrame(frameDelta))
+				{
+					OnShutdown();
+					break;
+				}
+				if (m_recordFile.is_open())
+					RecordFrame(frameDelta);
+
 				// Display the juicy ass frame rate and delta.
 				// This was a direct copy + paste from ArEngine2D xd.
 				UpdateTitle(frameDelta);
 
-				// Update mouse and keyboard (this does not interact with the event queue).
-				UpdateInput();
-				HandleEvents();
-
 				OnUpdate(frameDelta);
 				m_pRenderer->Present();
 			}
@@ -62,6 +89,30 @@ namespace Arge {
 		}
 	}
 
+	void Engine::Record(std::filesystem::path const& path)
+	{
+		m_recordFile.open(path, std::ios::binary);
+		if (!m_recordFile)
+		{
+			auto const pathString {path.string()};
+			throw ArGenericError{std::format("Could not open {} to record input", pathString)};
+		}
+		InputLog::WriteHeader(m_recordFile);
+	}
+
+	void Engine::Play(std::filesystem::path const& path, bool bHeadless)
+	{
+		m_playFile.open(path, std::ios::binary);
+		if (!m_playFile)
+		{
+			auto const pathString {path.string()};
+			throw ArGenericError{std::format("Could not open input log {}", pathString)};
+		}
+		InputLog::ReadHeader(m_playFile);
+		m_playedFrames = 0;
+		m_bHeadless = bHeadless;
+	}
+
 	float Engine::GetFrameDelta()
 	{
 		namespace chrono = std::chrono;
@@ -98,38 +149,101 @@ namespace Arge {
 		}
 	}
 
-	void Engine::HandleEvents() const
+	void Engine::HandleEvents()
 	{
-		SDL_Event ev { };
-		while (SDL_PollEvent(&ev))
+		// Every event leaves SDL's queue exactly once, and never goes back in.
+		m_eventBus.BeginFrame();
+		Event ev { };
+		while (SDL_PollEvent(&ev.GetRawAccess()))
 		{
-			if (ev.type == SDL_QUIT || ev.type == SDL_APP_TERMINATING)
-				std::exit(0);
-			else
-				SDL_PushEvent(&ev);
+			auto const type {ev.GetRawAccess().type};
+			if (type == SDL_QUIT || type == SDL_APP_TERMINATING)
+				Quit();
+
+			HandleEvent(ev);
 		}
+		m_eventBus.Dispatch();
 	}
 
-	void Engine::UpdateInput()
+	void Engine::Quit()
+	{
+		OnShutdown();
+		std::exit(0);
+	}
+
+	void Engine::HandleEvent(Event const& ev)
 	{
-		m_mouse.Update();
-		m_keyboard.Update();
+		auto const& raw {ev.GetRawAccess()};
+		switch (raw.type)
+		{
+		case SDL_WINDOWEVENT:
+			// Keeps the window's cached size and position up to date.
+			if (raw.window.windowID == SDL_GetWindowID(m_pWindow->ptr))
+				m_pWindow->OnWindowEvent(raw.window);
+			break;
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			m_keyboard.OnKeyEvent(raw.key);
+			break;
+		case SDL_KEYMAPCHANGED:
+			m_keyboard.RefreshKeymap();
+			break;
+		case SDL_MOUSEMOTION:
+			m_mouse.OnMotionEvent(raw.motion);
+			break;
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			m_mouse.OnButtonEvent(raw.button);
+			break;
+		default:
+			break;
+		}
+
+		m_eventBus.Push(ev);
 	}
 
-	std::optional<Event> Engine::PollNextEvent()
+	bool Engine::PlayFrame(float& dt)
 	{
-		if (SDL_PollEvent(&m_optEventCache->GetRawAccess()))
+		auto const optFrame {InputLog::ReadFrame(m_playFile, SDL_GetWindowID(m_pWindow->ptr))};
+		if (!optFrame)
+			return false;
+
+		// Live input would throw the playback off, so only quitting and the window's own events
+		// get through; the window is whatever size it is in this run, not the recorded one.
+		m_eventBus.BeginFrame();
+		Event ev { };
+		while (SDL_PollEvent(&ev.GetRawAccess()))
 		{
-			return m_optEventCache;
+			auto const type {ev.GetRawAccess().type};
+			if (type == SDL_QUIT || type == SDL_APP_TERMINATING)
+				Quit();
+			if (type == SDL_WINDOWEVENT)
+				HandleEvent(ev);
 		}
-		else
+
+		for (auto const& raw : optFrame->events)
+		{
+			HandleEvent(Event{raw});
+		}
+		m_eventBus.Dispatch();
+
+		if (InputSnapshot::Take(m_mouse, m_keyboard) != optFrame->snapshot)
 		{
-			return { };
+			throw ArGenericError{std::format("Input playback went off the recording on frame {}", m_playedFrames)};
 		}
+		++m_playedFrames;
+		dt = optFrame->dt;
+		return true;
 	}
 
-	void Engine::UnhandleLastEvent()
+	void Engine::RecordFrame(float dt)
+	{
+		InputLog::WriteFrame(m_recordFile, dt, m_eventBus.GetEvents(), InputSnapshot::Take(m_mouse, m_keyboard));
+	}
+
+	void Engine::UpdateInput()
 	{
-		SDL_PushEvent(&m_optEventCache->GetRawAccess());
+		m_mouse.BeginFrame();
+		m_keyboard.BeginFrame();
 	}
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 #include "Window.hpp"
 #include "Renderer.hpp"
 #include "Event.hpp"
+#include "EventBus.hpp"
 #include "Keyboard.hpp"
 #include "Mouse.hpp"
+#include "InputLog.hpp"
 
 namespace Arge {
 	class Engine
@@ -26,21 +28,34 @@ namespace Arge {
 
 		virtual void OnSetup() = 0;
 		virtual void OnUpdate(float dt) = 0;
+		// Called once when the window closes or a playback runs out; closing the window never 
+		// returns from Run, so this is the last chance to save anything.
+		virtual void OnShutdown() {}
 
 
 		void Initialize();
 		void Run();
 
-
-		std::optional<Event> PollNextEvent();
-		void UnhandleLastEvent();
+		// Both are called before Run. Record writes every frame's input and delta to an input log;
+		// Play feeds one back instead of the live keyboard and mouse (the window keeps its own
+		// events), and Run throws an ArGenericError out to the caller as soon as the mouse or
+		// keyboard end up different from the recording. Headless runs on SDL's dummy video 
+		// driver, so sessions can be replayed (and timed) without a screen.
+		void Record(std::filesystem::path const& path);
+		void Play(std::filesystem::path const& path, bool bHeadless = true);
 
 	private:
 		static float GetFrameDelta();
 		void UpdateTitle(float dt);
-		void HandleEvents() const;
+		void HandleEvents();
+		void HandleEvent(Event const& ev);
+		[[noreturn]] void Quit();
 		void UpdateInput();
 
+		// PlayFrame takes the place of HandleEvents; false once the recording is over.
+		bool PlayFrame(float& dt);
+		void RecordFrame(float dt);
+
 	public:
 		constexpr Window& GetWindow()
 		{
@@ -52,6 +67,12 @@ namespace Arge {
 			return *m_pRenderer;
 		}
 
+		// This frame's events; subscribe to get called with them as soon as they are pumped.
+		constexpr EventBus& GetEventBus()
+		{
+			return m_eventBus;
+		}
+
 
 		/* I just like this syntax better than the getters */
 
@@ -71,6 +92,11 @@ namespace Arge {
 		std::unique_ptr<Window> m_pWindow;
 		std::unique_ptr<Renderer> m_pRenderer;
 
-		std::optional<Event> m_optEventCache{};
+		EventBus m_eventBus{};
+
+		std::ofstream m_recordFile{};
+		std::ifstream m_playFile{};
+		size_t m_playedFrames{};
+		bool m_bHeadless{};
 	};
 }
\ No newline at end of file
@@ -186,6 +186,9 @@ namespace Arge {
 	public:
 		constexpr Event() = default;
 
+		constexpr explicit Event(SDL_Event const& ev) : m_ev{ev}
+		{ }
+
 	public:
 		constexpr SDL_Event& GetRawAccess()
 		{
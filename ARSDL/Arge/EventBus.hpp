@@ -0,0 +1,126 @@
+#pragma once
+#include "ArgeCore.hpp"
+#include "Enums.hpp"
+#include "Event.hpp"
+
+namespace Arge {
+	/// The events of one frame, pumped out of SDL once and kept in an array. Whoever only cares 
+	/// about some types subscribes to them and gets called with each one; whoever wants to look 
+	/// through all of them reads GetEvents. Nothing ever goes back into SDL's queue.
+	class EventBus
+	{
+	public:
+		using Handler        = std::function<void(Event const&)>;
+		using SubscriptionId = size_t;
+
+	public:
+		// Safe to call from inside a handler; the new one starts hearing from the next Dispatch.
+		SubscriptionId Subscribe(EventType type, Handler handler)
+		{
+			auto const id {m_NextId++};
+			(m_bDispatching ? m_Pending : m_Subscribers[type]).push_back({id, type, std::move(handler)});
+			return id;
+		}
+
+		// Safe to call from inside a handler, even the one being unsubscribed.
+		void Unsubscribe(SubscriptionId id)
+		{
+			auto const kill {[id](std::vector<Subscriber>& subs) {
+				for (auto& sub : subs)
+				{
+					sub.bAlive = sub.bAlive && sub.id != id;
+				}
+			}};
+			for (auto& [type, subs] : m_Subscribers)
+			{
+				kill(subs);
+			}
+			kill(m_Pending);
+
+			if (!m_bDispatching)
+			{
+				RemoveDead();
+			}
+		}
+
+		// Forgets last frame's events.
+		void BeginFrame()
+		{
+			m_Events.clear();
+		}
+
+		void Push(Event const& ev)
+		{
+			m_Events.push_back(ev);
+		}
+
+		// Every event goes to the handlers of its type, in the order they were pushed.
+		void Dispatch()
+		{
+			m_bDispatching = true;
+			for (auto const& ev : m_Events)
+			{
+				auto const it {m_Subscribers.find(ev.GetType())};
+				if (it == m_Subscribers.end())
+				{
+					continue;
+				}
+				// Only flags change while dispatching, so the list stays where it is.
+				for (auto const& sub : it->second)
+				{
+					if (sub.bAlive)
+					{
+						sub.handler(ev);
+					}
+				}
+			}
+			m_bDispatching = false;
+
+			for (auto& sub : m_Pending)
+			{
+				m_Subscribers[sub.type].push_back(std::move(sub));
+			}
+			m_Pending.clear();
+			RemoveDead();
+		}
+
+		[[nodiscard]]
+		std::span<Event const> GetEvents() const
+		{
+			return m_Events;
+		}
+
+		[[nodiscard]]
+		size_t GetSubscriberCount(EventType type) const
+		{
+			auto const it {m_Subscribers.find(type)};
+			return it == m_Subscribers.end() ? 0 : it->second.size();
+		}
+
+	private:
+		struct Subscriber
+		{
+			SubscriptionId id;
+			EventType type;
+			Handler handler;
+			bool bAlive{true};
+		};
+
+	private:
+		void RemoveDead()
+		{
+			for (auto& [type, subs] : m_Subscribers)
+			{
+				std::erase_if(subs, [](Subscriber const& sub) { return !sub.bAlive; });
+			}
+			std::erase_if(m_Pending, [](Subscriber const& sub) { return !sub.bAlive; });
+		}
+
+	private:
+		std::vector<Event> m_Events{};
+		std::unordered_map<EventType, std::vector<Subscriber>> m_Subscribers{};
+		std::vector<Subscriber> m_Pending{};
+		SubscriptionId m_NextId{};
+		bool m_bDispatching{};
+	};
+}
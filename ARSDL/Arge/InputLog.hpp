@@ -0,0 +1,260 @@
+#pragma once
+#include "ArgeCore.hpp"
+#include "ArGenericError.hpp"
+#include "Enums.hpp"
+#include "Event.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+
+#include <SDL/SDL.h>
+
+namespace Arge {
+	/// What the mouse and the keyboard looked like at the end of a frame's events.
+	struct InputSnapshot
+	{
+		Vec2 mousePos{};
+		// Bit 0 is left, 1 mid, 2 right.
+		uint8_t mouseButtons{};
+		std::vector<SDL_Scancode> heldKeys{};
+
+		static InputSnapshot Take(Mouse const& mouse, Keyboard const& keyboard)
+		{
+			auto const held {keyboard.GetHeldKeys()};
+			return {
+				mouse.pos,
+				static_cast<uint8_t>(mouse.left.IsDown() | mouse.mid.IsDown() << 1 | mouse.right.IsDown() << 2),
+				{held.begin(), held.end()},
+			};
+		}
+
+		bool operator==(InputSnapshot const& rhs) const
+		{
+			return mousePos.x == rhs.mousePos.x && mousePos.y == rhs.mousePos.y
+				&& mouseButtons == rhs.mouseButtons && heldKeys == rhs.heldKeys;
+		}
+	};
+
+	/// One frame of input: how long it took, and the events it got.
+	struct InputFrame
+	{
+		float dt{};
+		std::vector<SDL_Event> events{};
+		InputSnapshot snapshot{};
+	};
+
+	/// A recorded session, frame after frame, so it can be played back exactly (see
+	/// Engine::Record and Engine::Play). Little-endian, no padding:
+	///   "ARINPUT\0", uint32 version
+	///   per frame: float dt, uint32 eventCount, float mouseX, mouseY, uint8 mouseButtons,
+	///              uint8 heldKeyCount, event[eventCount], uint16 heldKeys[heldKeyCount]
+	///   per event: uint32 type, then by type
+	///     key:     uint16 scancode, int32 sym, uint16 mod, uint8 state, uint8 repeat
+	///     motion:  uint32 state, int32 x, y, xrel, yrel
+	///     button:  uint8 button, state, clicks, int32 x, y
+	///     wheel:   int32 x, y, uint32 direction, float preciseX, preciseY, int32 mouseX, mouseY
+	/// Only the keyboard and mouse are kept, and only what they say; timestamps and window ids
+	/// mean nothing in another run, and the window sends its own events every run anyways.
+	namespace InputLog {
+		inline constexpr std::array<char, 8> Magic{'A', 'R', 'I', 'N', 'P', 'U', 'T', '\0'};
+		inline constexpr uint32_t Version{2};
+
+		static_assert(std::endian::native == std::endian::little, "Input logs are little-endian");
+
+		constexpr bool IsRecorded(Uint32 type)
+		{
+			switch (type)
+			{
+			case SDL_KEYDOWN:
+			case SDL_KEYUP:
+			case SDL_MOUSEMOTION:
+			case SDL_MOUSEBUTTONDOWN:
+			case SDL_MOUSEBUTTONUP:
+			case SDL_MOUSEWHEEL:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		namespace Secret {
+			template <class T>
+			void Write(std::ostream& out, T const& value)
+			{
+				out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+			}
+
+			template <class T>
+			bool Read(std::istream& in, T& value)
+			{
+				return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+			}
+
+			// Only for the types IsRecorded lets through.
+			inline void WriteEvent(std::ostream& out, SDL_Event const& ev)
+			{
+				Write(out, ev.type);
+				switch (ev.type)
+				{
+				case SDL_KEYDOWN:
+				case SDL_KEYUP:
+					Write(out, static_cast<uint16_t>(ev.key.keysym.scancode));
+					Write(out, ev.key.keysym.sym);
+					Write(out, ev.key.keysym.mod);
+					Write(out, ev.key.state);
+					Write(out, ev.key.repeat);
+					break;
+				case SDL_MOUSEMOTION:
+					Write(out, ev.motion.state);
+					Write(out, ev.motion.x);
+					Write(out, ev.motion.y);
+					Write(out, ev.motion.xrel);
+					Write(out, ev.motion.yrel);
+					break;
+				case SDL_MOUSEBUTTONDOWN:
+				case SDL_MOUSEBUTTONUP:
+					Write(out, ev.button.button);
+					Write(out, ev.button.state);
+					Write(out, ev.button.clicks);
+					Write(out, ev.button.x);
+					Write(out, ev.button.y);
+					break;
+				case SDL_MOUSEWHEEL:
+					Write(out, ev.wheel.x);
+					Write(out, ev.wheel.y);
+					Write(out, ev.wheel.direction);
+					Write(out, ev.wheel.preciseX);
+					Write(out, ev.wheel.preciseY);
+					Write(out, ev.wheel.mouseX);
+					Write(out, ev.wheel.mouseY);
+					break;
+				default:
+					break;
+				}
+			}
+
+			// Everything that is not in the log stays zero, except for the window id.
+			inline bool ReadEvent(std::istream& in, SDL_Event& ev, Uint32 windowID)
+			{
+				std::memset(&ev, 0, sizeof(SDL_Event));
+				if (!Read(in, ev.type))
+				{
+					return false;
+				}
+
+				switch (ev.type)
+				{
+				case SDL_KEYDOWN:
+				case SDL_KEYUP:
+				{
+					uint16_t scancode{};
+					ev.key.windowID = windowID;
+					auto const bOk {Read(in, scancode) && Read(in, ev.key.keysym.sym) && Read(in, ev.key.keysym.mod)
+						&& Read(in, ev.key.state) && Read(in, ev.key.repeat)};
+					ev.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+					return bOk;
+				}
+				case SDL_MOUSEMOTION:
+					ev.motion.windowID = windowID;
+					return Read(in, ev.motion.state) && Read(in, ev.motion.x) && Read(in, ev.motion.y)
+						&& Read(in, ev.motion.xrel) && Read(in, ev.motion.yrel);
+				case SDL_MOUSEBUTTONDOWN:
+				case SDL_MOUSEBUTTONUP:
+					ev.button.windowID = windowID;
+					return Read(in, ev.button.button) && Read(in, ev.button.state) && Read(in, ev.button.clicks)
+						&& Read(in, ev.button.x) && Read(in, ev.button.y);
+				case SDL_MOUSEWHEEL:
+					ev.wheel.windowID = windowID;
+					return Read(in, ev.wheel.x) && Read(in, ev.wheel.y) && Read(in, ev.wheel.direction)
+						&& Read(in, ev.wheel.preciseX) && Read(in, ev.wheel.preciseY)
+						&& Read(in, ev.wheel.mouseX) && Read(in, ev.wheel.mouseY);
+				default:
+					throw ArGenericError{std::format("Input log has an event of type {}, which is never recorded", ev.type)};
+				}
+			}
+		}
+
+		inline void WriteHeader(std::ostream& out)
+		{
+			Secret::Write(out, Magic);
+			Secret::Write(out, Version);
+		}
+
+		// Throws an ArGenericError if in is not an input log, or one of another version.
+		inline void ReadHeader(std::istream& in)
+		{
+			std::array<char, 8> magic{};
+			uint32_t version{};
+			if (!Secret::Read(in, magic) || magic != Magic || !Secret::Read(in, version))
+			{
+				throw ArGenericError{"Not an input log"};
+			}
+			if (version != Version)
+			{
+				throw ArGenericError{std::format("Input log version {} is not supported, only {}", version, Version)};
+			}
+		}
+
+		// Events that are not recorded are left out.
+		inline void WriteFrame(std::ostream& out, float dt, std::span<Event const> events,
+			InputSnapshot const& snapshot)
+		{
+			if (snapshot.heldKeys.size() > std::numeric_limits<uint8_t>::max())
+			{
+				throw ArGenericError{std::format("{} keys are held down, an input log only has room for {}",
+					snapshot.heldKeys.size(), std::numeric_limits<uint8_t>::max())};
+			}
+			auto const eventCount {static_cast<uint32_t>(std::ranges::count_if(events,
+				[](Event const& ev) { return IsRecorded(ev.GetRawAccess().type); }))};
+			Secret::Write(out, dt);
+			Secret::Write(out, eventCount);
+			Secret::Write(out, snapshot.mousePos.x);
+			Secret::Write(out, snapshot.mousePos.y);
+			Secret::Write(out, snapshot.mouseButtons);
+			Secret::Write(out, static_cast<uint8_t>(snapshot.heldKeys.size()));
+			for (auto const& ev : events)
+			{
+				if (IsRecorded(ev.GetRawAccess().type))
+				{
+					Secret::WriteEvent(out, ev.GetRawAccess());
+				}
+			}
+			for (auto const scancode : snapshot.heldKeys)
+			{
+				Secret::Write(out, static_cast<uint16_t>(scancode));
+			}
+		}
+
+		// std::nullopt once the log is over; throws an ArGenericError if it stops in the middle
+		// of a frame. Window ids are handed out anew every run, so the events get windowID.
+		inline std::optional<InputFrame> ReadFrame(std::istream& in, Uint32 windowID = 0)
+		{
+			InputFrame res{};
+			if (!Secret::Read(in, res.dt))
+			{
+				return std::nullopt;
+			}
+
+			uint32_t eventCount{};
+			uint8_t heldKeyCount{};
+			auto bOk {Secret::Read(in, eventCount) && Secret::Read(in, res.snapshot.mousePos.x)
+				&& Secret::Read(in, res.snapshot.mousePos.y) && Secret::Read(in, res.snapshot.mouseButtons)
+				&& Secret::Read(in, heldKeyCount)};
+			for (uint32_t i{}; bOk && i < eventCount; ++i)
+			{
+				bOk = Secret::ReadEvent(in, res.events.emplace_back(), windowID);
+			}
+			for (uint8_t i{}; bOk && i < heldKeyCount; ++i)
+			{
+				uint16_t scancode{};
+				bOk = Secret::Read(in, scancode);
+				res.snapshot.heldKeys.push_back(static_cast<SDL_Scancode>(scancode));
+			}
+
+			if (!bOk)
+			{
+				throw ArGenericError{"Input log is cut off in the middle of a frame"};
+			}
+			return res;
+		}
+	}
+}
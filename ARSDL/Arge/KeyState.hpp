@@ -12,11 +12,20 @@ namespace Arge {
 		constexpr KeyState& operator=(KeyState&&)      = default;
 
 	public:
-		constexpr void Update(bool bStateCurrFrame)
+		// Fed by the key and button events; a key that goes down and up within the same frame is
+		// both pressed and released in it.
+		constexpr void OnEvent(bool bDownNow)
 		{
-			bPressed = !bDown && bStateCurrFrame;
-			bReleased = bDown && !bStateCurrFrame;
-			bDown = bStateCurrFrame;
+			bPressed = bPressed || (!bDown && bDownNow);
+			bReleased = bReleased || (bDown && !bDownNow);
+			bDown = bDownNow;
+		}
+
+		// The edges only last a frame.
+		constexpr void ClearEdges()
+		{
+			bPressed = false;
+			bReleased = false;
 		}
 
 		constexpr operator bool() const
@@ -41,10 +50,10 @@ namespace Arge {
 
 	private:
 		// true whenever the button is clicked and as long as it remains clicks.
-		bool bDown;
+		bool bDown{};
 		// true only in the frame the button is hit.
-		bool bPressed;
+		bool bPressed{};
 		// true only in the frame the button is released.
-		bool bReleased;
+		bool bReleased{};
 	};
 }
\ No newline at end of file
@@ -2,24 +2,18 @@
 #include "Keyboard.hpp"
 
 namespace Arge {
-	Keyboard::Keyboard()
-	{
-		int keyCount;
-		(void)SDL_GetKeyboardState(&keyCount);
-		m_keys.resize(static_cast<size_t>(keyCount));
-	}
-	
 	void Keyboard::Flush()
 	{
-		std::memset(m_keys.data(), 0, m_keys.size() * sizeof KeyState);
+		m_keys.fill({});
+		m_dirty.clear();
+		m_held.clear();
 	}
-	
-	void Keyboard::Update()
+
+	void Keyboard::RefreshKeymap()
 	{
-		auto const states{SDL_GetKeyboardState(nullptr)};
-		for (size_t i{ }; i < m_keys.size(); ++i)
+		for (size_t kc{}; kc < CharKeyCount; ++kc)
 		{
-			m_keys[i].Update(states[i]);
+			m_charScancodes[kc] = SDL_GetScancodeFromKey(static_cast<SDL_Keycode>(kc));
 		}
 	}
 
@@ -29,6 +23,6 @@ namespace Arge {
 		auto const myChar{std::tolower(ch)};
 #endif
 		ARGE_DA('a' <= myChar && myChar <= 'z');
-		return m_keys[SDL_GetScancodeFromKey(static_cast<SDL_Keycode>(ch))];
+		return m_keys[ToScancode(static_cast<SDL_Keycode>(ch))];
 	}
 }
@@ -6,21 +6,70 @@
 #include <SDL/SDL.h>
 
 namespace Arge {
+	/// Driven by the key events the Engine pumps, so a frame only touches the keys that actually
+	/// changed; the ones whose edges need clearing next frame are kept in a short dirty list.
 	class Keyboard
 	{
 	public:
-		Keyboard();
+		Keyboard() = default;
 		Keyboard(Keyboard const&)            = delete;
 		Keyboard(Keyboard&&)                 = delete;
 		Keyboard& operator=(Keyboard const&) = delete;
 		Keyboard& operator=(Keyboard&&)      = delete;
 
 		void Flush();
-		void Update();
+
+		// Asks SDL where every character key is on the current layout, so looking one up never 
+		// has to; the Engine calls it on startup and whenever the keymap changes.
+		void RefreshKeymap();
+
+		// Only clears the edges of the keys that changed last frame.
+		constexpr void BeginFrame()
+		{
+			for (auto const scancode : m_dirty)
+			{
+				m_keys[scancode].ClearEdges();
+			}
+			m_dirty.clear();
+		}
+
+		constexpr void OnKeyEvent(SDL_KeyboardEvent const& ev)
+		{
+			auto const scancode {ev.keysym.scancode};
+			if (ev.repeat || scancode <= SDL_SCANCODE_UNKNOWN || scancode >= SDL_NUM_SCANCODES)
+			{
+				return;
+			}
+
+			// The event says where the key is, in case RefreshKeymap was never called.
+			if (0 <= ev.keysym.sym && ev.keysym.sym < CharKeyCount)
+			{
+				m_charScancodes[ev.keysym.sym] = scancode;
+			}
+			auto& key {m_keys[scancode]};
+			auto const bWasDown {key.IsDown()};
+			key.OnEvent(ev.state == SDL_PRESSED);
+			m_dirty.push_back(scancode);
+
+			if (!bWasDown && key.IsDown())
+			{
+				m_held.push_back(scancode);
+			}
+			else if (bWasDown && !key.IsDown())
+			{
+				std::erase(m_held, scancode);
+			}
+		}
+
+		// Every key that is down, in the order they went down.
+		constexpr std::span<SDL_Scancode const> GetHeldKeys() const
+		{
+			return m_held;
+		}
 
 		constexpr KeyState const& operator[](Keycode kc) const
 		{
-			return m_keys[SDL_GetScancodeFromKey(static_cast<SDL_Keycode>(kc))];
+			return m_keys[ToScancode(static_cast<SDL_Keycode>(kc))];
 		}
 
 		KeyState const& operator[](char ch) const;
@@ -31,6 +80,24 @@ namespace Arge {
 		}
 
 	private:
-		std::vector<KeyState> m_keys;
+		// Keycodes below this are characters, and where they are depends on the layout; every
+		// other keycode is its scancode with SDLK_SCANCODE_MASK set.
+		static constexpr size_t CharKeyCount{128};
+
+		constexpr SDL_Scancode ToScancode(SDL_Keycode kc) const
+		{
+			if (kc & SDLK_SCANCODE_MASK)
+			{
+				auto const scancode {kc & ~SDLK_SCANCODE_MASK};
+				return scancode < SDL_NUM_SCANCODES ? static_cast<SDL_Scancode>(scancode) : SDL_SCANCODE_UNKNOWN;
+			}
+			return 0 <= kc && kc < static_cast<SDL_Keycode>(CharKeyCount) ? m_charScancodes[kc] : SDL_SCANCODE_UNKNOWN;
+		}
+
+	private:
+		std::array<KeyState, SDL_NUM_SCANCODES> m_keys{};
+		std::array<SDL_Scancode, CharKeyCount> m_charScancodes{};
+		std::vector<SDL_Scancode> m_dirty{};
+		std::vector<SDL_Scancode> m_held{};
 	};
-}
\ No newline at end of file
+}
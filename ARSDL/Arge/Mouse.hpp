@@ -6,6 +6,7 @@
 #include <SDL/SDL.h>
 
 namespace Arge {
+	/// Driven by the motion and button events the Engine pumps, like the Keyboard.
 	class Mouse
 	{
 	public:
@@ -16,7 +17,30 @@ namespace Arge {
 		Mouse& operator=(Mouse&&)      = delete;
 
 	public:
-		void Update();
+		constexpr void BeginFrame()
+		{
+			left.ClearEdges();
+			mid.ClearEdges();
+			right.ClearEdges();
+		}
+
+		constexpr void OnMotionEvent(SDL_MouseMotionEvent const& ev)
+		{
+			pos = {static_cast<float>(ev.x), static_cast<float>(ev.y)};
+		}
+
+		constexpr void OnButtonEvent(SDL_MouseButtonEvent const& ev)
+		{
+			pos = {static_cast<float>(ev.x), static_cast<float>(ev.y)};
+			auto const bDown {ev.state == SDL_PRESSED};
+			switch (ev.button)
+			{
+			case SDL_BUTTON_LEFT:   left.OnEvent(bDown);  break;
+			case SDL_BUTTON_MIDDLE: mid.OnEvent(bDown);   break;
+			case SDL_BUTTON_RIGHT:  right.OnEvent(bDown); break;
+			default: break;
+			}
+		}
 
 	public:
 		Vec2 pos;
@@ -24,4 +48,4 @@ namespace Arge {
 		KeyState mid;
 		KeyState right;
 	};
-}
\ No newline at end of file
+}
@@ -10,6 +10,9 @@ namespace Arge {
 	Renderer::Renderer(Window& window) :
 		ptr{SDL_CreateRenderer(window.ptr, -1, SDL_RendererFlags::SDL_RENDERER_ACCELERATED)}
 	{
+		// No GPU, e.g. headless on the dummy video driver.
+		if (!ptr)
+			ptr = SDL_CreateRenderer(window.ptr, -1, SDL_RendererFlags::SDL_RENDERER_SOFTWARE);
 		ARGE_ERROR_HANDLE_NULL(ptr);
 	}
 
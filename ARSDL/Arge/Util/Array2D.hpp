@@ -1,18 +1,82 @@
 #pragma once
 #include "ArgeCore.hpp"
 #include "ArSDLError.hpp"
+#include "Array2DLayout.hpp"
 
 namespace Arge {
-	template <class TValue>
+	/// TLayout decides where the cells go in memory (see Array2DLayout.hpp); nothing else about
+	/// the interface changes, except that GetDataPtr and the iterators go in that order.
+	template <class TValue, class TLayout = RowMajorLayout>
 	class Array2D
 	{
 	private:
 		using Self = Array2D;
 
 	public:
-		Array2D(size_t width, size_t height) : m_Width{width}, m_Height{height}
+		/// Walks the cells in memory order, skipping the padding some layouts have.
+		template <class TPointer>
+		class CellIterator
 		{
-			m_Data.resize(width * height);
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = TValue;
+			using difference_type   = ssize_t;
+			using reference         = std::iter_reference_t<TPointer>;
+			using pointer           = TPointer;
+
+			constexpr CellIterator() = default;
+			constexpr CellIterator(TPointer pData, TLayout const* pLayout, size_t index, size_t end, bool bPadded)
+				: m_pData{pData}, m_pLayout{pLayout}, m_Index{index}, m_End{end}, m_bPadded{bPadded}
+			{
+				SkipPadding();
+			}
+
+			constexpr auto& operator*() const
+			{
+				return m_pData[m_Index];
+			}
+
+			constexpr CellIterator& operator++()
+			{
+				++m_Index;
+				SkipPadding();
+				return *this;
+			}
+
+			constexpr CellIterator operator++(int)
+			{
+				auto const res {*this};
+				++*this;
+				return res;
+			}
+
+			[[nodiscard]]
+			constexpr bool operator==(CellIterator const& rhs) const
+			{
+				return m_Index == rhs.m_Index;
+			}
+
+		private:
+			constexpr void SkipPadding()
+			{
+				while (m_bPadded && m_Index < m_End && !m_pLayout->IsCell(m_Index))
+				{
+					++m_Index;
+				}
+			}
+
+		private:
+			TPointer m_pData{};
+			TLayout const* m_pLayout{};
+			size_t m_Index{};
+			size_t m_End{};
+			// Sizes that need no rounding up get no padding either.
+			bool m_bPadded{};
+		};
+
+		Array2D(size_t width, size_t height) : m_Width{width}, m_Height{height}, m_Layout{width, height}
+		{
+			m_Data.resize(m_Layout.GetStorageSize());
 		}
 
 		[[nodiscard]]
@@ -23,7 +87,7 @@ namespace Arge {
 		{
 			ARGE_DA(x < m_Width);
 			ARGE_DA(y < m_Height);
-			return m_Data[x + y * m_Width];
+			return m_Data[m_Layout.IndexOf(x, y)];
 		}
 
 		[[nodiscard]]
@@ -32,11 +96,19 @@ namespace Arge {
 			return const_cast<Self&>(*this).At(x, y);
 		}
 
+		/// Same as At(index % width, index / width), whatever the layout.
 		[[nodiscard]]
 		constexpr TValue& AtIndex(size_t index)
 		{
 			ARGE_DA(index < GetSize());
-			return m_Data[index];
+			if constexpr (std::same_as<TLayout, RowMajorLayout>)
+			{
+				return m_Data[index];
+			}
+			else
+			{
+				return At(index % m_Width, index / m_Width);
+			}
 		}
 
 		[[nodiscard]]
@@ -60,7 +132,7 @@ namespace Arge {
 		[[nodiscard]]
 		constexpr size_t GetSize() const
 		{
-			return m_Data.size();
+			return m_Width * m_Height;
 		}
 
 		[[nodiscard]]
@@ -87,15 +159,45 @@ namespace Arge {
 			return 0 <= x  && x < m_Width && 0 <= y && y < m_Height;
 		}
 
-		// No c or r versions for now.
-		constexpr auto begin() const { return m_Data.begin(); }
-		constexpr auto end()   const { return m_Data.end(); }
-		constexpr auto begin() { return m_Data.begin(); }
-		constexpr auto end()   { return m_Data.end(); }
+		// No c or r versions for now. Without padding the cells are just the vector.
+		constexpr auto begin() const { return Begin(*this); }
+		constexpr auto end()   const { return End(*this); }
+		constexpr auto begin() { return Begin(*this); }
+		constexpr auto end()   { return End(*this); }
+
+	private:
+		template <class TSelf>
+		static constexpr auto Begin(TSelf& self)
+		{
+			if constexpr (TLayout::HasPadding)
+			{
+				return CellIterator<decltype(self.m_Data.data())>{
+					self.m_Data.data(), &self.m_Layout, 0, self.m_Data.size(), self.m_Data.size() != self.GetSize()};
+			}
+			else
+			{
+				return self.m_Data.begin();
+			}
+		}
+
+		template <class TSelf>
+		static constexpr auto End(TSelf& self)
+		{
+			if constexpr (TLayout::HasPadding)
+			{
+				return CellIterator<decltype(self.m_Data.data())>{
+					self.m_Data.data(), &self.m_Layout, self.m_Data.size(), self.m_Data.size(), false};
+			}
+			else
+			{
+				return self.m_Data.end();
+			}
+		}
 
 	private:
 		size_t m_Width;
 		size_t m_Height;
+		TLayout m_Layout;
 		std::vector<TValue> m_Data{};
 	};
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+#include "ArgeCore.hpp"
+
+namespace Arge {
+	// Where each cell of an Array2D goes in memory. A layout only maps (x, y) to an index; layouts
+	// that need more room than there are cells (HasPadding) also say which indices are real cells.
+
+	/// Rows one after the other. Walking along x is as cheap as it gets, walking along y jumps a
+	/// whole row.
+	class RowMajorLayout
+	{
+	public:
+		static constexpr bool HasPadding{false};
+
+		constexpr RowMajorLayout(size_t width, size_t height) : m_Width{width}, m_Height{height}
+		{
+		}
+
+		[[nodiscard]]
+		constexpr bool operator==(RowMajorLayout const& rhs) const = default;
+
+		[[nodiscard]]
+		constexpr size_t IndexOf(size_t x, size_t y) const
+		{
+			return x + y * m_Width;
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetStorageSize() const
+		{
+			return m_Width * m_Height;
+		}
+
+	private:
+		size_t m_Width;
+		size_t m_Height;
+	};
+
+	/// TileSize x TileSize squares one after the other (row-major inside of them, and between
+	/// them), so a cell's neighbours are mostly in the same few cache lines. The tiles on the
+	/// right and bottom edges are cut short instead of padded.
+	template <size_t TileSize = 8>
+	class TiledLayout
+	{
+		static_assert(std::has_single_bit(TileSize), "Tiles should be a power of two wide");
+
+	public:
+		static constexpr bool HasPadding{false};
+
+		constexpr TiledLayout(size_t width, size_t height) : m_Width{width}, m_Height{height}
+		{
+		}
+
+		[[nodiscard]]
+		constexpr bool operator==(TiledLayout const& rhs) const = default;
+
+		[[nodiscard]]
+		constexpr size_t IndexOf(size_t x, size_t y) const
+		{
+			auto const tileLeft {x & ~(TileSize - 1)};
+			auto const tileTop {y & ~(TileSize - 1)};
+			auto const tileWidth {std::min(TileSize, m_Width - tileLeft)};
+			auto const tileHeight {std::min(TileSize, m_Height - tileTop)};
+			// Full rows of tiles above, then the tiles to the left, then the cell in its own tile.
+			return tileTop * m_Width + tileLeft * tileHeight + (y - tileTop) * tileWidth + (x - tileLeft);
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetStorageSize() const
+		{
+			return m_Width * m_Height;
+		}
+
+	private:
+		size_t m_Width;
+		size_t m_Height;
+	};
+
+	/// Z-order: the bits of x and y interleaved, so cells that are close in both directions are
+	/// close in memory at every scale. Each side gets rounded up to a power of two, and whatever
+	/// one side has over the other goes on top (so a long thin grid is a row of squares).
+	class MortonLayout
+	{
+	public:
+		static constexpr bool HasPadding{true};
+
+		constexpr MortonLayout(size_t width, size_t height)
+			: m_Width{width}, m_Height{height},
+			  m_BitsX{static_cast<size_t>(std::bit_width(width > 0 ? width - 1 : 0))},
+			  m_BitsY{static_cast<size_t>(std::bit_width(height > 0 ? height - 1 : 0))},
+			  m_SharedBits{std::min(m_BitsX, m_BitsY)}
+		{
+		}
+
+		[[nodiscard]]
+		constexpr bool operator==(MortonLayout const& rhs) const = default;
+
+		[[nodiscard]]
+		constexpr size_t IndexOf(size_t x, size_t y) const
+		{
+			auto const lowMask {(size_t{1} << m_SharedBits) - 1};
+			auto const low {Spread(x & lowMask) | (Spread(y & lowMask) << 1)};
+			auto const high {(m_BitsX > m_BitsY ? x : y) >> m_SharedBits};
+			return low | (high << (2 * m_SharedBits));
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetStorageSize() const
+		{
+			return (m_Width == 0 || m_Height == 0) ? 0 : size_t{1} << (m_BitsX + m_BitsY);
+		}
+
+		/// False for the padding that rounding up to a power of two added.
+		[[nodiscard]]
+		constexpr bool IsCell(size_t index) const
+		{
+			auto const low {index & ((size_t{1} << (2 * m_SharedBits)) - 1)};
+			auto const high {(index >> (2 * m_SharedBits)) << m_SharedBits};
+			auto x {Compact(low)};
+			auto y {Compact(low >> 1)};
+			(m_BitsX > m_BitsY ? x : y) |= high;
+			return x < m_Width && y < m_Height;
+		}
+
+	private:
+		// abcd -> 0a0b0c0d, for up to 32 bits.
+		[[nodiscard]]
+		static constexpr size_t Spread(size_t value)
+		{
+			uint64_t v {value & 0xFFFF'FFFF};
+			v = (v | (v << 16)) & 0x0000'FFFF'0000'FFFF;
+			v = (v | (v << 8))  & 0x00FF'00FF'00FF'00FF;
+			v = (v | (v << 4))  & 0x0F0F'0F0F'0F0F'0F0F;
+			v = (v | (v << 2))  & 0x3333'3333'3333'3333;
+			v = (v | (v << 1))  & 0x5555'5555'5555'5555;
+			return static_cast<size_t>(v);
+		}
+
+		// The other way around, ignoring the odd bits.
+		[[nodiscard]]
+		static constexpr size_t Compact(size_t value)
+		{
+			uint64_t v {value & 0x5555'5555'5555'5555};
+			v = (v | (v >> 1))  & 0x3333'3333'3333'3333;
+			v = (v | (v >> 2))  & 0x0F0F'0F0F'0F0F'0F0F;
+			v = (v | (v >> 4))  & 0x00FF'00FF'00FF'00FF;
+			v = (v | (v >> 8))  & 0x0000'FFFF'0000'FFFF;
+			v = (v | (v >> 16)) & 0x0000'0000'FFFF'FFFF;
+			return static_cast<size_t>(v);
+		}
+
+	private:
+		size_t m_Width;
+		size_t m_Height;
+		size_t m_BitsX;
+		size_t m_BitsY;
+		size_t m_SharedBits;
+	};
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Camera.hpp"
 #include "Window.hpp"
+#include "TransformPoints.hpp"
 
 namespace Arge {
     RectF Camera::GetRect(Window const& window) const
@@ -31,4 +32,9 @@ namespace Arge {
 	{
 		return operator[](vec);
 	}
+
+	void Camera::TransformPoints(std::span<Vec2 const> in, std::span<Vec2> out) const
+	{
+		Arge::TransformPoints(in, out, m_Translation, m_Scale, m_pWin->GetCenter());
+	}
 }
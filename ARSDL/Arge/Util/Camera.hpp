@@ -72,6 +72,10 @@ namespace Arge {
 		Vec2 operator[](Vec2 const& vec) const;
 		Vec2 RevTrans(Vec2 const& vec) const;
 
+		// Trans for a whole batch; the window center is only looked up once (see TransformPoints.hpp).
+		// in and out may be the same span.
+		void TransformPoints(std::span<Vec2 const> in, std::span<Vec2> out) const;
+
 
 		void DrawPoint(Renderer& gfx, Vec2 const& pos, Color color) const
 		{
@@ -105,21 +109,13 @@ namespace Arge {
 
 		void DrawModel(Renderer& gfx, std::vector<Vec2> points, Color color, float thick = 1.0f) const
 		{
-			for (auto& point : points)
-			{
-				point = Trans(point);
-			}
-
+			TransformPoints(points, points);
 			gfx.DrawModel(points, color, thick);
 		}
 
 		void FillModel(Renderer& gfx, std::vector<Vec2> points, Color color) const
 		{
-			for (auto& point : points)
-			{
-				point = Trans(point);
-			}
-
+			TransformPoints(points, points);
 			gfx.DrawModel(points, color);
 		}
 
@@ -5,18 +5,14 @@
 namespace Arge {
 	void CameraWheelScalar::Update(Camera& camera, Engine& engine) const
 	{
-		while (auto const ev{engine.PollNextEvent()})
+		for (auto const& ev : engine.GetEventBus().GetEvents())
 		{
-			if (ev->GetType() == EventType::MouseWheel)
+			if (ev.GetType() == EventType::MouseWheel)
 			{
-				auto const mwEv{ev->AsMouseWheelEvent()};
+				auto const mwEv{ev.AsMouseWheelEvent()};
 				auto const del{mwEv.GetVertical()};
 				camera.ScaleBy(del > 0 ? m_ScaleFactor : 1.0f / m_ScaleFactor);
 			}
-			else
-			{
-				engine.UnhandleLastEvent();
-			}
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+#include "ArgeCore.hpp"
+#include "Vec2.hpp"
+
+namespace Arge {
+	/// A grid with no edges: cells live in ChunkSize x ChunkSize chunks that only exist once
+	/// something other than the default value is written to them, and go away again once they
+	/// are back to all default. Memory goes with the area that was touched, not how far apart.
+	///
+	/// Same At(x, y) as Grid, but with signed coordinates (as long as the chunk they are in fits
+	/// in 32 bits), and reading a cell never allocates.
+	template <class TValue, size_t ChunkSize = 64>
+	class ChunkedGrid
+	{
+		static_assert(std::has_single_bit(ChunkSize), "Chunks should be a power of two wide");
+
+	private:
+		using Self = ChunkedGrid;
+
+		static constexpr int64_t ChunkShift{std::countr_zero(ChunkSize)};
+		static constexpr int64_t LocalMask{static_cast<int64_t>(ChunkSize) - 1};
+
+		struct Chunk
+		{
+			std::array<TValue, ChunkSize * ChunkSize> cells;
+			// Once this hits zero the chunk goes.
+			size_t nonDefaultCount{};
+		};
+
+	public:
+		/// Stands in for TValue&, so writing through At can allocate and evict chunks.
+		class Reference
+		{
+		public:
+			constexpr Reference(Self& grid, int64_t x, int64_t y) : m_Grid{grid}, m_X{x}, m_Y{y}
+			{
+			}
+
+			constexpr operator TValue() const
+			{
+				return std::as_const(m_Grid).At(m_X, m_Y);
+			}
+
+			constexpr Reference& operator=(TValue const& value)
+			{
+				m_Grid.Set(m_X, m_Y, value);
+				return *this;
+			}
+
+			constexpr Reference& operator=(Reference const& rhs)
+			{
+				return *this = static_cast<TValue>(rhs);
+			}
+
+		private:
+			Self& m_Grid;
+			int64_t m_X;
+			int64_t m_Y;
+		};
+
+		ChunkedGrid(float cellWidth, float cellHeight, TValue defaultValue = {})
+			: m_CellWidth{cellWidth}, m_CellHeight{cellHeight}, m_Default{defaultValue}
+		{
+		}
+
+		[[nodiscard]]
+		TValue const& At(int64_t x, int64_t y) const
+		{
+			auto const it {m_Chunks.find(KeyOf(x, y))};
+			return it == m_Chunks.end() ? m_Default : it->second->cells[LocalIndexOf(x, y)];
+		}
+
+		[[nodiscard]]
+		Reference At(int64_t x, int64_t y)
+		{
+			return {*this, x, y};
+		}
+
+		void Set(int64_t x, int64_t y, TValue const& value)
+		{
+			auto const key {KeyOf(x, y)};
+			auto it {m_Chunks.find(key)};
+			if (it == m_Chunks.end())
+			{
+				// Writing the default where there is no chunk changes nothing.
+				if (value == m_Default)
+				{
+					return;
+				}
+
+				auto pChunk {std::make_unique<Chunk>()};
+				pChunk->cells.fill(m_Default);
+				it = m_Chunks.emplace(key, std::move(pChunk)).first;
+			}
+
+			auto& chunk {*it->second};
+			auto& cell {chunk.cells[LocalIndexOf(x, y)]};
+			auto const bWasDefault {cell == m_Default};
+			auto const bIsDefault {value == m_Default};
+			cell = value;
+
+			if (bWasDefault && !bIsDefault)
+			{
+				++chunk.nonDefaultCount;
+			}
+			else if (!bWasDefault && bIsDefault && --chunk.nonDefaultCount == 0)
+			{
+				m_Chunks.erase(it);
+			}
+		}
+
+		/// Always true, there is no outside. Only here so code written for Grid still works.
+		[[nodiscard]]
+		constexpr bool IsInBounds(int64_t, int64_t) const
+		{
+			return true;
+		}
+
+		/// Calls doWhat(x, y, value) for every cell that is not the default, chunk by chunk.
+		template <std::invocable<int64_t, int64_t, TValue const&> Callable>
+		void ForEachSet(Callable&& doWhat) const
+		{
+			for (auto const& [key, pChunk] : m_Chunks)
+			{
+				auto const [chunkX, chunkY] {ChunkOf(key)};
+				for (size_t i{}; i < pChunk->cells.size(); ++i)
+				{
+					if (pChunk->cells[i] != m_Default)
+					{
+						doWhat((chunkX << ChunkShift) + static_cast<int64_t>(i % ChunkSize),
+							(chunkY << ChunkShift) + static_cast<int64_t>(i / ChunkSize), pChunk->cells[i]);
+					}
+				}
+			}
+		}
+
+		void Clear()
+		{
+			m_Chunks.clear();
+		}
+
+		[[nodiscard]]
+		size_t GetChunkCount() const
+		{
+			return m_Chunks.size();
+		}
+
+		/// In bytes, roughly; the hash map's own bookkeeping is not counted.
+		[[nodiscard]]
+		size_t GetMemoryUsage() const
+		{
+			return m_Chunks.size() * sizeof(Chunk);
+		}
+
+		[[nodiscard]]
+		constexpr TValue const& GetDefault() const
+		{
+			return m_Default;
+		}
+
+		[[nodiscard]]
+		constexpr float GetCellWidth() const
+		{
+			return m_CellWidth;
+		}
+
+		[[nodiscard]]
+		constexpr float GetCellHeight() const
+		{
+			return m_CellHeight;
+		}
+
+		/// Rounds toward negative infinity, so the cell left of 0 is -1 and not 0 again.
+		[[nodiscard]]
+		std::pair<int64_t, int64_t> ScreenToGrid(Vec2 const& point) const
+		{
+			return {
+				static_cast<int64_t>(std::floor(point.x / m_CellWidth)),
+				static_cast<int64_t>(std::floor(point.y / m_CellHeight)),
+			};
+		}
+
+		[[nodiscard]]
+		constexpr Vec2 GridToScreen(int64_t x, int64_t y) const
+		{
+			return {static_cast<float>(x) * m_CellWidth, static_cast<float>(y) * m_CellHeight};
+		}
+
+	private:
+		// Shifting a negative number right rounds down, which is exactly what chunks need.
+		[[nodiscard]]
+		static constexpr uint64_t KeyOf(int64_t x, int64_t y)
+		{
+			auto const chunkX {static_cast<uint32_t>(x >> ChunkShift)};
+			auto const chunkY {static_cast<uint32_t>(y >> ChunkShift)};
+			return (static_cast<uint64_t>(chunkY) << 32) | chunkX;
+		}
+
+		[[nodiscard]]
+		static constexpr std::pair<int64_t, int64_t> ChunkOf(uint64_t key)
+		{
+			return {
+				static_cast<int32_t>(static_cast<uint32_t>(key)),
+				static_cast<int32_t>(static_cast<uint32_t>(key >> 32)),
+			};
+		}
+
+		[[nodiscard]]
+		static constexpr size_t LocalIndexOf(int64_t x, int64_t y)
+		{
+			return static_cast<size_t>((x & LocalMask) + (y & LocalMask) * static_cast<int64_t>(ChunkSize));
+		}
+
+	private:
+		float m_CellWidth;
+		float m_CellHeight;
+		TValue m_Default;
+		std::unordered_map<uint64_t, std::unique_ptr<Chunk>> m_Chunks{};
+	};
+}
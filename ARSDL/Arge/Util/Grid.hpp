@@ -3,16 +3,20 @@
 #include "ArgeCore.hpp"
 #include "Vec2.hpp"
 #include "Array2D.hpp"
+#include "PackedArray2D.hpp"
 
 namespace Arge {
 	/// This is the exact same as Array2D, except it keeps track of the size of the cell,
 	/// and also provides transformation functions between screen-space and grid-index-space.
-	template <class TValue>
-	class Grid : public Array2D<TValue>
+	/// Values with PackedTraits are stored in a PackedArray2D instead, which is always row-major.
+	template <class TValue, class TLayout = RowMajorLayout>
+	class Grid : public std::conditional_t<PackedTraits<TValue>::BitsPerCell == 0,
+		Array2D<TValue, TLayout>, PackedArray2D<TValue, PackedTraits<TValue>::BitsPerCell>>
 	{
 	private:
 		using Self = Grid;
-		using Base = Array2D<TValue>;
+		using Base = std::conditional_t<PackedTraits<TValue>::BitsPerCell == 0,
+			Array2D<TValue, TLayout>, PackedArray2D<TValue, PackedTraits<TValue>::BitsPerCell>>;
 
 	public:
 		Grid(Self const&)                = default;
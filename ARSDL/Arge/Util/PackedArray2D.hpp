@@ -0,0 +1,455 @@
+#pragma once
+#include "ArgeCore.hpp"
+
+namespace Arge {
+	/// Grids of TValue are packed to this many bits per cell when it is not zero (see Grid.hpp).
+	/// Only worth it for small enums, since At has to hand out a proxy instead of a reference.
+	template <class TValue>
+	struct PackedTraits
+	{
+		static constexpr size_t BitsPerCell{0};
+	};
+
+	/// Read-only cells laid out exactly like a PackedArray2D, in words somebody else owns (a
+	/// memory-mapped file, say). Nothing is copied, so the words have to outlive the view.
+	template <class TValue, size_t BitsPerCell>
+	class PackedArray2DView
+	{
+		static_assert(std::has_single_bit(BitsPerCell) && BitsPerCell < 64, "Cells may not straddle words");
+
+	public:
+		using Word = uint64_t;
+
+		static constexpr size_t CellsPerWord{64 / BitsPerCell};
+
+		constexpr PackedArray2DView() = default;
+
+		constexpr PackedArray2DView(std::span<Word const> words, size_t width, size_t height)
+			: m_Words{words}, m_Width{width}, m_Height{height}, m_WordsPerRow{GetWordsPerRow(width)}
+		{
+			ARGE_DA(words.size() == m_WordsPerRow * height);
+		}
+
+		/// How many words a row of width cells takes.
+		[[nodiscard]]
+		static constexpr size_t GetWordsPerRow(size_t width)
+		{
+			return (width + CellsPerWord - 1) / CellsPerWord;
+		}
+
+		[[nodiscard]]
+		constexpr TValue At(size_t x, size_t y) const
+		{
+			ARGE_DA(x < m_Width);
+			ARGE_DA(y < m_Height);
+			return static_cast<TValue>((m_Words[y * m_WordsPerRow + x / CellsPerWord] >> ((x % CellsPerWord) * BitsPerCell)) & CellMask);
+		}
+
+		[[nodiscard]]
+		constexpr TValue AtIndex(size_t index) const
+		{
+			ARGE_DA(index < GetSize());
+			return At(index % m_Width, index / m_Width);
+		}
+
+		constexpr void ReadRow(size_t y, std::span<TValue> out) const
+		{
+			ARGE_DA(y < m_Height);
+			ARGE_DA(out.size() == m_Width);
+			auto const* const pRow {m_Words.data() + y * m_WordsPerRow};
+			for (size_t x{}; x < m_Width; ++x)
+			{
+				out[x] = static_cast<TValue>((pRow[x / CellsPerWord] >> ((x % CellsPerWord) * BitsPerCell)) & CellMask);
+			}
+		}
+
+		[[nodiscard]]
+		constexpr std::span<Word const> GetWords() const
+		{
+			return m_Words;
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetSize() const
+		{
+			return m_Width * m_Height;
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetWidth() const
+		{
+			return m_Width;
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetHeight() const
+		{
+			return m_Height;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsInBounds(std::size_t x, std::size_t y) const
+		{
+			return x < m_Width && y < m_Height;
+		}
+
+	private:
+		static constexpr Word CellMask{(Word{1} << BitsPerCell) - 1};
+
+	private:
+		std::span<Word const> m_Words{};
+		size_t m_Width{};
+		size_t m_Height{};
+		size_t m_WordsPerRow{};
+	};
+
+	/// Same interface as Array2D, but every cell only takes BitsPerCell bits. Every row starts on
+	/// a fresh word, so counting and searching goes through a whole word of cells at a time.
+	template <class TValue, size_t BitsPerCell>
+	class PackedArray2D
+	{
+		static_assert(std::has_single_bit(BitsPerCell) && BitsPerCell < 64, "Cells may not straddle words");
+
+	private:
+		using Self = PackedArray2D;
+
+	public:
+		using Word = uint64_t;
+		using View = PackedArray2DView<TValue, BitsPerCell>;
+
+	private:
+		static constexpr size_t CellsPerWord{64 / BitsPerCell};
+		static constexpr Word CellMask{(Word{1} << BitsPerCell) - 1};
+		// The lowest bit of every cell in a word.
+		static constexpr Word LowBits{~Word{0} / CellMask};
+
+	public:
+		/// Stands in for TValue&.
+		class Reference
+		{
+		public:
+			constexpr Reference(Word& word, size_t shift) : m_Word{word}, m_Shift{shift}
+			{
+			}
+
+			constexpr operator TValue() const
+			{
+				return static_cast<TValue>((m_Word >> m_Shift) & CellMask);
+			}
+
+			constexpr Reference& operator=(TValue value)
+			{
+				ARGE_DA(static_cast<Word>(value) <= CellMask);
+				m_Word = (m_Word & ~(CellMask << m_Shift)) | (static_cast<Word>(value) << m_Shift);
+				return *this;
+			}
+
+			constexpr Reference& operator=(Reference const& rhs)
+			{
+				return *this = static_cast<TValue>(rhs);
+			}
+
+		private:
+			Word& m_Word;
+			size_t m_Shift;
+		};
+
+		/// Cells in index order, read-only.
+		class Iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type        = TValue;
+			using difference_type   = ssize_t;
+			using reference         = TValue;
+			using pointer           = void;
+
+			constexpr Iterator() = default;
+			constexpr Iterator(Self const* pArray, size_t index) : m_pArray{pArray}, m_Index{index}
+			{
+			}
+
+			constexpr TValue operator*() const
+			{
+				return m_pArray->AtIndex(m_Index);
+			}
+
+			constexpr Iterator& operator++()
+			{
+				++m_Index;
+				return *this;
+			}
+
+			constexpr Iterator operator++(int)
+			{
+				auto const res {*this};
+				++m_Index;
+				return res;
+			}
+
+			constexpr bool operator==(Iterator const&) const = default;
+
+		private:
+			Self const* m_pArray{};
+			size_t m_Index{};
+		};
+
+		PackedArray2D(size_t width, size_t height)
+			: m_Width{width}, m_Height{height}, m_WordsPerRow{View::GetWordsPerRow(width)}
+		{
+			m_Data.resize(m_WordsPerRow * height);
+		}
+
+		[[nodiscard]]
+		constexpr bool operator==(Self const& rhs) const = default;
+
+		[[nodiscard]]
+		constexpr Reference At(size_t x, size_t y)
+		{
+			ARGE_DA(x < m_Width);
+			ARGE_DA(y < m_Height);
+			return {m_Data[y * m_WordsPerRow + x / CellsPerWord], (x % CellsPerWord) * BitsPerCell};
+		}
+
+		[[nodiscard]]
+		constexpr TValue At(size_t x, size_t y) const
+		{
+			return const_cast<Self&>(*this).At(x, y);
+		}
+
+		[[nodiscard]]
+		constexpr Reference AtIndex(size_t index)
+		{
+			ARGE_DA(index < GetSize());
+			return At(index % m_Width, index / m_Width);
+		}
+
+		[[nodiscard]]
+		constexpr TValue AtIndex(size_t index) const
+		{
+			return const_cast<Self&>(*this).AtIndex(index);
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetSize() const
+		{
+			return m_Width * m_Height;
+		}
+
+		/// In bytes, what the cells actually take.
+		[[nodiscard]]
+		constexpr size_t GetMemoryUsage() const
+		{
+			return m_Data.size() * sizeof(Word);
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetWidth() const
+		{
+			return m_Width;
+		}
+
+		[[nodiscard]]
+		constexpr size_t GetHeight() const
+		{
+			return m_Height;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsInBounds(std::size_t x, std::size_t y) const
+		{
+			return x < m_Width && y < m_Height;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsInBoundsSigned(std::int32_t x, std::int32_t y) const
+		{
+			return 0 <= x && static_cast<size_t>(x) < m_Width && 0 <= y && static_cast<size_t>(y) < m_Height;
+		}
+
+		constexpr void Fill(TValue value)
+		{
+			ARGE_DA(static_cast<Word>(value) <= CellMask);
+			std::ranges::fill(m_Data, LowBits * static_cast<Word>(value));
+		}
+
+		/// Packs a whole row at once, a word at a time instead of a cell at a time. Different rows
+		/// never share a word, so different threads may write different rows.
+		constexpr void WriteRow(size_t y, std::span<TValue const> values)
+		{
+			ARGE_DA(y < m_Height);
+			ARGE_DA(values.size() == m_Width);
+			auto* const pRow {m_Data.data() + y * m_WordsPerRow};
+			for (size_t word{}; word < m_WordsPerRow; ++word)
+			{
+				auto const begin {word * CellsPerWord};
+				auto const end {std::min(m_Width, begin + CellsPerWord)};
+				Word packed{};
+				for (auto x {begin}; x < end; ++x)
+				{
+					packed |= static_cast<Word>(values[x]) << ((x - begin) * BitsPerCell);
+				}
+				pRow[word] = packed;
+			}
+		}
+
+		constexpr void ReadRow(size_t y, std::span<TValue> out) const
+		{
+			GetView().ReadRow(y, out);
+		}
+
+		/// Looks at the cells without copying them; the view is only good until this is resized
+		/// or goes away.
+		[[nodiscard]]
+		constexpr View GetView() const
+		{
+			return {m_Data, m_Width, m_Height};
+		}
+
+		/// The packed words, row after row, every row GetWordsPerRow(width) words long.
+		[[nodiscard]]
+		constexpr std::span<Word const> GetWords() const
+		{
+			return m_Data;
+		}
+
+		/// Overwrites every cell at once with words laid out like GetWords; one copy, no packing.
+		constexpr void AssignWords(std::span<Word const> words)
+		{
+			ARGE_DA(words.size() == m_Data.size());
+			std::ranges::copy(words, m_Data.begin());
+		}
+
+		/// How many cells in the rectangle hold value; whatever part of it is outside is ignored.
+		[[nodiscard]]
+		constexpr size_t Count(TValue value, size_t x, size_t y, size_t width, size_t height) const
+		{
+			auto const endX {std::min(m_Width, x + width)};
+			auto const endY {std::min(m_Height, y + height)};
+			size_t res{};
+			for (auto row {y}; row < endY; ++row)
+			{
+				ForEachMatchWord(value, row, x, endX, [&res](size_t, Word matches) {
+					res += static_cast<size_t>(std::popcount(matches));
+					return false;
+				});
+			}
+			return res;
+		}
+
+		/// The closest cell holding value, counting diagonal steps as one (like a robot moves).
+		/// Ties go to the top of the ring, then its sides, then its bottom.
+		[[nodiscard]]
+		constexpr std::optional<std::pair<size_t, size_t>> FindNearest(TValue value, size_t x, size_t y) const
+		{
+			ARGE_DA(x < m_Width);
+			ARGE_DA(y < m_Height);
+			auto const maxRadius {std::max({x, m_Width - 1 - x, y, m_Height - 1 - y})};
+			for (size_t radius{}; radius <= maxRadius; ++radius)
+			{
+				auto const beginX {x - std::min(x, radius)};
+				auto const endX {std::min(m_Width, x + radius + 1)};
+
+				// The top and bottom of the ring in one go each, the sides a cell at a time.
+				if (radius <= y)
+				{
+					if (auto const col {FindInRow(value, y - radius, beginX, endX)})
+					{
+						return std::pair {*col, y - radius};
+					}
+				}
+
+				if (radius == 0)
+				{
+					continue;
+				}
+
+				for (auto row {y - std::min(y, radius - 1)}; row < std::min(m_Height, y + radius); ++row)
+				{
+					if (radius <= x && At(x - radius, row) == value)
+					{
+						return std::pair {x - radius, row};
+					}
+					if (x + radius < m_Width && At(x + radius, row) == value)
+					{
+						return std::pair {x + radius, row};
+					}
+				}
+
+				if (y + radius < m_Height)
+				{
+					if (auto const col {FindInRow(value, y + radius, beginX, endX)})
+					{
+						return std::pair {*col, y + radius};
+					}
+				}
+			}
+			return std::nullopt;
+		}
+
+		// No mutable iteration, since there is nothing to hand out references to.
+		constexpr Iterator begin() const { return {this, 0}; }
+		constexpr Iterator end()   const { return {this, GetSize()}; }
+
+	private:
+		// The lowest bit of every cell that holds value is set.
+		[[nodiscard]]
+		static constexpr Word Matches(Word word, TValue value)
+		{
+			auto diff {word ^ (LowBits * static_cast<Word>(value))};
+			// A cell matches when none of its bits differ; fold them all into its lowest one.
+			for (size_t shift{1}; shift < BitsPerCell; shift *= 2)
+			{
+				diff |= diff >> shift;
+			}
+			return ~diff & LowBits;
+		}
+
+		// Calls doWhat(firstCol, matches) for every word of the row that overlaps [beginX, endX),
+		// with the cells outside of it masked off. Stops as soon as doWhat returns true.
+		template <class Callable>
+		constexpr void ForEachMatchWord(TValue value, size_t row, size_t beginX, size_t endX,
+			Callable&& doWhat) const
+		{
+			if (beginX >= endX)
+			{
+				return;
+			}
+
+			for (auto word {beginX / CellsPerWord}; word <= (endX - 1) / CellsPerWord; ++word)
+			{
+				auto const firstCol {word * CellsPerWord};
+				auto matches {Matches(m_Data[row * m_WordsPerRow + word], value)};
+				if (beginX > firstCol)
+				{
+					matches &= ~Word{0} << ((beginX - firstCol) * BitsPerCell);
+				}
+				if (endX < firstCol + CellsPerWord)
+				{
+					matches &= ~(~Word{0} << ((endX - firstCol) * BitsPerCell));
+				}
+				if (matches != 0 && doWhat(firstCol, matches))
+				{
+					return;
+				}
+			}
+		}
+
+		[[nodiscard]]
+		constexpr std::optional<size_t> FindInRow(TValue value, size_t row, size_t beginX, size_t endX) const
+		{
+			std::optional<size_t> res{};
+			ForEachMatchWord(value, row, beginX, endX, [&res](size_t firstCol, Word matches) {
+				res = firstCol + static_cast<size_t>(std::countr_zero(matches)) / BitsPerCell;
+				return true;
+			});
+			return res;
+		}
+
+	private:
+		size_t m_Width;
+		size_t m_Height;
+		size_t m_WordsPerRow;
+		std::vector<Word> m_Data{};
+	};
+}
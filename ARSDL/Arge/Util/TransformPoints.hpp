@@ -0,0 +1,60 @@
+#pragma once
+#include "ArgeCore.hpp"
+#include "Vec2.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace Arge {
+	/// out[i] = (in[i] - translation) * scale + center, what Camera::Trans does to a single point.
+	/// A Vec2 is just two floats, so a 128 bit register takes 2 points and an AVX one 4; plain
+	/// code only mops up the rest. Same three operations in the same order as Trans, so it rounds
+	/// the same, too. in and out may be the same span.
+	inline void TransformPoints(std::span<Vec2 const> in, std::span<Vec2> out, Vec2 const& translation,
+		float scale, Vec2 const& center)
+	{
+		static_assert(sizeof(Vec2) == 2 * sizeof(float), "Vec2s have to be two floats in a row");
+		ARGE_DA(in.size() == out.size());
+
+		auto const* const pIn {reinterpret_cast<float const*>(in.data())};
+		auto* const pOut {reinterpret_cast<float*>(out.data())};
+		auto const floatCount {2 * in.size()};
+		size_t i{};
+
+#if defined(__AVX__)
+		{
+			auto const t {_mm256_setr_ps(translation.x, translation.y, translation.x, translation.y,
+				translation.x, translation.y, translation.x, translation.y)};
+			auto const c {_mm256_setr_ps(center.x, center.y, center.x, center.y,
+				center.x, center.y, center.x, center.y)};
+			auto const s {_mm256_set1_ps(scale)};
+			for (; i + 8 <= floatCount; i += 8)
+			{
+				auto const v {_mm256_loadu_ps(pIn + i)};
+				_mm256_storeu_ps(pOut + i, _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(v, t), s), c));
+			}
+		}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+		{
+			auto const t {_mm_setr_ps(translation.x, translation.y, translation.x, translation.y)};
+			auto const c {_mm_setr_ps(center.x, center.y, center.x, center.y)};
+			auto const s {_mm_set1_ps(scale)};
+			for (; i + 4 <= floatCount; i += 4)
+			{
+				auto const v {_mm_loadu_ps(pIn + i)};
+				_mm_storeu_ps(pOut + i, _mm_add_ps(_mm_mul_ps(_mm_sub_ps(v, t), s), c));
+			}
+		}
+#endif
+
+		for (; i < floatCount; i += 2)
+		{
+			pOut[i]     = (pIn[i]     - translation.x) * scale + center.x;
+			pOut[i + 1] = (pIn[i + 1] - translation.y) * scale + center.y;
+		}
+	}
+}
@@ -11,14 +11,26 @@ namespace Arge {
 		)}
 	{
 		ARGE_ERROR_HANDLE_NULL(ptr);
+		RefreshMetrics();
+	}
+
+	Window::Window(SDL_Window* myPtr) noexcept : ptr{myPtr}
+	{
+		if (ptr)
+		{
+			RefreshMetrics();
+		}
 	}
 
 	Window& Window::operator=(Window&& rhs) 
 	{
-		if (&rhs == this)
+		if (&rhs != this)
 		{
 			SDL_DestroyWindow(ptr);
 			ptr = std::exchange(rhs.ptr, nullptr);
+			m_Size = rhs.m_Size;
+			m_Position = rhs.m_Position;
+			m_Flags = rhs.m_Flags;
 		}
 		return *this;
 	}
@@ -28,95 +40,17 @@ namespace Arge {
 		SDL_DestroyWindow(ptr);
 	}
 
-	size_t Window::GetWidth() const
-	{
-		int intWidth;
-		SDL_GetWindowSize(ptr, &intWidth, nullptr);
-		return static_cast<size_t>(intWidth);
-	}
-
-	size_t Window::GetHeight() const
-	{
-		int intHeight;
-		SDL_GetWindowSize(ptr, nullptr, &intHeight);
-		return static_cast<size_t>(intHeight);
-	}
-
-	WindowSize Window::GetSize() const
-	{
-		int intWidth, intHeight;
-		SDL_GetWindowSize(ptr, &intWidth, &intHeight);
-		return {static_cast<size_t>(intWidth), static_cast<size_t>(intHeight)};
-	}
-
 	std::string_view Window::GetTitle() const
 	{
 		return SDL_GetWindowTitle(ptr);
 	}
 
-	Vec2 Window::GetPosition() const
-	{
-		int x{};
-		int y{};
-		SDL_GetWindowPosition(ptr, &x, &y);
-		return {static_cast<float>(x), static_cast<float>(y)};
-	}
-
-	Vec2 Window::GetCenter() const
-	{
-		return {GetWidth() * 0.5f, GetHeight() * 0.5f};
-	}
-
-	Rect Window::GetRect() const
-	{
-		return {0, 0, static_cast<int>(GetWidth()), static_cast<int>(GetHeight())};
-	}
-
-	RectF Window::GetFRect() const
-	{
-		return {0.0f, 0.0f, static_cast<float>(GetWidth()), static_cast<float>(GetHeight())};
-	}
-
-	bool Window::IsResizeable() const
-	{
-		return SDL_GetWindowFlags(ptr) & SDL_WINDOW_RESIZABLE;
-	}
-
-	bool Window::IsAlwaysOnTop() const
-	{
-		return SDL_GetWindowFlags(ptr) & SDL_WINDOW_ALWAYS_ON_TOP;
-	}
-
-	bool Window::IsMaximized() const
-	{
-		return SDL_GetWindowFlags(ptr) & SDL_WINDOW_MAXIMIZED;
-	}
-
-	bool Window::IsMinimized() const
-	{
-		return SDL_GetWindowFlags(ptr) & SDL_WINDOW_MINIMIZED;
-	}
-
-	bool Window::IsBorderless() const
-	{
-		return SDL_GetWindowFlags(ptr) & SDL_WINDOW_BORDERLESS;
-	}
-
-	FullScreenMode Window::GetFullScreen() const
-	{
-		if (auto const flags{SDL_GetWindowFlags(ptr)}; flags & SDL_WINDOW_FULLSCREEN)
-			return FullScreenMode::Real;
-		else if (flags & SDL_WINDOW_FULLSCREEN_DESKTOP)
-			return FullScreenMode::Fake;
-		else
-			return FullScreenMode::Off;
-	}
-
 	void Window::SetSize(size_t newWidth, size_t newHeight)
 	{
 		ARGE_DA(newWidth > 0);
 		ARGE_DA(newHeight > 0);
 		SDL_SetWindowSize(ptr, static_cast<int>(newWidth), static_cast<int>(newHeight));
+		RefreshMetrics();
 	}
 
 	void Window::SetTitle(std::string_view newTitle)
@@ -127,38 +61,86 @@ namespace Arge {
 	void Window::SetPosition(Vec2 const& newPos)
 	{
 		SDL_SetWindowPosition(ptr, static_cast<int>(newPos.x), static_cast<int>(newPos.y));
+		RefreshMetrics();
 	}
 
-	void Window::SetResizeable(bool toWhat) const
+	void Window::SetResizeable(bool toWhat)
 	{
 		SDL_SetWindowResizable(ptr, toWhat ? SDL_TRUE : SDL_FALSE);
+		RefreshFlags();
 	}
 
-	void Window::SetAlwaysOnTop(bool toWhat) const
+	void Window::SetAlwaysOnTop(bool toWhat)
 	{
 		SDL_SetWindowAlwaysOnTop(ptr, toWhat ? SDL_TRUE : SDL_FALSE);
+		RefreshFlags();
 	}
 
-	void Window::Maximize() const
+	void Window::Maximize()
 	{
 		SDL_MaximizeWindow(ptr);
 	}
 
-	void Window::Minimize() const
+	void Window::Minimize()
 	{
 		SDL_MinimizeWindow(ptr);
 	}
 
-	void Window::SetBorderless(bool toWhat) const
+	void Window::SetBorderless(bool toWhat)
 	{
 		SDL_SetWindowBordered(ptr, !toWhat ? SDL_TRUE : SDL_FALSE);
+		RefreshFlags();
 	}
 
 	void Window::SetFullScreen(FullScreenMode toWhat)
 	{
 		ARGE_ERROR_HANDLE_NEG(SDL_SetWindowFullscreen(ptr, static_cast<SDL_WindowFlags>(toWhat)));
+		RefreshMetrics();
 	}
 	
+	void Window::OnWindowEvent(SDL_WindowEvent const& ev)
+	{
+		switch (ev.event)
+		{
+		case SDL_WINDOWEVENT_RESIZED:
+		case SDL_WINDOWEVENT_SIZE_CHANGED:
+			m_Size = {static_cast<size_t>(ev.data1), static_cast<size_t>(ev.data2)};
+			break;
+		case SDL_WINDOWEVENT_MOVED:
+			m_Position = {static_cast<float>(ev.data1), static_cast<float>(ev.data2)};
+			break;
+		case SDL_WINDOWEVENT_SHOWN:
+		case SDL_WINDOWEVENT_HIDDEN:
+		case SDL_WINDOWEVENT_MINIMIZED:
+		case SDL_WINDOWEVENT_MAXIMIZED:
+		case SDL_WINDOWEVENT_RESTORED:
+			RefreshFlags();
+			break;
+		default:
+			break;
+		}
+	}
+
+	void Window::RefreshMetrics()
+	{
+		int width{};
+		int height{};
+		SDL_GetWindowSize(ptr, &width, &height);
+		m_Size = {static_cast<size_t>(width), static_cast<size_t>(height)};
+
+		int x{};
+		int y{};
+		SDL_GetWindowPosition(ptr, &x, &y);
+		m_Position = {static_cast<float>(x), static_cast<float>(y)};
+
+		RefreshFlags();
+	}
+
+	void Window::RefreshFlags()
+	{
+		m_Flags = SDL_GetWindowFlags(ptr);
+	}
+
 	void Window::ShowCursor(bool toggle)
 	{
 		SDL_ShowCursor(static_cast<bool>(toggle));
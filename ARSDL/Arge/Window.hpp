@@ -5,6 +5,7 @@
 #include "Vec2.hpp"
 #include "Enums.hpp"
 #include "RectF.hpp"
+#include "Rect.hpp"
 
 namespace Arge {
 	class Window
@@ -15,51 +16,123 @@ namespace Arge {
 		Window& operator=(Window&&);
 		~Window();
 
-		constexpr Window(Window&& rhs) noexcept : ptr{std::exchange(rhs.ptr, nullptr)}
+		constexpr Window(Window&& rhs) noexcept
+			: ptr{std::exchange(rhs.ptr, nullptr)}, m_Size{rhs.m_Size}, m_Position{rhs.m_Position}, m_Flags{rhs.m_Flags}
 		{ }
 
-		constexpr Window(SDL_Window* myPtr) noexcept : ptr{myPtr}
-		{ }
+		Window(SDL_Window* myPtr) noexcept;
 
 		Window(std::string_view title, size_t width, size_t height, WindowFlags flags = 
 			WindowFlags::Default);
 
 	public:
-		size_t GetWidth() const;
-		size_t GetHeight() const;
+		// All of these are cached, and only asked from SDL again when an event says they changed
+		// (see OnWindowEvent), so calling them every primitive costs nothing.
+		constexpr size_t GetWidth() const
+		{
+			return m_Size.width;
+		}
+
+		constexpr size_t GetHeight() const
+		{
+			return m_Size.height;
+		}
+
 		// {width, height}
-		// This is more efficient than calling GetWidth and GetHeight separately.
-		WindowSize GetSize() const;
+		constexpr WindowSize GetSize() const
+		{
+			return m_Size;
+		}
+
 		std::string_view GetTitle() const;
-		Vec2 GetPosition() const;
+
+		constexpr Vec2 GetPosition() const
+		{
+			return m_Position;
+		}
+
 		// {width / 2, height / 2}
-		Vec2 GetCenter() const;
+		constexpr Vec2 GetCenter() const
+		{
+			return {m_Size.width * 0.5f, m_Size.height * 0.5f};
+		}
+
 		// {0, 0, width, height}
-		Rect GetRect() const;
+		constexpr Rect GetRect() const
+		{
+			return {0, 0, static_cast<int>(m_Size.width), static_cast<int>(m_Size.height)};
+		}
+
 		// {0, 0, width, height}
-		RectF GetFRect() const;
-		bool IsResizeable() const;
-		bool IsAlwaysOnTop() const;
-		bool IsMaximized() const;
-		bool IsMinimized() const;
-		bool IsBorderless() const;
-		FullScreenMode GetFullScreen() const;
+		constexpr RectF GetFRect() const
+		{
+			return {0.0f, 0.0f, static_cast<float>(m_Size.width), static_cast<float>(m_Size.height)};
+		}
+
+		constexpr bool IsResizeable() const
+		{
+			return m_Flags & SDL_WINDOW_RESIZABLE;
+		}
+
+		constexpr bool IsAlwaysOnTop() const
+		{
+			return m_Flags & SDL_WINDOW_ALWAYS_ON_TOP;
+		}
+
+		constexpr bool IsMaximized() const
+		{
+			return m_Flags & SDL_WINDOW_MAXIMIZED;
+		}
+
+		constexpr bool IsMinimized() const
+		{
+			return m_Flags & SDL_WINDOW_MINIMIZED;
+		}
+
+		constexpr bool IsBorderless() const
+		{
+			return m_Flags & SDL_WINDOW_BORDERLESS;
+		}
+
+		constexpr FullScreenMode GetFullScreen() const
+		{
+			if (m_Flags & SDL_WINDOW_FULLSCREEN)
+				return FullScreenMode::Real;
+			else if (m_Flags & SDL_WINDOW_FULLSCREEN_DESKTOP)
+				return FullScreenMode::Fake;
+			else
+				return FullScreenMode::Off;
+		}
+
+		// The Engine hands every window event for this window in here, to keep the cache fresh.
+		void OnWindowEvent(SDL_WindowEvent const& ev);
 
 	public:
+		// Maximize and Minimize may take a while; the cache catches up once their event arrives.
 		void SetSize(size_t newWidth, size_t newHeight);
 		void SetTitle(std::string_view newTitle);
 		void SetPosition(Vec2 const& newPos);
-		void SetResizeable(bool toWhat) const;
-		void SetAlwaysOnTop(bool toWhat) const;
-		void Maximize() const;
-		void Minimize() const;
-		void SetBorderless(bool toWhat) const;
+		void SetResizeable(bool toWhat);
+		void SetAlwaysOnTop(bool toWhat);
+		void Maximize();
+		void Minimize();
+		void SetBorderless(bool toWhat);
 		void SetFullScreen(FullScreenMode toWhat);
 
 		void ShowCursor(bool toggle);
 		void ShowMessageBox(MessageBoxFlag flag, std::string_view title, std::string_view message);
 
+	private:
+		// Asks SDL for everything that is cached; after creating the window and changing it.
+		void RefreshMetrics();
+		void RefreshFlags();
+
 	public:
 		SDL_Window* ptr{};
+
+	private:
+		WindowSize m_Size{};
+		Vec2 m_Position{};
+		Uint32 m_Flags{};
 	};
 }
\ No newline at end of file
@@ -20,6 +20,8 @@
 #include <numbers>
 #include <variant>
 #include <array>
+#include <span>
+#include <memory>
 #include <stack>
 #include <format>
 #include <exception>
@@ -31,6 +33,14 @@
 #include <random>
 #include <charconv>
 #include <iomanip>
+#include <bit>
+#include <limits>
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #ifndef NDEBUG
 #define AROBOT_DEBUG_MODE
@@ -0,0 +1,301 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "ArRobotException.hpp"
+#include "Command.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	/// Turns commands into instructions, resolving every label into the index it marks. All of
+	/// it is constexpr, so programs built into the game can be assembled at compile time:
+	///
+	///     static constexpr auto gc_Program {R"(
+	///         : Start
+	///         Move 1, 0
+	///         Check 1, 0, Wall
+	///         JumpFalse Start
+	///     )"_arobot};
+	///
+	/// The assembly has one command per line, spelled the same as in the language (see
+	/// Cmd::gc_MnemonicMap). A program that does not assemble simply does not compile, since
+	/// the error gets thrown during constant evaluation.
+	namespace Asm {
+		template <std::size_t N>
+		struct FixedString
+		{
+			char data[N]{};
+
+			consteval FixedString(char const (&str)[N])
+			{
+				std::ranges::copy(str, data);
+			}
+
+			constexpr std::string_view View() const
+			{
+				return {data, N - 1};
+			}
+		};
+
+		constexpr bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		constexpr bool IsIdentChar(char c)
+		{
+			return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_';
+		}
+
+		constexpr std::string_view Trim(std::string_view str)
+		{
+			while (!str.empty() && IsSpace(str.front())) str.remove_prefix(1);
+			while (!str.empty() && IsSpace(str.back()))  str.remove_suffix(1);
+			return str;
+		}
+
+		// Returns everything before the delimiter, and leaves everything after it in str.
+		constexpr std::string_view SplitAt(std::string_view& str, char delim)
+		{
+			auto const pos {str.find(delim)};
+			auto const res {str.substr(0, pos)};
+			str.remove_prefix(pos == std::string_view::npos ? str.size() : pos + 1);
+			return res;
+		}
+
+		constexpr std::string_view ExpectIdent(std::string_view str)
+		{
+			if (str.empty() || ('0' <= str.front() && str.front() <= '9') ||
+				!std::ranges::all_of(str, IsIdentChar))
+			{
+				throw ParseError{"Expected a name but found \"{}\"", str};
+			}
+			return str;
+		}
+
+		constexpr std::int32_t ParseInt(std::string_view str)
+		{
+			auto const bMinus {str.starts_with('-')};
+			auto digits {bMinus ? str.substr(1) : str};
+			if (digits.empty())
+			{
+				throw ParseError{"Expected a number but found \"{}\"", str};
+			}
+
+			std::int64_t res{};
+			for (auto const c : digits)
+			{
+				if (c < '0' || '9' < c)
+				{
+					throw ParseError{"Expected a number but found \"{}\"", str};
+				}
+
+				res = res * 10 + (c - '0');
+				if (res > std::numeric_limits<std::int32_t>::max() + 1I64)
+				{
+					throw ParseError{"Number {} cannot fit in 32 bits", str};
+				}
+			}
+
+			res *= bMinus ? -1 : 1;
+			if (res > std::numeric_limits<std::int32_t>::max())
+			{
+				throw ParseError{"Number {} cannot fit in 32 bits", str};
+			}
+			return static_cast<std::int32_t>(res);
+		}
+
+		constexpr std::size_t ParseAddress(std::string_view str)
+		{
+			auto const addr {ParseInt(str)};
+			if (addr < 0)
+			{
+				throw ParseError{"{} is not a valid memory address", str};
+			}
+			return static_cast<std::size_t>(addr);
+		}
+
+		// Either a number or a name like Wall (Block.Wall works too, to match the language).
+		constexpr BlockType ParseBlock(std::string_view str)
+		{
+			if (str.starts_with("Block."))
+			{
+				str.remove_prefix(sizeof "Block." - 1);
+			}
+
+			for (auto const block : {BlockType::Nothing, BlockType::Wall, BlockType::Pit, BlockType::Item, BlockType::Robot})
+			{
+				if (BlockTypeEnum::ToString(block) == str)
+				{
+					return block;
+				}
+			}
+
+			auto const num {ParseInt(str)};
+			if (num < 0 || num > static_cast<std::int32_t>(BlockType::Robot))
+			{
+				throw ParseError{"{} is not a valid block", str};
+			}
+			return static_cast<BlockType>(num);
+		}
+
+		constexpr std::vector<Command> ParseAssembly(std::string_view source)
+		{
+			using enum CommandType;
+			std::vector<Command> res{};
+			while (!source.empty())
+			{
+				auto line {Trim(SplitAt(source, '\n'))};
+				if (line.empty())
+				{
+					continue;
+				}
+
+				if (line.front() == ':')
+				{
+					res.push_back(Command::MakeMarkLabel(ExpectIdent(Trim(line.substr(1)))));
+					continue;
+				}
+
+				auto const nameSize {static_cast<std::size_t>(std::ranges::find_if_not(line, IsIdentChar) - line.begin())};
+				auto const name {ExpectIdent(line.substr(0, nameSize))};
+				line.remove_prefix(nameSize);
+				auto const* const pMnemonic {Cmd::FindMnemonic(name)};
+				if (!pMnemonic)
+				{
+					throw ParseError{"Unknown command {}", name};
+				}
+
+				std::array<std::string_view, 3> ops{};
+				std::size_t opCount{};
+				for (line = Trim(line); !line.empty(); ++opCount)
+				{
+					if (opCount == ops.size())
+					{
+						throw ParseError{"Too many arguments given to {}", name};
+					}
+					ops[opCount] = Trim(SplitAt(line, ','));
+				}
+
+				if (opCount != pMnemonic->argCount)
+				{
+					throw ParseError{"{} takes {} arguments but was given {}",
+						name, pMnemonic->argCount, opCount};
+				}
+
+				switch (pMnemonic->type)
+				{
+				case DoNothing:   res.push_back(Command::MakeDoNothing());   break;
+				case PickUp:      res.push_back(Command::MakePickUp());      break;
+				case Drop:        res.push_back(Command::MakeDrop());        break;
+				case Halt:        res.push_back(Command::MakeHalt());        break;
+				case MemPrintAll: res.push_back(Command::MakeMemPrintAll()); break;
+				case Move:      res.push_back(Command::MakeMove(ParseInt(ops[0]), ParseInt(ops[1]))); break;
+				case Jump:      res.push_back(Command::MakeJump(ExpectIdent(ops[0])));                 break;
+				case JumpTrue:  res.push_back(Command::MakeJumpTrue(ExpectIdent(ops[0])));             break;
+				case JumpFalse: res.push_back(Command::MakeJumpFalse(ExpectIdent(ops[0])));            break;
+				case MemSet:    res.push_back(Command::MakeMemSet(ParseAddress(ops[0]), ParseInt(ops[1]))); break;
+				case MemCopy:   res.push_back(Command::MakeMemCopy(ParseAddress(ops[0]), ParseAddress(ops[1]))); break;
+				case MemPrint:  res.push_back(Command::MakeMemPrint(ParseAddress(ops[0])));             break;
+				case CheckDir:
+					res.push_back(Command::MakeCheckDir(ParseInt(ops[0]), ParseInt(ops[1]), ParseBlock(ops[2])));
+					break;
+				case StepToward:
+					// Robots are never in the grid, so there is no field to follow to them.
+					if (auto const block {ParseBlock(ops[0])}; block != BlockType::Robot)
+					{
+						res.push_back(Command::MakeStepToward(block));
+						break;
+					}
+					throw ParseError{"There is no stepping toward {}", ops[0]};
+				case BinaryOp:
+				{
+					// Unary operators ignore their right hand side.
+					auto const lhs {ParseAddress(ops[0])};
+					auto const rhs {pMnemonic->argCount == 1 ? lhs : ParseAddress(ops[1])};
+					res.push_back(Command::MakeBinaryOp(pMnemonic->opCode, lhs, rhs));
+					break;
+				}
+				default:
+					AROBOT_UNREACHABLE_CODE();
+				}
+			}
+			return res;
+		}
+
+		/// Always ends the program with a Halt, so running off the end stops the robot, and
+		/// labels at the very end have something to point at.
+		constexpr std::vector<Instruction> Assemble(std::span<Command const> commands)
+		{
+			using enum CommandType;
+
+			// Labels take no room, so every label has to be found before the first jump.
+			using LabelEntry = std::pair<std::string_view, std::int32_t>;
+			std::vector<LabelEntry> labels{};
+			std::int32_t instCount{};
+			for (auto const& cmd : commands)
+			{
+				if (cmd.GetType() != MarkLabel)
+				{
+					++instCount;
+					continue;
+				}
+
+				std::string_view const label {cmd.As<MarkLabel>().label};
+				if (std::ranges::find(labels, label, &LabelEntry::first) != labels.end())
+				{
+					throw ParseError{"Label {} was marked twice", label};
+				}
+				labels.emplace_back(label, instCount);
+			}
+
+			std::vector<Instruction> res{};
+			res.reserve(static_cast<std::size_t>(instCount) + 1);
+			for (auto const& cmd : commands)
+			{
+				std::string_view label{};
+				switch (cmd.GetType())
+				{
+				case MarkLabel: continue;
+				case Jump:      label = cmd.As<Jump>().label;      break;
+				case JumpTrue:  label = cmd.As<JumpTrue>().label;  break;
+				case JumpFalse: label = cmd.As<JumpFalse>().label; break;
+				default:
+					res.push_back(Instruction::FromCommand(cmd));
+					continue;
+				}
+
+				auto const it {std::ranges::find(labels, label, &LabelEntry::first)};
+				if (it == labels.end())
+				{
+					throw ParseError{"Jumping to non-existant label: {}", label};
+				}
+				res.push_back(Instruction::FromCommand(cmd, it->second));
+			}
+
+			res.push_back(Instruction::FromCommand(Command::MakeHalt()));
+			return res;
+		}
+
+		constexpr std::vector<Instruction> Assemble(std::string_view source)
+		{
+			return Assemble(ParseAssembly(source));
+		}
+	}
+
+	/// Assembles the program during compilation; costs nothing at startup.
+	template <Asm::FixedString Source>
+	consteval auto Assemble()
+	{
+		constexpr auto size {Asm::Assemble(Source.View()).size()};
+		std::array<Instruction, size> res{};
+		std::ranges::copy(Asm::Assemble(Source.View()), res.begin());
+		return res;
+	}
+
+	namespace Literals {
+		template <Asm::FixedString Source>
+		consteval auto operator""_arobot()
+		{
+			return Assemble<Source>();
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#include "pch.hpp"
+#include "Ast.hpp"
+
+namespace ArRobot {
+	SyntaxTree::SyntaxTree(std::vector<Token> tokens) : m_Tokens{std::move(tokens)}
+	{
+	}
+
+	Ast::Proc const* SyntaxTree::FindProc(std::string_view name) const
+	{
+		auto const it {std::ranges::find(m_Procs, name, &Ast::Proc::name)};
+		return it != m_Procs.end() ? *it : nullptr;
+	}
+
+	Ast::Sticker const* SyntaxTree::FindSticker(std::string_view name) const
+	{
+		auto const it {std::ranges::find(m_Stickers, name, &Ast::Sticker::name)};
+		return it != m_Stickers.end() ? *it : nullptr;
+	}
+
+	Ast::Enum const* SyntaxTree::FindEnum(std::string_view name) const
+	{
+		auto const it {std::ranges::find(m_Enums, name, &Ast::Enum::name)};
+		return it != m_Enums.end() ? *it : nullptr;
+	}
+
+	std::string SyntaxTree::SpanToString(TokenSpan span) const
+	{
+		std::string res{};
+		for (auto const& tk : GetTokens(span))
+		{
+			using enum TokenType;
+			switch (tk.GetType())
+			{
+			case NewLine: continue;
+			case Number:  std::format_to(std::back_inserter(res), "{} ", tk.As<Number>().num);  break;
+			case Name:    std::format_to(std::back_inserter(res), "{} ", tk.As<Name>().glyph);  break;
+			case Keyword: std::format_to(std::back_inserter(res), "{} ", tk.As<Keyword>().type); break;
+			default:      std::format_to(std::back_inserter(res), "{} ", tk.ToString());        break;
+			}
+		}
+
+		if (!res.empty())
+		{
+			res.pop_back();
+		}
+		return res;
+	}
+}
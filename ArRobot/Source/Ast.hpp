@@ -0,0 +1,135 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Token.hpp"
+#include "Util/Arena.hpp"
+
+namespace ArRobot {
+	/// Half-open range of indices into the token stream a node was parsed from.
+	struct TokenSpan
+	{
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+
+	// All the nodes live inside the arena of the SyntaxTree that owns them; that is why
+	// everything in here is a view (names point into the glyphs of the tokens).
+	namespace Ast {
+		enum class ArgType : std::int32_t
+		{
+			Number,     // 123
+			Name,       // Start, or any other label or parameter.
+			EnumMember, // Block.Wall
+			Sticker,    // $WEST
+		};
+
+		struct Arg
+		{
+			ArgType type;
+			TokenSpan span;
+			std::int32_t num;
+			std::string_view name;
+			std::string_view member;
+		};
+
+		enum class StmtType : std::int32_t
+		{
+			Label,   // : Start
+			Command, // Move 1, 0
+			Invoke,  // DoIfNotWall! Move, 1, 0
+		};
+
+		struct Stmt
+		{
+			StmtType type;
+			TokenSpan span;
+			std::string_view name;
+			std::span<Arg const> args;
+		};
+
+		struct Param
+		{
+			TokenSpan span;
+			std::string_view type;
+			// cmd(int, int) has {int, int} here; int has nothing.
+			std::span<std::string_view const> typeArgs;
+			std::string_view name;
+		};
+
+		struct Proc
+		{
+			TokenSpan span;
+			std::string_view name;
+			std::span<Param const> params;
+			std::span<Stmt const> body;
+		};
+
+		struct Sticker
+		{
+			TokenSpan span;
+			std::string_view name;
+			std::span<std::int32_t const> values;
+		};
+
+		struct Enum
+		{
+			TokenSpan span;
+			std::string_view name;
+			std::span<std::string_view const> members;
+
+			constexpr std::optional<std::int32_t> IndexOf(std::string_view member) const
+			{
+				if (auto const it {std::ranges::find(members, member)}; it != members.end())
+				{
+					return static_cast<std::int32_t>(std::distance(members.begin(), it));
+				}
+				return std::nullopt;
+			}
+		};
+	}
+
+	class SyntaxTree
+	{
+	public:
+		explicit SyntaxTree(std::vector<Token> tokens);
+
+		SyntaxTree(SyntaxTree&&) noexcept            = default;
+		SyntaxTree& operator=(SyntaxTree&&) noexcept = default;
+
+		Ast::Proc const* FindProc(std::string_view name) const;
+		Ast::Sticker const* FindSticker(std::string_view name) const;
+		Ast::Enum const* FindEnum(std::string_view name) const;
+
+		[[nodiscard]]
+		constexpr std::span<Ast::Proc const* const> GetProcs() const
+		{
+			return m_Procs;
+		}
+
+		[[nodiscard]]
+		constexpr std::span<Token const> GetTokens() const
+		{
+			return m_Tokens;
+		}
+
+		[[nodiscard]]
+		constexpr std::span<Token const> GetTokens(TokenSpan span) const
+		{
+			return std::span{m_Tokens}.subspan(span.begin, span.end - span.begin);
+		}
+
+		// Renders the tokens back into (roughly) the code they were parsed from.
+		std::string SpanToString(TokenSpan span) const;
+
+	private:
+		friend class Parser;
+
+		// Moving the vector does not move the tokens themselves, so the views in the nodes
+		// survive the tree being moved around.
+		std::vector<Token> m_Tokens;
+		Arena m_Arena{};
+
+		std::vector<Ast::Proc const*> m_Procs{};
+		std::vector<Ast::Sticker const*> m_Stickers{};
+		std::vector<Ast::Enum const*> m_Enums{};
+	};
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "ArRobotCore.hpp"
 
+#include <Arge/Util/PackedArray2D.hpp>
+
 namespace ArRobot {
 	enum class BlockType
 	{
@@ -8,6 +10,8 @@ namespace ArRobot {
 		Wall,
 		Pit,
 		Item,
+		// Never in a grid, only Check sees these (see OccupancyIndex.hpp).
+		Robot,
 	};
 
 	namespace BlockTypeEnum {
@@ -20,6 +24,7 @@ namespace ArRobot {
 			case Wall:    return "Wall";
 			case Pit:     return "Pit";
 			case Item:    return "Item";
+			case Robot:   return "Robot";
 			}
 
 			return "Invalid BlockType";
@@ -27,6 +32,15 @@ namespace ArRobot {
 	}
 }
 
+namespace Arge {
+	// Robot does not fit, but it is never in a grid anyways.
+	template <>
+	struct PackedTraits<ArRobot::BlockType>
+	{
+		static constexpr size_t BitsPerCell{2};
+	};
+}
+
 namespace std {
 	template <>
 	struct formatter<ArRobot::BlockType> : formatter<string_view>
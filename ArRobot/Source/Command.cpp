@@ -12,6 +12,7 @@ namespace ArRobot {
 		case Move:      return std::format("[Move](x={}, y={})\n", As<Move>().x, As<Move>().y);
 		case PickUp:    return "[PickUp]()\n";
 		case Drop:      return "[Drop]()\n";
+		case StepToward: return std::format("[StepToward](block={})\n", As<StepToward>().block);
 		case MarkLabel: return std::format("[MarkLabel](name={})\n", As<MarkLabel>().label);
 		case Jump:      return std::format("[Jump](addr={})\n", As<Jump>().label);
 		case JumpTrue:  return std::format("[JumpTrue](addr={})\n", As<JumpTrue>().label);
@@ -33,6 +34,13 @@ namespace ArRobot {
 		case MemPrintAll:
 			// Their default behaviour is printing, no more info is needed.
 			return "";
+		case CheckJumpTrue:
+		case CheckJumpFalse:
+		case OpJumpTrue:
+		case OpJumpFalse:
+		case MemSetRun:
+			// Never made out of Commands.
+			break;
 		}
 		
 		// The default label will trigger the "not all path return a value" warning,
@@ -10,7 +10,10 @@ namespace ArRobot {
 	// The user (which is only me) will only get to make different types of 
 	// commands through the different factory functions inside the Command
 	// class, everything else is subject to change.
-	enum class CommandType : std::size_t
+	//
+	// Except for the values: world files store them (see WorldFile.hpp), so new commands go at
+	// the end, before the superinstructions, which never leave the robot.
+	enum class CommandType : std::int32_t
 	{
 		DoNothing = 0,
 
@@ -32,6 +35,19 @@ namespace ArRobot {
 		// Debug Commands
 		MemPrint,
 		MemPrintAll,
+
+		// Walks one step along the shortest way to the nearest block of some type (see
+		// Pathfinder.hpp).
+		StepToward,
+
+		// Superinstructions, only ever made by the Fuser (see Fuser.hpp). Each one also does the
+		// work of the instructions right after it, which stay where they are in case someone 
+		// jumps straight to them.
+		CheckJumpTrue,
+		CheckJumpFalse,
+		OpJumpTrue,
+		OpJumpFalse,
+		MemSetRun,
 	};
 
 	/// Impl block for the CommandType enum.
@@ -42,6 +58,7 @@ namespace ArRobot {
 		struct Data {};
 
 		template <> struct Data<Move>      { std::int32_t x; std::int32_t y; };
+		template <> struct Data<StepToward>{ BlockType block; };
 		template <> struct Data<CheckDir>  { std::int32_t x; std::int32_t y; BlockType block; };
 		template <> struct Data<MarkLabel> { std::string label; };
 		template <> struct Data<Jump>      { std::string label; };
@@ -54,7 +71,7 @@ namespace ArRobot {
 
 		using Variant = std::variant<
 			// Animated:
-			Data<DoNothing>, Data<Move>, Data<PickUp>, Data<Drop>, 
+			Data<DoNothing>, Data<Move>, Data<PickUp>, Data<Drop>, Data<StepToward>,
 			// Control flow:
 			Data<CheckDir>, Data<MarkLabel>, Data<Jump>, Data<JumpTrue>, Data<JumpFalse>, 
 			Data<Halt>, 
@@ -62,6 +79,98 @@ namespace ArRobot {
 			Data<MemSet>, Data<MemCopy>, Data<BinaryOp>,
 			Data<MemPrint>, Data<MemPrintAll>
 		>;
+
+		/// Robots get this many memory cells, unless their program asks for more (never fewer).
+		/// Cell 15 is the flag, written by Check and read by the conditional jumps.
+		static constexpr std::size_t gc_DefaultMemorySize{16};
+		static constexpr std::size_t gc_FlagAddress{15};
+
+		/// The last one programs may have in them, everything after is a superinstruction.
+		static constexpr CommandType gc_LastCommand{StepToward};
+		/// Superinstructions included.
+		static constexpr std::size_t gc_CommandTypeCount{static_cast<std::size_t>(MemSetRun) + 1};
+
+		constexpr std::string_view ToString(CommandType type)
+		{
+			switch (type)
+			{
+			case DoNothing:      return "DoNothing";
+			case Move:           return "Move";
+			case PickUp:         return "PickUp";
+			case Drop:           return "Drop";
+			case StepToward:     return "StepToward";
+			case CheckDir:       return "CheckDir";
+			case MarkLabel:      return "MarkLabel";
+			case Jump:           return "Jump";
+			case JumpTrue:       return "JumpTrue";
+			case JumpFalse:      return "JumpFalse";
+			case Halt:           return "Halt";
+			case MemSet:         return "MemSet";
+			case MemCopy:        return "MemCopy";
+			case BinaryOp:       return "BinaryOp";
+			case MemPrint:       return "MemPrint";
+			case MemPrintAll:    return "MemPrintAll";
+			case CheckJumpTrue:  return "CheckJumpTrue";
+			case CheckJumpFalse: return "CheckJumpFalse";
+			case OpJumpTrue:     return "OpJumpTrue";
+			case OpJumpFalse:    return "OpJumpFalse";
+			case MemSetRun:      return "MemSetRun";
+			}
+
+			return "Invalid CommandType";
+		}
+
+		/// How a command is spelled in ArRobot source code (see Program.txt). Every OpCode has
+		/// a mnemonic of its own, but they all turn into a BinaryOp.
+		struct Mnemonic
+		{
+			std::string_view name;
+			CommandType type;
+			std::size_t argCount;
+			OpCode opCode{};
+		};
+
+		static constexpr std::array gc_MnemonicMap {
+			Mnemonic{ "DoNothing",   DoNothing,   0 },
+			Mnemonic{ "Move",        Move,        2 },
+			Mnemonic{ "PickUp",      PickUp,      0 },
+			Mnemonic{ "Drop",        Drop,        0 },
+			Mnemonic{ "StepToward",  StepToward,  1 },
+			Mnemonic{ "Check",       CheckDir,    3 },
+			Mnemonic{ "Jump",        Jump,        1 },
+			Mnemonic{ "JumpTrue",    JumpTrue,    1 },
+			Mnemonic{ "JumpFalse",   JumpFalse,   1 },
+			Mnemonic{ "Halt",        Halt,        0 },
+			Mnemonic{ "MemSet",      MemSet,      2 },
+			Mnemonic{ "MemCopy",     MemCopy,     2 },
+			Mnemonic{ "MemPrint",    MemPrint,    1 },
+			Mnemonic{ "MemPrintAll", MemPrintAll, 0 },
+			Mnemonic{ "Add",         BinaryOp,    2, OpCode::Add       },
+			Mnemonic{ "Sub",         BinaryOp,    2, OpCode::Sub       },
+			Mnemonic{ "Mul",         BinaryOp,    2, OpCode::Mul       },
+			Mnemonic{ "Div",         BinaryOp,    2, OpCode::Div       },
+			Mnemonic{ "Equal",       BinaryOp,    2, OpCode::Equal     },
+			Mnemonic{ "NotEqual",    BinaryOp,    2, OpCode::NotEqual  },
+			Mnemonic{ "Greater",     BinaryOp,    2, OpCode::Greater   },
+			Mnemonic{ "GreaterEq",   BinaryOp,    2, OpCode::GreaterEq },
+			Mnemonic{ "Less",        BinaryOp,    2, OpCode::Less      },
+			Mnemonic{ "LessEq",      BinaryOp,    2, OpCode::LessEq    },
+			Mnemonic{ "And",         BinaryOp,    2, OpCode::And       },
+			Mnemonic{ "Or",          BinaryOp,    2, OpCode::Or        },
+			Mnemonic{ "Xor",         BinaryOp,    2, OpCode::Xor       },
+			Mnemonic{ "BitAnd",      BinaryOp,    2, OpCode::BitAnd    },
+			Mnemonic{ "BitOr",       BinaryOp,    2, OpCode::BitOr     },
+			Mnemonic{ "BitXor",      BinaryOp,    2, OpCode::BitXor    },
+			// Unary operators only have a single operand, which is also where the result goes.
+			Mnemonic{ "Not",         BinaryOp,    1, OpCode::Not       },
+			Mnemonic{ "BitNot",      BinaryOp,    1, OpCode::BitNot    },
+		};
+
+		constexpr Mnemonic const* FindMnemonic(std::string_view name)
+		{
+			auto const it {std::ranges::find(gc_MnemonicMap, name, &Mnemonic::name)};
+			return it != gc_MnemonicMap.end() ? &*it : nullptr;
+		}
 	}
 
 	class Command
@@ -108,6 +217,14 @@ namespace ArRobot {
 			return {Drop, Cmd::Data<Drop>{}, MediumPeriod};
 		}
 
+		// Sets the flag while there is still some way to go, clears it once there or if there is
+		// no way at all.
+		static constexpr Command MakeStepToward(BlockType target)
+		{
+			using enum CommandType;
+			return {StepToward, Cmd::Data<StepToward>{target}, LongPeriod};
+		}
+
 		static constexpr Command MakeCheckDir(std::int32_t x, std::int32_t y, BlockType whatToCheckFor)
 		{
 			using enum CommandType;
@@ -197,7 +314,7 @@ namespace ArRobot {
 		}
 
 		template <CommandType CmdType>
-		[[nodiscard]] auto const& As() const
+		[[nodiscard]] constexpr auto const& As() const
 		{
 			return std::get<Cmd::Data<CmdType>>(m_Data);
 		}
@@ -233,4 +350,13 @@ namespace std {
 			return formatter<std::string_view>{}.format(str, context);
 		}
 	};
+
+	template <>
+	struct formatter<ArRobot::CommandType> : formatter<std::string_view>
+	{
+		auto format(ArRobot::CommandType type, format_context context) const 
+		{
+			return formatter<std::string_view>{}.format(ArRobot::Cmd::ToString(type), context);
+		}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include "pch.hpp"
+#include "Compiler.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	std::vector<Command> Compiler::Compile(std::string_view code)
+	{
+		auto const tree {m_Parser.Parse(code)};
+		return Compile(tree);
+	}
+
+	std::vector<Command> Compiler::Compile(SyntaxTree const& tree)
+	{
+		auto const* const pMain {tree.FindProc(EntryProcName)};
+		if (!pMain)
+		{
+			throw ParseError{"The program has no entry point; add #proc {}", EntryProcName};
+		}
+
+		if (!pMain->params.empty())
+		{
+			throw ParseError{"#proc {} may not take any parameters", EntryProcName};
+		}
+
+		m_pTree = &tree;
+		m_Commands.clear();
+		m_Commands.reserve(pMain->body.size());
+		m_Bindings.clear();
+		m_Frames.assign(1, Frame{pMain, 0, 0});
+		m_ExpansionCount = 0;
+		for (auto const& stmt : pMain->body)
+		{
+			LowerStmt(stmt);
+		}
+
+		// Every pass may open up more work for the others.
+		while (m_bOptimize &&
+			(PropagateConstants() | RemoveUnreachable() | RemoveJumpsToNext() | RemoveDeadFlagWrites()));
+
+		m_pTree = nullptr;
+		return std::move(m_Commands);
+	}
+
+	void Compiler::LowerStmt(Ast::Stmt const& stmt)
+	{
+		// No using enum in here; StmtType::Command would hide the Command class.
+		if (stmt.type == Ast::StmtType::Label)
+		{
+			m_Commands.push_back(Command::MakeMarkLabel(LabelName(m_Frames.size() - 1, stmt.name)));
+			return;
+		}
+
+		// A cmd parameter stands in for whatever was passed to it.
+		auto const* const pBinding {FindBinding(stmt.name)};
+		auto const callee {pBinding ? pBinding->operand.cmd : stmt.name};
+		if (pBinding && callee.empty())
+		{
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{"{} is a number, not a command (in: {})", stmt.name, code};
+		}
+
+		if (stmt.type == Ast::StmtType::Command)
+		{
+			if (auto const* const pMnemonic {Cmd::FindMnemonic(callee)})
+			{
+				LowerCommand(stmt, *pMnemonic);
+				return;
+			}
+		}
+
+		auto const* const pProc {m_pTree->FindProc(callee)};
+		if (!pProc || (stmt.type == Ast::StmtType::Command && !pBinding))
+		{
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{pProc ? "Procs are invoked with a !, as in {}! (in: {})" :
+				"Unknown command {} (in: {})", callee, code};
+		}
+
+		Inline(stmt, *pProc);
+	}
+
+	void Compiler::LowerCommand(Ast::Stmt const& stmt, Cmd::Mnemonic const& mnemonic)
+	{
+		using enum CommandType;
+
+		// Jumps are the only commands taking a label rather than numbers.
+		if (mnemonic.type == Jump || mnemonic.type == JumpTrue || mnemonic.type == JumpFalse)
+		{
+			if (stmt.args.size() != 1 || stmt.args.front().type != Ast::ArgType::Name)
+			{
+				auto const code {m_pTree->SpanToString(stmt.span)};
+				throw ParseError{"{} takes the name of a single label (in: {})", stmt.name, code};
+			}
+
+			auto const label {ResolveLabel(stmt.args.front().name)};
+			m_Commands.push_back(
+				mnemonic.type == Jump     ? Command::MakeJump(label) :
+				mnemonic.type == JumpTrue ? Command::MakeJumpTrue(label) :
+				                            Command::MakeJumpFalse(label));
+			return;
+		}
+
+		m_Operands.clear();
+		for (auto const& arg : stmt.args)
+		{
+			LowerArg(arg);
+		}
+
+		if (m_Operands.size() != mnemonic.argCount)
+		{
+			auto const given {m_Operands.size()};
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{"{} takes {} arguments but was given {} (in: {})",
+				stmt.name, mnemonic.argCount, given, code};
+		}
+
+		if (auto const it {std::ranges::find_if(m_Operands, [](Operand const& op) { return !op.cmd.empty(); })};
+			it != m_Operands.end())
+		{
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{"{} is a command, not a number (in: {})", it->cmd, code};
+		}
+
+		switch (mnemonic.type)
+		{
+		case DoNothing:   m_Commands.push_back(Command::MakeDoNothing());   break;
+		case PickUp:      m_Commands.push_back(Command::MakePickUp());      break;
+		case Drop:        m_Commands.push_back(Command::MakeDrop());        break;
+		case Halt:        m_Commands.push_back(Command::MakeHalt());        break;
+		case MemPrintAll: m_Commands.push_back(Command::MakeMemPrintAll()); break;
+		case Move:
+			m_Commands.push_back(Command::MakeMove(m_Operands[0].num, m_Operands[1].num));
+			break;
+		case CheckDir:
+		{
+			auto const block {m_Operands[2].num};
+			if (block < 0 || block > static_cast<std::int32_t>(BlockType::Robot))
+			{
+				auto const code {m_pTree->SpanToString(stmt.span)};
+				throw ParseError{"{} is not a valid block (in: {})", block, code};
+			}
+			m_Commands.push_back(Command::MakeCheckDir(
+				m_Operands[0].num, m_Operands[1].num, static_cast<BlockType>(block)));
+			break;
+		}
+		case StepToward:
+		{
+			auto const block {m_Operands[0].num};
+			if (block < 0 || block >= static_cast<std::int32_t>(BlockType::Robot))
+			{
+				auto const code {m_pTree->SpanToString(stmt.span)};
+				throw ParseError{"{} is not a block that can be stepped toward (in: {})", block, code};
+			}
+			m_Commands.push_back(Command::MakeStepToward(static_cast<BlockType>(block)));
+			break;
+		}
+		case MemSet:
+			m_Commands.push_back(Command::MakeMemSet(OperandToAddress(stmt, 0), m_Operands[1].num));
+			break;
+		case MemCopy:
+			m_Commands.push_back(Command::MakeMemCopy(
+				OperandToAddress(stmt, 0), OperandToAddress(stmt, 1)));
+			break;
+		case MemPrint:
+			m_Commands.push_back(Command::MakeMemPrint(OperandToAddress(stmt, 0)));
+			break;
+		case BinaryOp:
+		{
+			// Unary operators ignore their right hand side.
+			auto const lhs {OperandToAddress(stmt, 0)};
+			auto const rhs {mnemonic.argCount == 1 ? lhs : OperandToAddress(stmt, 1)};
+			m_Commands.push_back(Command::MakeBinaryOp(mnemonic.opCode, lhs, rhs));
+			break;
+		}
+		default:
+			AROBOT_UNREACHABLE_CODE();
+		}
+	}
+
+	void Compiler::LowerArg(Ast::Arg const& arg)
+	{
+		using enum Ast::ArgType;
+		switch (arg.type)
+		{
+		case Number:
+			m_Operands.push_back({arg.num});
+			break;
+		case EnumMember:
+		{
+			auto const* const pEnum {m_pTree->FindEnum(arg.name)};
+			if (!pEnum)
+			{
+				throw ParseError{"Unknown enum {}", arg.name};
+			}
+
+			if (auto const index {pEnum->IndexOf(arg.member)})
+			{
+				m_Operands.push_back({*index});
+			}
+			else
+			{
+				throw ParseError{"Enum {} has no member called {}", arg.name, arg.member};
+			}
+			break;
+		}
+		case Sticker:
+			if (auto const* const pSticker {m_pTree->FindSticker(arg.name)})
+			{
+				for (auto const value : pSticker->values)
+				{
+					m_Operands.push_back({value});
+				}
+			}
+			else
+			{
+				throw ParseError{"Unknown sticker ${}", arg.name};
+			}
+			break;
+		case Name:
+			if (auto const* const pBinding {FindBinding(arg.name)})
+			{
+				m_Operands.push_back(pBinding->operand);
+			}
+			else if (Cmd::FindMnemonic(arg.name) || m_pTree->FindProc(arg.name))
+			{
+				m_Operands.push_back({0, arg.name});
+			}
+			else
+			{
+				throw ParseError{"Unknown name {}; only jumps take labels", arg.name};
+			}
+			break;
+		default:
+			AROBOT_UNREACHABLE_CODE();
+		}
+	}
+
+	void Compiler::Inline(Ast::Stmt const& stmt, Ast::Proc const& proc)
+	{
+		if (m_Frames.size() > MaxInlineDepth ||
+			std::ranges::find(m_Frames, &proc, &Frame::pProc) != m_Frames.end())
+		{
+			throw ParseError{"Proc {} ends up invoking itself, but procs are inlined, "
+				"so they may not recurse", proc.name};
+		}
+
+		m_Operands.clear();
+		for (auto const& arg : stmt.args)
+		{
+			LowerArg(arg);
+		}
+
+		if (m_Operands.size() != proc.params.size())
+		{
+			auto const given {m_Operands.size()};
+			auto const paramCount {proc.params.size()};
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{"{} takes {} arguments but was given {} (in: {})",
+				proc.name, paramCount, given, code};
+		}
+
+		// The bindings of the caller are still needed to evaluate the arguments, so the new
+		// frame only starts once all of them are bound.
+		auto const bindingsBegin {m_Bindings.size()};
+		for (std::size_t i{}; i < proc.params.size(); ++i)
+		{
+			auto const& param {proc.params[i]};
+			auto const& operand {m_Operands[i]};
+			if (param.type == "int")
+			{
+				if (!operand.cmd.empty())
+				{
+					throw ParseError{"{} is a command, but {} of {} is an int",
+						operand.cmd, param.name, proc.name};
+				}
+			}
+			else if (param.type == "cmd")
+			{
+				auto const* const pMnemonic {Cmd::FindMnemonic(operand.cmd)};
+				auto const* const pProc {pMnemonic ? nullptr : m_pTree->FindProc(operand.cmd)};
+				if (!pMnemonic && !pProc)
+				{
+					throw ParseError{"{} of {} is a cmd, but was given a number", param.name, proc.name};
+				}
+
+				auto const argCount {pMnemonic ? pMnemonic->argCount : pProc->params.size()};
+				if (auto const expected {param.typeArgs.size()}; argCount != expected)
+				{
+					throw ParseError{"{} of {} takes a cmd with {} arguments, but {} takes {}",
+						param.name, proc.name, expected, operand.cmd, argCount};
+				}
+			}
+			else
+			{
+				throw ParseError{"Unknown type {} (of {} in {})", param.type, param.name, proc.name};
+			}
+
+			m_Bindings.push_back({param.name, operand});
+		}
+
+		m_Frames.push_back({&proc, bindingsBegin, ++m_ExpansionCount});
+		for (auto const& bodyStmt : proc.body)
+		{
+			LowerStmt(bodyStmt);
+		}
+		m_Frames.pop_back();
+		m_Bindings.resize(bindingsBegin);
+	}
+
+	std::size_t Compiler::OperandToAddress(Ast::Stmt const& stmt, std::size_t index) const
+	{
+		auto const operand {m_Operands[index].num};
+		if (operand < 0)
+		{
+			auto const code {m_pTree->SpanToString(stmt.span)};
+			throw ParseError{"{} is not a valid memory address (in: {})", operand, code};
+		}
+		return static_cast<std::size_t>(operand);
+	}
+
+	Compiler::Binding const* Compiler::FindBinding(std::string_view param) const
+	{
+		// Parameters are only visible inside the body of their own proc.
+		auto const bindings {std::span{m_Bindings}.subspan(m_Frames.back().bindingsBegin)};
+		auto const it {std::ranges::find(bindings, param, &Binding::param)};
+		return it != bindings.end() ? &*it : nullptr;
+	}
+
+	std::string Compiler::LabelName(std::size_t frameIndex, std::string_view label) const
+	{
+		// Every expansion gets labels of its own, so invoking a proc twice does not mark the
+		// same label twice. Dots can not appear in names, so these never clash with the user's.
+		auto const& frame {m_Frames[frameIndex]};
+		return frameIndex == 0 ? std::string{label} :
+			std::format("{}.{}.{}", frame.pProc->name, frame.expansionId, label);
+	}
+
+	std::string Compiler::ResolveLabel(std::string_view label) const
+	{
+		auto const isThisLabel {[label](Ast::Stmt const& stmt) {
+			return stmt.type == Ast::StmtType::Label && stmt.name == label;
+		}};
+
+		// Jumping out of a proc into a label of whoever invoked it is allowed.
+		for (auto i {m_Frames.size()}; i-- > 0;)
+		{
+			if (std::ranges::any_of(m_Frames[i].pProc->body, isThisLabel))
+			{
+				return LabelName(i, label);
+			}
+		}
+
+		// Left for the assembler to complain about.
+		return std::string{label};
+	}
+
+	bool Compiler::PropagateConstants()
+	{
+		using enum CommandType;
+		auto constexpr Flag {Cmd::gc_FlagAddress};
+
+		bool bChanged{};
+		// Cells past the default ones are simply never known.
+		std::array<std::optional<std::int32_t>, Cmd::gc_DefaultMemorySize> known{};
+		auto const knownAt {[&known](std::size_t addr) {
+			return addr < known.size() ? known[addr] : std::nullopt;
+		}};
+		auto const forget {[&known](std::size_t addr) {
+			if (addr < known.size()) known[addr] = std::nullopt;
+		}};
+
+		std::vector<Command> res{};
+		res.reserve(m_Commands.size());
+		for (auto& cmd : m_Commands)
+		{
+			switch (cmd.GetType())
+			{
+			case MarkLabel:
+				// Control flow may join here, so nothing is known anymore.
+				known.fill(std::nullopt);
+				break;
+			case CheckDir:
+			case StepToward:
+				// Depends on the grid, which is only known while the robot runs.
+				forget(Flag);
+				break;
+			case MemSet:
+				if (auto const& [addr, value] {cmd.As<MemSet>()}; addr < known.size())
+				{
+					known[addr] = value;
+				}
+				break;
+			case MemCopy:
+				if (auto const& [to, from] {cmd.As<MemCopy>()}; to < known.size())
+				{
+					known[to] = knownAt(from);
+				}
+				break;
+			case BinaryOp:
+			{
+				auto const [opCode, lhs, rhs] {cmd.As<BinaryOp>()};
+				auto const lhsValue {knownAt(lhs)};
+				auto const rhsValue {knownAt(rhs)};
+				// Dividing by zero is left for the robot to crash on.
+				if (lhsValue && rhsValue && !(opCode == OpCode::Div && *rhsValue == 0))
+				{
+					auto const value {OpCodeEnum::Eval(opCode, *lhsValue, *rhsValue)};
+					cmd = Command::MakeMemSet(lhs, value);
+					known[lhs] = value;
+					bChanged = true;
+				}
+				else
+				{
+					forget(lhs);
+				}
+				break;
+			}
+			case JumpTrue:
+			case JumpFalse:
+				if (auto const flag {knownAt(Flag)})
+				{
+					bChanged = true;
+					if ((*flag != 0) != (cmd.GetType() == JumpTrue))
+					{
+						continue; // Never taken.
+					}
+
+					cmd = Command::MakeJump(cmd.GetType() == JumpTrue ?
+						cmd.As<JumpTrue>().label : cmd.As<JumpFalse>().label);
+				}
+				break;
+			default:
+				break;
+			}
+
+			res.push_back(std::move(cmd));
+		}
+
+		m_Commands = std::move(res);
+		return bChanged;
+	}
+
+	bool Compiler::RemoveUnreachable()
+	{
+		using enum CommandType;
+		auto const oldSize {m_Commands.size()};
+
+		// Nothing gets past a Jump or a Halt, until some other jump lands on a label.
+		bool bReachable{true};
+		std::erase_if(m_Commands, [&bReachable](Command const& cmd) {
+			auto const type {cmd.GetType()};
+			bReachable = bReachable || type == MarkLabel;
+			auto const bRemove {!bReachable};
+			bReachable = bReachable && type != Jump && type != Halt;
+			return bRemove;
+		});
+
+		return m_Commands.size() != oldSize;
+	}
+
+	bool Compiler::RemoveJumpsToNext()
+	{
+		using enum CommandType;
+		auto const oldSize {m_Commands.size()};
+
+		std::vector<Command> res{};
+		res.reserve(m_Commands.size());
+		for (std::size_t i{}; i < m_Commands.size(); ++i)
+		{
+			std::string_view label{};
+			switch (auto const& cmd {m_Commands[i]}; cmd.GetType())
+			{
+			case Jump:      label = cmd.As<Jump>().label;      break;
+			case JumpTrue:  label = cmd.As<JumpTrue>().label;  break;
+			case JumpFalse: label = cmd.As<JumpFalse>().label; break;
+			default: break;
+			}
+
+			// Lands where it would have gone anyways.
+			auto bToNext {false};
+			for (auto j {i + 1}; !label.empty() && j < m_Commands.size() &&
+				m_Commands[j].GetType() == MarkLabel; ++j)
+			{
+				bToNext = bToNext || m_Commands[j].As<MarkLabel>().label == label;
+			}
+
+			if (!bToNext)
+			{
+				res.push_back(std::move(m_Commands[i]));
+			}
+		}
+
+		m_Commands = std::move(res);
+		return m_Commands.size() != oldSize;
+	}
+
+	bool Compiler::RemoveDeadFlagWrites()
+	{
+		using enum CommandType;
+		auto const size {m_Commands.size()};
+
+		std::unordered_map<std::string_view, std::size_t> labels{};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			if (m_Commands[i].GetType() == MarkLabel)
+			{
+				labels.try_emplace(m_Commands[i].As<MarkLabel>().label, i);
+			}
+		}
+
+		// Backwards liveness of the flag; liveIn[size] is running off the end into a Halt.
+		std::vector<bool> liveIn(size + 1);
+		auto const liveAtLabel {[&labels, &liveIn](std::string_view label) -> bool {
+			auto const it {labels.find(label)};
+			return it == labels.end() || liveIn[it->second];
+		}};
+
+		for (bool bChanged {true}; bChanged;)
+		{
+			bChanged = false;
+			for (auto i {size}; i-- > 0;)
+			{
+				auto const& cmd {m_Commands[i]};
+				bool bLiveOut{};
+				switch (cmd.GetType())
+				{
+				case Halt: bLiveOut = false; break;
+				case Jump: bLiveOut = liveAtLabel(cmd.As<Jump>().label); break;
+				default:   bLiveOut = liveIn[i + 1]; break;
+				}
+				auto const inst {Instruction::FromCommand(cmd)};
+				auto const bLive {inst.ReadsFlag() || (!inst.WritesFlag() && bLiveOut)};
+
+				if (bLive != liveIn[i])
+				{
+					liveIn[i] = bLive;
+					bChanged = true;
+				}
+			}
+		}
+
+		// Nobody reads what these write before it gets overwritten.
+		auto const oldSize {m_Commands.size()};
+		std::vector<Command> res{};
+		res.reserve(size);
+		for (std::size_t i{}; i < size; ++i)
+		{
+			if (!Instruction::FromCommand(m_Commands[i]).OnlyWritesFlag() || liveIn[i + 1])
+			{
+				res.push_back(std::move(m_Commands[i]));
+			}
+		}
+
+		m_Commands = std::move(res);
+		return m_Commands.size() != oldSize;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Ast.hpp"
+#include "Command.hpp"
+#include "Parser.hpp"
+
+namespace ArRobot {
+	/// Lowers a SyntaxTree into the commands a Robot runs. Execution starts at the proc
+	/// called main.
+	///
+	/// Procs are macros; every invocation (Name! args) pastes the body of the proc in place,
+	/// with the arguments substituted for the parameters. Afterwards, the constants that were
+	/// passed in are propagated through the program, and whatever they made dead is removed.
+	class Compiler
+	{
+	public:
+		static constexpr std::string_view EntryProcName{"main"};
+		// Procs are inlined, so a deep chain of them is most likely a proc invoking itself.
+		static constexpr std::size_t MaxInlineDepth{64};
+
+		Compiler() = default;
+
+		std::vector<Command> Compile(std::string_view code);
+		std::vector<Command> Compile(SyntaxTree const& tree);
+
+		constexpr bool IsOptimizing() const      { return m_bOptimize; }
+		constexpr void SetOptimizing(bool value) { m_bOptimize = value; }
+
+	private:
+		// An argument after substitution; either a number, or the name of a command or a proc
+		// (for cmd parameters).
+		struct Operand
+		{
+			std::int32_t num;
+			std::string_view cmd;
+		};
+
+		struct Binding
+		{
+			std::string_view param;
+			Operand operand;
+		};
+
+		struct Frame
+		{
+			Ast::Proc const* pProc;
+			std::size_t bindingsBegin;
+			std::size_t expansionId;
+		};
+
+		void LowerStmt(Ast::Stmt const& stmt);
+		void LowerCommand(Ast::Stmt const& stmt, Cmd::Mnemonic const& mnemonic);
+		void LowerArg(Ast::Arg const& arg);
+		void Inline(Ast::Stmt const& stmt, Ast::Proc const& proc);
+		std::size_t OperandToAddress(Ast::Stmt const& stmt, std::size_t index) const;
+		Binding const* FindBinding(std::string_view param) const;
+		std::string LabelName(std::size_t frameIndex, std::string_view label) const;
+		std::string ResolveLabel(std::string_view label) const;
+
+		// Each one returns whether it changed anything.
+		bool PropagateConstants();
+		bool RemoveUnreachable();
+		bool RemoveJumpsToNext();
+		bool RemoveDeadFlagWrites();
+
+	private:
+		Parser m_Parser{};
+		SyntaxTree const* m_pTree{};
+		std::vector<Command> m_Commands{};
+		// Stickers expand into several operands, so arguments are flattened in here first.
+		std::vector<Operand> m_Operands{};
+		std::vector<Binding> m_Bindings{};
+		std::vector<Frame> m_Frames{};
+		std::size_t m_ExpansionCount{};
+		bool m_bOptimize{true};
+	};
+}
@@ -0,0 +1,258 @@
+#include "pch.hpp"
+#include "ControlFlowGraph.hpp"
+
+namespace ArRobot {
+	ControlFlowGraph::ControlFlowGraph(std::span<Instruction const> program)
+	{
+		Validate(program);
+		SplitBlocks(program);
+		LinkBlocks(program);
+		MarkReachable();
+	}
+
+	std::size_t ControlFlowGraph::BlockOf(std::size_t instIndex) const
+	{
+		AROBOT_DA(instIndex < m_Blocks.back().end, "Instruction {} is outside of the program", instIndex);
+		auto const it {std::ranges::upper_bound(m_Blocks, instIndex, {}, &Block::begin)};
+		return static_cast<std::size_t>(it - m_Blocks.begin()) - 1;
+	}
+
+	bool ControlFlowGraph::IsReachable(std::size_t instIndex) const
+	{
+		return m_Blocks[BlockOf(instIndex)].bReachable;
+	}
+
+	std::vector<std::size_t> ControlFlowGraph::FindUnreachable() const
+	{
+		std::vector<std::size_t> res{};
+		for (auto const& block : m_Blocks)
+		{
+			if (!block.bReachable)
+			{
+				for (auto i {block.begin}; i < block.end; ++i)
+				{
+					res.push_back(i);
+				}
+			}
+		}
+		return res;
+	}
+
+	std::vector<std::vector<std::size_t>> ControlFlowGraph::FindTightLoops() const
+	{
+		std::vector<std::vector<std::size_t>> res{};
+		for (auto& component : FindStronglyConnected())
+		{
+			auto const first {component.front()};
+			auto const isInside {[&component](std::size_t block) {
+				return std::ranges::find(component, block) != component.end();
+			}};
+
+			// A single block is only a loop if it jumps to itself.
+			auto const bLoops {
+				component.size() > 1 || std::ranges::any_of(m_Blocks[first].successors, isInside)
+			};
+			if (!m_Blocks[first].bReachable || !bLoops)
+			{
+				continue;
+			}
+
+			// Either way out of the loop means the robot is not stuck, even if the way out
+			// depends on the flag.
+			auto const bTight {std::ranges::all_of(component, [&](std::size_t block) {
+				return !m_IsAnimated[block] && std::ranges::all_of(m_Blocks[block].successors, isInside);
+			})};
+
+			if (bTight)
+			{
+				std::ranges::sort(component);
+				res.push_back(std::move(component));
+			}
+		}
+		return res;
+	}
+
+	void ControlFlowGraph::Validate(std::span<Instruction const> program) const
+	{
+		if (program.empty())
+		{
+			throw ParseError{"Empty program; it should at least halt"};
+		}
+
+		auto const size {program.size()};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			auto const& inst {program[i]};
+			if (inst.type == CommandType::MarkLabel ||
+				inst.type < CommandType::DoNothing || Cmd::gc_LastCommand < inst.type)
+			{
+				throw ParseError{"Instruction {} cannot be executed: {}", i, inst};
+			}
+
+			// Robots are never in the grid, so there is no way to step toward them.
+			if (inst.type == CommandType::StepToward &&
+				(inst.a < 0 || inst.a >= static_cast<std::int32_t>(BlockType::Robot)))
+			{
+				throw ParseError{"Instruction {} steps toward something that is not a block: {}", i, inst};
+			}
+
+			if (inst.IsJump() && (inst.a < 0 || static_cast<std::size_t>(inst.a) >= size))
+			{
+				throw ParseError{"Instruction {} jumps to {}, but the program only has {} instructions",
+					i, inst.a, size};
+			}
+		}
+
+		if (auto const last {program.back().type}; last != CommandType::Halt && last != CommandType::Jump)
+		{
+			throw ParseError{"The program runs off its end; it should end with a Halt or a Jump"};
+		}
+	}
+
+	void ControlFlowGraph::SplitBlocks(std::span<Instruction const> program)
+	{
+		// A block starts wherever someone jumps to, and after anything that does not
+		// simply fall through.
+		std::vector<bool> isLeader(program.size());
+		isLeader.front() = true;
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			auto const& inst {program[i]};
+			if (inst.IsJump())
+			{
+				isLeader[static_cast<std::size_t>(inst.a)] = true;
+			}
+
+			if ((inst.IsJump() || inst.type == CommandType::Halt) && i + 1 < program.size())
+			{
+				isLeader[i + 1] = true;
+			}
+		}
+
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			if (isLeader[i])
+			{
+				if (!m_Blocks.empty())
+				{
+					m_Blocks.back().end = i;
+				}
+				m_Blocks.push_back({i, program.size()});
+				m_IsAnimated.push_back(false);
+			}
+
+			using enum CommandType;
+			auto const type {program[i].type};
+			if (type == Move || type == PickUp || type == Drop || type == StepToward)
+			{
+				m_IsAnimated.back() = true;
+			}
+		}
+	}
+
+	void ControlFlowGraph::LinkBlocks(std::span<Instruction const> program)
+	{
+		for (std::size_t i{}; i < m_Blocks.size(); ++i)
+		{
+			auto& block {m_Blocks[i]};
+			auto const& last {program[block.end - 1]};
+
+			using enum CommandType;
+			if (last.IsJump())
+			{
+				block.successors.push_back(BlockOf(static_cast<std::size_t>(last.a)));
+			}
+
+			// Validation made sure the last block never falls through.
+			if (last.type != Halt && last.type != Jump)
+			{
+				block.successors.push_back(i + 1);
+			}
+		}
+	}
+
+	void ControlFlowGraph::MarkReachable()
+	{
+		std::vector<std::size_t> toVisit{0};
+		while (!toVisit.empty())
+		{
+			auto& block {m_Blocks[toVisit.back()]};
+			toVisit.pop_back();
+			if (!block.bReachable)
+			{
+				block.bReachable = true;
+				toVisit.insert(toVisit.end(), block.successors.begin(), block.successors.end());
+			}
+		}
+	}
+
+	std::vector<std::vector<std::size_t>> ControlFlowGraph::FindStronglyConnected() const
+	{
+		// Tarjan's, with a stack of its own so long programs can't blow the real one.
+		auto constexpr Unvisited {std::numeric_limits<std::size_t>::max()};
+		auto const count {m_Blocks.size()};
+		std::vector<std::size_t> indices(count, Unvisited);
+		std::vector<std::size_t> lowLinks(count);
+		std::vector<bool> isOnStack(count);
+		std::vector<std::size_t> stack{};
+		// The block being visited, and which of its successors is next.
+		std::vector<std::pair<std::size_t, std::size_t>> visiting{};
+		std::size_t nextIndex{};
+
+		auto const visit {[&](std::size_t block) {
+			indices[block] = lowLinks[block] = nextIndex++;
+			stack.push_back(block);
+			isOnStack[block] = true;
+			visiting.push_back({block, 0});
+		}};
+
+		std::vector<std::vector<std::size_t>> res{};
+		for (std::size_t root{}; root < count; ++root)
+		{
+			if (indices[root] != Unvisited)
+			{
+				continue;
+			}
+
+			visit(root);
+			while (!visiting.empty())
+			{
+				auto const [block, succ] {visiting.back()};
+				if (auto const& successors {m_Blocks[block].successors}; succ < successors.size())
+				{
+					++visiting.back().second;
+					if (auto const next {successors[succ]}; indices[next] == Unvisited)
+					{
+						visit(next);
+					}
+					else if (isOnStack[next])
+					{
+						lowLinks[block] = std::min(lowLinks[block], indices[next]);
+					}
+					continue;
+				}
+
+				visiting.pop_back();
+				if (!visiting.empty())
+				{
+					auto const parent {visiting.back().first};
+					lowLinks[parent] = std::min(lowLinks[parent], lowLinks[block]);
+				}
+
+				if (lowLinks[block] == indices[block])
+				{
+					auto& component {res.emplace_back()};
+					std::size_t member{};
+					do
+					{
+						member = stack.back();
+						stack.pop_back();
+						isOnStack[member] = false;
+						component.push_back(member);
+					} while (member != block);
+				}
+			}
+		}
+		return res;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+#include "ArRobotException.hpp"
+
+namespace ArRobot {
+	/// The basic blocks of an assembled program, and which ones may run after which.
+	///
+	/// Building one validates the program: every jump has to land inside of it, nothing may be
+	/// unexecutable (like a leftover MarkLabel), and the last instruction has to be a Halt or a
+	/// Jump, so the robot can never run off the end. Anything else throws a ParseError. Once
+	/// a program made it through here, a robot can run it without checking anything.
+	class ControlFlowGraph
+	{
+	public:
+		struct Block
+		{
+			/// Instructions [begin, end) of the program.
+			std::size_t begin;
+			std::size_t end;
+			/// Indices of the blocks that may run right after this one.
+			std::vector<std::size_t> successors;
+			bool bReachable;
+		};
+
+	public:
+		explicit ControlFlowGraph(std::span<Instruction const> program);
+
+		[[nodiscard]]
+		constexpr std::span<Block const> GetBlocks() const
+		{
+			return m_Blocks;
+		}
+
+		/// The block that contains the instruction at the given index.
+		[[nodiscard]]
+		std::size_t BlockOf(std::size_t instIndex) const;
+
+		[[nodiscard]]
+		bool IsReachable(std::size_t instIndex) const;
+
+		/// Indices of the instructions the robot can never get to.
+		[[nodiscard]]
+		std::vector<std::size_t> FindUnreachable() const;
+
+		/// Groups of blocks the robot can enter but never leave, without ever doing anything
+		/// visible (moving, picking up or dropping) in there. The robot hangs in place forever.
+		[[nodiscard]]
+		std::vector<std::vector<std::size_t>> FindTightLoops() const;
+
+	private:
+		void Validate(std::span<Instruction const> program) const;
+		void SplitBlocks(std::span<Instruction const> program);
+		void LinkBlocks(std::span<Instruction const> program);
+		void MarkReachable();
+		std::vector<std::vector<std::size_t>> FindStronglyConnected() const;
+
+	private:
+		std::vector<Block> m_Blocks{};
+		/// Whether each block has a Move, PickUp, Drop or StepToward in it.
+		std::vector<bool> m_IsAnimated{};
+	};
+}
@@ -0,0 +1,24 @@
+#include "pch.hpp"
+#include "Fault.hpp"
+#include "Command.hpp"
+
+namespace ArRobot {
+	std::string Fault::FormatMessage() const
+	{
+		auto const [lhs, rhs] {operands};
+		auto const type {static_cast<CommandType>(lhs)};
+		using enum FaultCode;
+		switch (code)
+		{
+		case None:               return "No fault";
+		case AlreadyHolding:     return std::format("Already holding something (at instruction {})", instIndex);
+		case DroppingNothing:    return std::format("Dropping nothing (at instruction {})", instIndex);
+		case OutOfGridX:         return std::format("Moved out of the grid! (x is {} but width is {})", lhs, rhs);
+		case OutOfGridY:         return std::format("Moved out of the grid! (y is {} but height is {})", lhs, rhs);
+		case InvalidInstruction: return std::format("Executing invalid Instruction {} (at instruction {})", type, instIndex);
+		case BumpedIntoRobot:    return std::format("Bumped into robot {} (at instruction {})", lhs, instIndex);
+		}
+
+		return "Invalid fault";
+	}
+}
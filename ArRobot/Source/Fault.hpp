@@ -0,0 +1,70 @@
+#pragma once
+#include "ArRobotCore.hpp"
+
+namespace ArRobot {
+	/// Why a robot stopped running. Robots report these instead of throwing, since a field full
+	/// of robots that fault every tick should not spend its time unwinding.
+	enum class FaultCode : std::uint8_t
+	{
+		None = 0,
+		AlreadyHolding,
+		DroppingNothing,
+		OutOfGridX,
+		OutOfGridY,
+		InvalidInstruction,
+		BumpedIntoRobot,
+	};
+
+	namespace FaultCodeEnum {
+		constexpr std::string_view ToString(FaultCode code)
+		{
+			using enum FaultCode;
+			switch (code)
+			{
+			case None:               return "None";
+			case AlreadyHolding:     return "AlreadyHolding";
+			case DroppingNothing:    return "DroppingNothing";
+			case OutOfGridX:         return "OutOfGridX";
+			case OutOfGridY:         return "OutOfGridY";
+			case InvalidInstruction: return "InvalidInstruction";
+			case BumpedIntoRobot:    return "BumpedIntoRobot";
+			}
+
+			return "Invalid FaultCode";
+		}
+	}
+
+	/// Everything needed to tell what went wrong, without formatting anything until someone
+	/// actually asks.
+	struct Fault
+	{
+		FaultCode code{};
+		/// The instruction that faulted.
+		std::size_t instIndex{};
+		/// Depends on the code:
+		///   OutOfGridX, OutOfGridY  where the robot would have ended up, and the grid's size
+		///   InvalidInstruction      the type of the instruction
+		///   BumpedIntoRobot         the id of the robot that was in the way
+		std::array<std::int64_t, 2> operands{};
+
+		[[nodiscard]]
+		constexpr bool IsFaulted() const
+		{
+			return code != FaultCode::None;
+		}
+
+		[[nodiscard]]
+		std::string FormatMessage() const;
+	};
+}
+
+namespace std {
+	template <>
+	struct formatter<ArRobot::FaultCode> : formatter<string_view>
+	{
+		auto format(ArRobot::FaultCode code, std::format_context context) const
+		{
+			return formatter<string_view>{}.format(ArRobot::FaultCodeEnum::ToString(code), context);
+		}
+	};
+}
@@ -0,0 +1,114 @@
+#include "pch.hpp"
+#include "Fuser.hpp"
+
+namespace ArRobot {
+	Fuser::Fuser()
+	{
+		m_Enabled.fill(true);
+	}
+
+	Fuser Fuser::FromProfile(std::span<Instruction const> program,
+		std::span<std::uint64_t const> executionCounts, double minShare)
+	{
+		AROBOT_DA(program.size() == executionCounts.size(), "Profiled a different program");
+
+		// Every time the first instruction of a run executed, the whole run did.
+		std::array<std::uint64_t, gc_SuperCount> weights{};
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			if (auto const super {FuseAt(program, i)})
+			{
+				weights[IndexOf(super->type)] += executionCounts[i];
+			}
+		}
+
+		auto const total {std::accumulate(executionCounts.begin(), executionCounts.end(), std::uint64_t{})};
+		Fuser res{};
+		for (std::size_t i{}; i < gc_SuperCount; ++i)
+		{
+			res.m_Enabled[i] = weights[i] > 0 && static_cast<double>(weights[i]) >= minShare * total;
+		}
+		return res;
+	}
+
+	std::vector<Instruction> Fuser::Fuse(std::span<Instruction const> program) const
+	{
+		// Every instruction is fused with the original ones after it, so runs may overlap;
+		// jumping into the middle of a MemSetRun lands on a shorter one.
+		std::vector<Instruction> res(program.begin(), program.end());
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			if (auto const super {FuseAt(program, i)}; super && m_Enabled[IndexOf(super->type)])
+			{
+				res[i] = *super;
+			}
+		}
+		return res;
+	}
+
+	bool Fuser::IsEnabled(CommandType superType) const
+	{
+		return m_Enabled[IndexOf(superType)];
+	}
+
+	void Fuser::SetEnabled(CommandType superType, bool value)
+	{
+		m_Enabled[IndexOf(superType)] = value;
+	}
+
+	std::optional<Instruction> Fuser::FuseAt(std::span<Instruction const> program, std::size_t index)
+	{
+		using enum CommandType;
+		if (index + 1 >= program.size())
+		{
+			return std::nullopt;
+		}
+
+		auto res {program[index]};
+		auto const& next {program[index + 1]};
+		switch (res.type)
+		{
+		case CheckDir:
+			if (next.type != JumpTrue && next.type != JumpFalse)
+			{
+				return std::nullopt;
+			}
+			res.type = next.type == JumpTrue ? CheckJumpTrue : CheckJumpFalse;
+			res.ticks += next.ticks;
+			return res;
+		case BinaryOp:
+			if (next.type != JumpTrue && next.type != JumpFalse)
+			{
+				return std::nullopt;
+			}
+			res.type = next.type == JumpTrue ? OpJumpTrue : OpJumpFalse;
+			res.ticks += next.ticks;
+			return res;
+		case MemSet:
+		{
+			auto end {index + 1};
+			while (end < program.size() && program[end].type == MemSet)
+			{
+				res.ticks += program[end++].ticks;
+			}
+
+			if (end - index < 2)
+			{
+				return std::nullopt;
+			}
+			res.type = MemSetRun;
+			res.c = static_cast<std::int32_t>(end - index);
+			return res;
+		}
+		default:
+			return std::nullopt;
+		}
+	}
+
+	std::size_t Fuser::IndexOf(CommandType superType)
+	{
+		auto const index {static_cast<std::int32_t>(superType) - static_cast<std::int32_t>(CommandType::CheckJumpTrue)};
+		AROBOT_DA(0 <= index && index < static_cast<std::int32_t>(gc_SuperCount), "Not a superinstruction");
+		return static_cast<std::size_t>(index);
+	}
+}
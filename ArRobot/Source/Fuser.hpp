@@ -0,0 +1,45 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	/// Turns common runs of instructions into superinstructions, so the robot dispatches once
+	/// instead of two or three times:
+	///   CheckDir + JumpTrue/JumpFalse  ->  CheckJumpTrue/CheckJumpFalse
+	///   BinaryOp + JumpTrue/JumpFalse  ->  OpJumpTrue/OpJumpFalse
+	///   MemSet + MemSet (+ ...)        ->  MemSetRun
+	///
+	/// A superinstruction only replaces the first instruction of its run, the others stay 
+	/// where they are, so nothing moves and jumping into the middle of a run still works. It
+	/// takes as many ticks as the whole run did, so a robot with cooldowns on can not tell the 
+	/// difference (one that runs an instruction per tick gets through the run in one go). The
+	/// Profiler and the trace still see every instruction of the run, where it was.
+	class Fuser
+	{
+	public:
+		/// Makes every superinstruction it knows of.
+		Fuser();
+
+		/// Profile guided: only makes the superinstructions whose runs took up at least minShare 
+		/// of everything the robot executed. executionCounts holds how many times each 
+		/// instruction of the program ran (see Profiler::GetExecutionCounts).
+		static Fuser FromProfile(std::span<Instruction const> program, 
+			std::span<std::uint64_t const> executionCounts, double minShare = 0.05);
+
+		[[nodiscard]]
+		std::vector<Instruction> Fuse(std::span<Instruction const> program) const;
+
+		[[nodiscard]]
+		bool IsEnabled(CommandType superType) const;
+		void SetEnabled(CommandType superType, bool value);
+
+	private:
+		/// The superinstruction the run starting at index would become, if there is one.
+		static std::optional<Instruction> FuseAt(std::span<Instruction const> program, std::size_t index);
+		static std::size_t IndexOf(CommandType superType);
+
+	private:
+		static constexpr std::size_t gc_SuperCount{5};
+		std::array<bool, gc_SuperCount> m_Enabled{};
+	};
+}
@@ -0,0 +1,42 @@
+#include "pch.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	std::string Instruction::ToString() const
+	{
+		using enum CommandType;
+		switch (type)
+		{
+		case DoNothing: return "DoNothing\n";
+		case Move:      return std::format("[Move](x={}, y={})\n", a, b);
+		case PickUp:    return "[PickUp]()\n";
+		case Drop:      return "[Drop]()\n";
+		case StepToward: return std::format("[StepToward](block={})\n", static_cast<BlockType>(a));
+		case CheckDir:  return std::format("[CheckDir](x={}, y={}, block={})\n", a, b, static_cast<BlockType>(c));
+		case Jump:      return std::format("[Jump](addr={})\n", a);
+		case JumpTrue:  return std::format("[JumpTrue](addr={})\n", a);
+		case JumpFalse: return std::format("[JumpFalse](addr={})\n", a);
+		case Halt:      return "Halt\n";
+		case MemSet:    return std::format("[MemSet](addr={}, val={})\n", a, b);
+		case MemCopy:   return std::format("[MemCopy](to={}, from={})\n", a, b);
+		case BinaryOp:  return std::format("[{}](lhs={}, rhs={})\n", static_cast<OpCode>(a), b, c);
+		case CheckJumpTrue:  return std::format("[CheckJumpTrue](x={}, y={}, block={})\n", a, b, static_cast<BlockType>(c));
+		case CheckJumpFalse: return std::format("[CheckJumpFalse](x={}, y={}, block={})\n", a, b, static_cast<BlockType>(c));
+		case OpJumpTrue:     return std::format("[{}JumpTrue](lhs={}, rhs={})\n", static_cast<OpCode>(a), b, c);
+		case OpJumpFalse:    return std::format("[{}JumpFalse](lhs={}, rhs={})\n", static_cast<OpCode>(a), b, c);
+		case MemSetRun:      return std::format("[MemSetRun](addr={}, val={}, count={})\n", a, b, c);
+		case MarkLabel:
+		case MemPrint:
+		case MemPrintAll:
+			// Labels never make it this far, and the rest already print enough by themselves.
+			return "";
+		}
+
+		return "Invalid";
+	}
+
+	std::ostream& operator<<(std::ostream& lhs, Instruction const& rhs)
+	{
+		return (lhs << rhs.ToString());
+	}
+}
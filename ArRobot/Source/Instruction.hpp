@@ -0,0 +1,179 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Command.hpp"
+
+namespace ArRobot {
+	/// What a Robot actually runs: a Command with all the strings boiled away. Labels are gone,
+	/// jumps land on the index of an instruction instead.
+	///
+	/// What the operands mean depends on the type:
+	///   Move                       a = x,      b = y
+	///   StepToward                 a = block
+	///   CheckDir                   a = x,      b = y,   c = block
+	///   Jump, JumpTrue, JumpFalse  a = target
+	///   MemSet                     a = addr,   b = value
+	///   MemCopy                    a = to,     b = from
+	///   BinaryOp                   a = opCode, b = lhs, c = rhs
+	///   MemPrint                   a = addr
+	///
+	/// Superinstructions keep the operands of the first instruction they fused; the rest are 
+	/// read from the instructions after them, which are still there:
+	///   CheckJumpTrue/False        like CheckDir, the jump is next
+	///   OpJumpTrue/False           like BinaryOp, the jump is next
+	///   MemSetRun                  like MemSet,  c = how many MemSets in a row
+	struct Instruction
+	{
+		CommandType type{};
+		std::uint32_t ticks{};
+		std::int32_t a{};
+		std::int32_t b{};
+		std::int32_t c{};
+
+		/// jumpTarget is only used by jumps, which have no idea where their label is.
+		static constexpr Instruction FromCommand(Command const& cmd, std::int32_t jumpTarget = -1)
+		{
+			using enum CommandType;
+			Instruction res{cmd.GetType(), static_cast<std::uint32_t>(cmd.GetTickCount())};
+			switch (cmd.GetType())
+			{
+			case Move:
+				res.a = cmd.As<Move>().x;
+				res.b = cmd.As<Move>().y;
+				break;
+			case StepToward:
+				res.a = static_cast<std::int32_t>(cmd.As<StepToward>().block);
+				break;
+			case CheckDir:
+				res.a = cmd.As<CheckDir>().x;
+				res.b = cmd.As<CheckDir>().y;
+				res.c = static_cast<std::int32_t>(cmd.As<CheckDir>().block);
+				break;
+			case Jump:
+			case JumpTrue:
+			case JumpFalse:
+				res.a = jumpTarget;
+				break;
+			case MemSet:
+				res.a = static_cast<std::int32_t>(cmd.As<MemSet>().addr);
+				res.b = cmd.As<MemSet>().value;
+				break;
+			case MemCopy:
+				res.a = static_cast<std::int32_t>(cmd.As<MemCopy>().toAddr);
+				res.b = static_cast<std::int32_t>(cmd.As<MemCopy>().fromAddr);
+				break;
+			case BinaryOp:
+				res.a = static_cast<std::int32_t>(cmd.As<BinaryOp>().opCode);
+				res.b = static_cast<std::int32_t>(cmd.As<BinaryOp>().lhsAddr);
+				res.c = static_cast<std::int32_t>(cmd.As<BinaryOp>().rhsAddr);
+				break;
+			case MemPrint:
+				res.a = static_cast<std::int32_t>(cmd.As<MemPrint>().addr);
+				break;
+			default:
+				break;
+			}
+			return res;
+		}
+
+		constexpr bool IsJump() const
+		{
+			using enum CommandType;
+			return type == Jump || type == JumpTrue || type == JumpFalse;
+		}
+
+		/// How many instructions running this one covers; only superinstructions cover more
+		/// than themselves.
+		constexpr std::size_t GetWidth() const
+		{
+			using enum CommandType;
+			switch (type)
+			{
+			case CheckJumpTrue:
+			case CheckJumpFalse:
+			case OpJumpTrue:
+			case OpJumpFalse:
+				return 2;
+			case MemSetRun:
+				return static_cast<std::size_t>(c);
+			default:
+				return 1;
+			}
+		}
+
+		/// Whether running this one may land somewhere other than right after it.
+		constexpr bool IsBranch() const
+		{
+			using enum CommandType;
+			return IsJump() || type == CheckJumpTrue || type == CheckJumpFalse || 
+				type == OpJumpTrue || type == OpJumpFalse;
+		}
+
+		/// Whether running this one needs what is in the flag (see Cmd::gc_FlagAddress) right
+		/// before it.
+		constexpr bool ReadsFlag() const
+		{
+			using enum CommandType;
+			auto constexpr Flag {static_cast<std::int32_t>(Cmd::gc_FlagAddress)};
+			switch (type)
+			{
+			case JumpTrue:
+			case JumpFalse:
+			case MemPrintAll:
+				return true;
+			case MemCopy:  return b == Flag;
+			case BinaryOp: return b == Flag || c == Flag;
+			case MemPrint: return a == Flag;
+			// Only made after everything that asks, but better safe than sorry.
+			case CheckJumpTrue:
+			case CheckJumpFalse:
+			case OpJumpTrue:
+			case OpJumpFalse:
+			case MemSetRun:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		/// Whether running this one leaves something new in the flag, no matter what was there.
+		constexpr bool WritesFlag() const
+		{
+			using enum CommandType;
+			auto constexpr Flag {static_cast<std::int32_t>(Cmd::gc_FlagAddress)};
+			switch (type)
+			{
+			case CheckDir:
+			case StepToward:
+				return true;
+			case MemSet:
+			case MemCopy:
+				return a == Flag;
+			default:
+				return false;
+			}
+		}
+
+		/// Whether writing the flag is all this one does, so it can go if nobody reads it.
+		constexpr bool OnlyWritesFlag() const
+		{
+			// StepToward overwrites the flag, but moving around is no dead write.
+			return WritesFlag() && type != CommandType::StepToward;
+		}
+
+		constexpr bool operator==(Instruction const&) const = default;
+
+		std::string ToString() const;
+		friend std::ostream& operator<<(std::ostream& lhs, Instruction const& rhs);
+	};
+}
+
+namespace std {
+	template <>
+	struct formatter<ArRobot::Instruction> : formatter<std::string>
+	{
+		auto format(ArRobot::Instruction const& inst, format_context context) const
+		{
+			return formatter<std::string>{}.format(inst.ToString(), context);
+		}
+	};
+}
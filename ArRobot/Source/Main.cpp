@@ -3,17 +3,58 @@
 #include "Robot.hpp"
 #include "ArRobotException.hpp"
 #include "PlayField.hpp"
+#include "Assembler.hpp"
 
 namespace arge = Arge;
 
 namespace ArRobot {
+	using namespace Literals;
+
 	class MyGame : public arge::Engine
 	{
 	private:
 		static constexpr auto CamSpeed {300.0f};
 
+		// Walks right until it bumps into a wall, then goes down around it.
+		static constexpr auto gc_WallFollower {R"(
+			: Start
+			Move 1, 0
+			: RightWallCheck
+			Check 1, 0, Wall
+			JumpFalse Start
+			Check 0, 1, Wall
+			JumpFalse NoWall
+			Halt
+			: NoWall
+			Move 0, 1
+			Jump RightWallCheck
+		)"_arobot};
+
 	public:
-		using Engine::Engine;
+		// Off unless asked for on the command line.
+		struct Options
+		{
+			// --profile: writes Profile.txt and Profile.json on the way out.
+			bool bProfile{};
+			// --trace: debug printing goes to Trace.log instead of the console.
+			bool bTrace{};
+		};
+
+		MyGame(std::string_view windowTitle, size_t windowWidth, size_t windowHeight, Options const& options)
+			: Engine{windowTitle, windowWidth, windowHeight}, options{options}
+		{
+		}
+
+		static Options ParseOptions(std::span<char* const> args)
+		{
+			Options res{};
+			for (std::string_view const arg : args | std::views::drop(1))
+			{
+				res.bProfile = res.bProfile || arg == "--profile";
+				res.bTrace = res.bTrace || arg == "--trace";
+			}
+			return res;
+		}
 
 		void OnSetup() override
 		{
@@ -21,34 +62,23 @@ namespace ArRobot {
 			pCam0->TranslateBy(GetWindow().GetCenter());
 
 			playField.SetTickMilliseconds(100.0f);
-			playField.ForEachRobot([](auto& robot) {
+			playField.AddRobot(0, 0);
+			playField.ForEachRobot([this](auto& robot) {
 				robot.ToggleDebugPrinting(true);
 				robot.ToggleDebugVisuals(true);
+				robot.ToggleProfiling(options.bProfile);
 			});
-			playField.GetGrid().At(5, 0) = BlockType::Wall;
-			playField.GetGrid().At(7, 1) = BlockType::Wall;
-			playField.GetGrid().At(7, 2) = BlockType::Wall;
-			playField.GetGrid().At(9, 3) = BlockType::Wall;
-			playField.GetGrid().At(8, 4) = BlockType::Wall;
-
-			std::vector<Command> const commands{
-				Command::MakeMarkLabel("Start"),
-				Command::MakeMove(1, 0),
-				Command::MakeMarkLabel("RightWallCheck"),
-				Command::MakeCheckDir(1, 0, BlockType::Wall),
-				Command::MakeJumpFalse("Start"),
-				Command::MakeCheckDir(0, 1, BlockType::Wall),
-				Command::MakeJumpFalse("NoWall"),
-				Command::MakeHalt(),
-				Command::MakeMarkLabel("NoWall"),
-				Command::MakeMove(0, 1),
-				Command::MakeJump("RightWallCheck"),
-			};
-
-			for (auto const& cmd : commands)
+			if (options.bTrace)
 			{
-				playField.AddCommand(cmd);
+				playField.SetTraceSink(optTraceSink.emplace("Trace.log"));
 			}
+			playField.SetBlock(5, 0, BlockType::Wall);
+			playField.SetBlock(7, 1, BlockType::Wall);
+			playField.SetBlock(7, 2, BlockType::Wall);
+			playField.SetBlock(9, 3, BlockType::Wall);
+			playField.SetBlock(8, 4, BlockType::Wall);
+
+			playField.LoadProgram(gc_WallFollower);
 		}
 
 		void OnUpdate([[maybe_unused]] float dt) override
@@ -69,6 +99,22 @@ namespace ArRobot {
 			playField.Draw(gfx, *pCam0);
 		}
 
+		void OnShutdown() override
+		{
+			if (options.bProfile)
+			{
+				ExportProfiles();
+			}
+		}
+
+		// Only the first robot, they all run the same program anyways.
+		void ExportProfiles()
+		{
+			auto const& robot {playField.GetRobot(0)};
+			robot.GetProfiler().Export("Profile.txt", robot.GetUnfusedProgram());
+			robot.GetProfiler().Export("Profile.json", robot.GetUnfusedProgram());
+		}
+
 		void DrawCamRect(arge::Camera const& cam)
 		{
 			auto const camRect {cam.GetRect(GetWindow())};
@@ -76,16 +122,20 @@ namespace ArRobot {
 		}
 
 	private:
+		Options options;
 		std::unique_ptr<arge::Camera> pCam0 {};
 		arge::CameraDragger camDragger{};
 		arge::CameraWheelScalar camScaler{};
+		// Only made with --trace, since it starts a thread of its own.
+		std::optional<TraceSink> optTraceSink{};
 		PlayField playField{};
 	};
 }
 
-int SDL_main(int, char**)
+int SDL_main(int argc, char** argv)
 {
-	ArRobot::MyGame game{"Tiddies", 1080, 720};
+	using ArRobot::MyGame;
+	MyGame game{"Tiddies", 1080, 720, MyGame::ParseOptions({argv, static_cast<std::size_t>(argc)})};
 	try 
 	{ 
 		game.Run(); 
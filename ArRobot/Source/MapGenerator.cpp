@@ -0,0 +1,196 @@
+#include "pch.hpp"
+#include "MapGenerator.hpp"
+
+namespace ArRobot {
+	MapGenerator::MapGenerator(std::uint64_t seed, std::size_t threadCount)
+		: m_Root{seed}, m_ThreadCount{std::max(threadCount, std::size_t{1})}
+	{
+	}
+
+	std::size_t MapGenerator::DefaultThreadCount()
+	{
+		// Zero when it cannot tell.
+		return std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	template <class Callable>
+	void MapGenerator::ForEachStrip(std::size_t rowCount, Callable const& generate) const
+	{
+		auto const threadCount {std::min(m_ThreadCount, rowCount)};
+		if (threadCount <= 1)
+		{
+			generate(std::size_t{}, rowCount);
+			return;
+		}
+
+		// A few strips per thread, so one slow strip does not hold everybody up.
+		auto const stripSize {std::max(rowCount / (threadCount * 4), std::size_t{1})};
+		std::atomic<std::size_t> nextRow{};
+		auto const work {[&] {
+			for (auto first {nextRow.fetch_add(stripSize)}; first < rowCount; first = nextRow.fetch_add(stripSize))
+			{
+				generate(first, std::min(first + stripSize, rowCount));
+			}
+		}};
+
+		std::vector<std::jthread> helpers{};
+		helpers.reserve(threadCount - 1);
+		for (std::size_t i {1}; i < threadCount; ++i)
+		{
+			helpers.emplace_back(work);
+		}
+		work();
+	}
+
+	void MapGenerator::Maze(Arge::Grid<BlockType>& grid) const
+	{
+		using enum BlockType;
+		auto const width {grid.GetWidth()};
+		auto const height {grid.GetHeight()};
+		auto const roomCols {(std::max(width, std::size_t{1}) - 1) / 2};
+		auto const roomRows {(std::max(height, std::size_t{1}) - 1) / 2};
+
+		// Room row r owns the row of Walls above it (2r) and itself (2r + 1).
+		ForEachStrip(roomRows, [&](std::size_t firstRow, std::size_t endRow) {
+			std::vector<BlockType> wallRow(width);
+			std::vector<BlockType> roomRow(width);
+			for (auto r {firstRow}; r < endRow; ++r)
+			{
+				auto rng {RowStream(Layer::Maze, r)};
+				std::ranges::fill(wallRow, Wall);
+				std::ranges::fill(roomRow, Wall);
+
+				// Rooms go east in runs; every run ends by opening up north from one of its
+				// rooms, so each run hangs off the rows above exactly once. The top row has
+				// nothing above it, so it is one long run.
+				std::size_t runStart{};
+				for (std::size_t c{}; c < roomCols; ++c)
+				{
+					roomRow[2 * c + 1] = Nothing;
+					if (c + 1 < roomCols && (r == 0 || (rng() & 1) != 0))
+					{
+						roomRow[2 * c + 2] = Nothing;
+						continue;
+					}
+
+					if (r > 0)
+					{
+						auto const runLength {c - runStart + 1};
+						auto const k {runStart + static_cast<std::size_t>((static_cast<std::uint64_t>(rng()) * runLength) >> 32)};
+						wallRow[2 * k + 1] = Nothing;
+					}
+					runStart = c + 1;
+				}
+
+				grid.WriteRow(2 * r, wallRow);
+				grid.WriteRow(2 * r + 1, roomRow);
+			}
+		});
+
+		// Whatever is left under the last room row.
+		std::vector<BlockType> const wallRow(width, Wall);
+		for (auto y {2 * roomRows}; y < height; ++y)
+		{
+			grid.WriteRow(y, wallRow);
+		}
+	}
+
+	void MapGenerator::Caves(Arge::Grid<BlockType>& grid, float wallChance, std::size_t steps) const
+	{
+		auto const width {grid.GetWidth()};
+		auto const height {grid.GetHeight()};
+		auto const threshold {ToThreshold(wallChance)};
+
+		// A byte per cell while it settles, packed into the grid at the end.
+		std::vector<std::uint8_t> curr(width * height);
+		std::vector<std::uint8_t> next(width * height);
+		ForEachStrip(height, [&](std::size_t firstRow, std::size_t endRow) {
+			std::vector<std::uint32_t> raw(width);
+			for (auto y {firstRow}; y < endRow; ++y)
+			{
+				RowStream(Layer::Caves, y).Fill(raw);
+				for (std::size_t x{}; x < width; ++x)
+				{
+					curr[y * width + x] = raw[x] < threshold;
+				}
+			}
+		});
+
+		for (std::size_t step{}; step < steps; ++step)
+		{
+			ForEachStrip(height, [&](std::size_t firstRow, std::size_t endRow) {
+				// Walls in each column of the three rows around y, then three columns of those.
+				std::vector<std::uint8_t> columns(width + 2);
+				for (auto y {firstRow}; y < endRow; ++y)
+				{
+					auto const* const pAbove {y > 0 ? &curr[(y - 1) * width] : nullptr};
+					auto const* const pRow {&curr[y * width]};
+					auto const* const pBelow {y + 1 < height ? &curr[(y + 1) * width] : nullptr};
+					columns.front() = 3;
+					columns.back() = 3;
+					for (std::size_t x{}; x < width; ++x)
+					{
+						columns[x + 1] = static_cast<std::uint8_t>(
+							(pAbove ? pAbove[x] : 1) + pRow[x] + (pBelow ? pBelow[x] : 1));
+					}
+
+					auto* const pNext {&next[y * width]};
+					for (std::size_t x{}; x < width; ++x)
+					{
+						pNext[x] = columns[x] + columns[x + 1] + columns[x + 2] >= 5;
+					}
+				}
+			});
+			std::swap(curr, next);
+		}
+
+		ForEachStrip(height, [&](std::size_t firstRow, std::size_t endRow) {
+			std::vector<BlockType> row(width);
+			for (auto y {firstRow}; y < endRow; ++y)
+			{
+				for (std::size_t x{}; x < width; ++x)
+				{
+					row[x] = curr[y * width + x] ? BlockType::Wall : BlockType::Nothing;
+				}
+				grid.WriteRow(y, row);
+			}
+		});
+	}
+
+	void MapGenerator::Scatter(Arge::Grid<BlockType>& grid, float itemChance, float pitChance) const
+	{
+		auto const width {grid.GetWidth()};
+		auto const itemThreshold {ToThreshold(itemChance)};
+		auto const pitThreshold {itemThreshold + ToThreshold(pitChance)};
+
+		ForEachStrip(grid.GetHeight(), [&](std::size_t firstRow, std::size_t endRow) {
+			std::vector<std::uint32_t> raw(width);
+			std::vector<BlockType> row(width);
+			for (auto y {firstRow}; y < endRow; ++y)
+			{
+				RowStream(Layer::Scatter, y).Fill(raw);
+				grid.ReadRow(y, row);
+				for (std::size_t x{}; x < width; ++x)
+				{
+					if (row[x] == BlockType::Nothing)
+					{
+						row[x] = raw[x] < itemThreshold ? BlockType::Item :
+							raw[x] < pitThreshold ? BlockType::Pit : BlockType::Nothing;
+					}
+				}
+				grid.WriteRow(y, row);
+			}
+		});
+	}
+
+	Random::Stream MapGenerator::RowStream(Layer layer, std::size_t row) const
+	{
+		return m_Root.Split(static_cast<std::uint64_t>(layer)).Split(row);
+	}
+
+	std::uint64_t MapGenerator::ToThreshold(float chance)
+	{
+		auto constexpr Scale {static_cast<double>(std::uint64_t{1} << 32)};
+		return static_cast<std::uint64_t>(std::clamp(static_cast<double>(chance), 0.0, 1.0) * Scale);
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "BlockType.hpp"
+#include "Util/Random.hpp"
+
+#include <Arge/Arge.hpp>
+
+namespace ArRobot {
+	/// Fills grids with mazes, caves, and items and pits sprinkled on top. The grid is cut into
+	/// strips of whole rows that are generated on different threads; every row draws from a
+	/// stream of its own, so the same seed gives the same map no matter how many threads, or
+	/// which one got which strip.
+	class MapGenerator
+	{
+	public:
+		explicit MapGenerator(std::uint64_t seed, std::size_t threadCount = DefaultThreadCount());
+
+		[[nodiscard]]
+		static std::size_t DefaultThreadCount();
+
+		/// A perfect maze (exactly one way between any two rooms): rooms on odd cells, Walls
+		/// everywhere else, including around the edge. Made with the sidewinder algorithm, which
+		/// only ever looks at one row of rooms at a time.
+		void Maze(Arge::Grid<BlockType>& grid) const;
+
+		/// Cave automata: starts out with wallChance of the cells as Walls, then every step a cell
+		/// becomes a Wall if at least five of the nine cells around it (itself included) are.
+		/// Outside the grid counts as Wall.
+		void Caves(Arge::Grid<BlockType>& grid, float wallChance = 0.45f, std::size_t steps = 4) const;
+
+		/// Turns some of the Nothing cells into Items and Pits, leaves everything else alone.
+		void Scatter(Arge::Grid<BlockType>& grid, float itemChance, float pitChance) const;
+
+	private:
+		// Calls generate(firstRow, endRow) for strips covering [0, rowCount), spread over the
+		// threads; returns once they are all done.
+		template <class Callable>
+		void ForEachStrip(std::size_t rowCount, Callable const& generate) const;
+
+		// Each algorithm gets its streams from a different Split of the root, so layering one on
+		// top of the other does not repeat the same numbers.
+		enum class Layer : std::uint64_t
+		{
+			Maze,
+			Caves,
+			Scatter,
+		};
+
+		[[nodiscard]]
+		Random::Stream RowStream(Layer layer, std::size_t row) const;
+
+		// Chances go in 32 bits, so a raw number below this hits.
+		[[nodiscard]]
+		static std::uint64_t ToThreshold(float chance);
+
+	private:
+		Random::Stream m_Root;
+		std::size_t m_ThreadCount;
+	};
+}
@@ -0,0 +1,49 @@
+#include "pch.hpp"
+#include "MemoryVerifier.hpp"
+
+namespace ArRobot {
+	MemoryVerifier::MemoryVerifier(std::size_t memorySize) : m_MemorySize{memorySize}
+	{
+		if (auto constexpr MinSize {Cmd::gc_FlagAddress + 1}; m_MemorySize < MinSize)
+		{
+			throw GenericError{"A robot needs at least {} memory cells, {} is too few", MinSize, m_MemorySize};
+		}
+	}
+
+	void MemoryVerifier::Verify(std::span<Instruction const> program) const
+	{
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			using enum CommandType;
+			switch (auto const& inst {program[i]}; inst.type)
+			{
+			case MemSet:
+				VerifyAddress(i, inst.a, "writes to");
+				break;
+			case MemCopy:
+				VerifyAddress(i, inst.a, "writes to");
+				VerifyAddress(i, inst.b, "reads from");
+				break;
+			case BinaryOp:
+				VerifyAddress(i, inst.b, "writes to");
+				VerifyAddress(i, inst.c, "reads from");
+				break;
+			case MemPrint:
+				VerifyAddress(i, inst.a, "prints");
+				break;
+			default:
+				// Only ever touch the flag, which is always there.
+				break;
+			}
+		}
+	}
+
+	void MemoryVerifier::VerifyAddress(std::size_t instIndex, std::int32_t addr, std::string_view access) const
+	{
+		if (addr < 0 || static_cast<std::size_t>(addr) >= m_MemorySize)
+		{
+			throw ParseError{"Instruction {} {} address {}, but the robot only has {} memory cells",
+				instIndex, access, addr, m_MemorySize};
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+#include "ArRobotException.hpp"
+
+namespace ArRobot {
+	/// Makes sure a program only ever touches memory cells a robot actually has.
+	///
+	/// Addresses are always written right into the instructions, so looking at every one of
+	/// them once when the program gets loaded proves the robot can run it without checking a
+	/// single access.
+	class MemoryVerifier
+	{
+	public:
+		/// Throws a GenericError if the memory is too small to even hold the flag.
+		explicit MemoryVerifier(std::size_t memorySize);
+
+		/// Throws a ParseError naming the first instruction that reaches outside of the memory.
+		void Verify(std::span<Instruction const> program) const;
+
+		[[nodiscard]]
+		constexpr std::size_t GetMemorySize() const
+		{
+			return m_MemorySize;
+		}
+
+	private:
+		void VerifyAddress(std::size_t instIndex, std::int32_t addr, std::string_view access) const;
+
+	private:
+		std::size_t m_MemorySize;
+	};
+}
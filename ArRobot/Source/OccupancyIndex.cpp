@@ -0,0 +1,55 @@
+#include "pch.hpp"
+#include "OccupancyIndex.hpp"
+
+namespace ArRobot {
+	OccupancyIndex::OccupancyIndex(std::size_t width, std::size_t height)
+		: m_Width{width}, m_Height{height}, m_WordsPerRow{(width + 63) / 64},
+		  m_Bits(m_WordsPerRow * height), m_Ids(width * height)
+	{
+	}
+
+	void OccupancyIndex::Place(RobotId id, std::int32_t x, std::int32_t y)
+	{
+		if (!IsInBounds(x, y))
+		{
+			throw GenericError{"Robot {} placed at ({}, {}), outside of the {}x{} grid",
+				id, x, y, m_Width, m_Height};
+		}
+
+		if (auto const other {RobotAt(x, y)})
+		{
+			auto const otherId {*other};
+			throw GenericError{"Robot {} placed at ({}, {}), but robot {} is already there", id, x, y, otherId};
+		}
+
+		auto const [word, bit] {BitOf(x, y)};
+		m_Bits[word] |= std::uint64_t{1} << bit;
+		m_Ids[CellOf(x, y)] = id;
+		++m_Count;
+	}
+
+	void OccupancyIndex::Remove(std::int32_t x, std::int32_t y)
+	{
+		if (IsOccupied(x, y))
+		{
+			auto const [word, bit] {BitOf(x, y)};
+			m_Bits[word] &= ~(std::uint64_t{1} << bit);
+			--m_Count;
+		}
+	}
+
+	std::size_t OccupancyIndex::CountInRect(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height) const
+	{
+		std::size_t res{};
+		ForEachWordInRect(x, y, width, height, [&res](std::size_t, std::size_t, std::uint64_t bits) {
+			res += static_cast<std::size_t>(std::popcount(bits));
+		});
+		return res;
+	}
+
+	void OccupancyIndex::Clear()
+	{
+		std::ranges::fill(m_Bits, 0);
+		m_Count = 0;
+	}
+}
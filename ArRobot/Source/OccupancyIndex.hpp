@@ -0,0 +1,183 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "ArRobotException.hpp"
+
+namespace ArRobot {
+	/// Which cells of a grid have a robot on them, and which one. Kept next to the grid instead of
+	/// in it, since blocks and robots may share a cell (a robot standing on an Item, say).
+	///
+	/// A bit per cell answers "is anyone there?", and the id is only looked at when there is.
+	/// Every row starts on a fresh word, so range queries can skip 64 empty cells at a time.
+	class OccupancyIndex
+	{
+	public:
+		using RobotId = std::uint32_t;
+
+		OccupancyIndex(std::size_t width, std::size_t height);
+
+		/// Out of the grid counts as empty.
+		[[nodiscard]]
+		constexpr bool IsOccupied(std::int32_t x, std::int32_t y) const
+		{
+			if (!IsInBounds(x, y))
+			{
+				return false;
+			}
+
+			auto const [word, bit] {BitOf(x, y)};
+			return (m_Bits[word] >> bit) & 1;
+		}
+
+		[[nodiscard]]
+		constexpr std::optional<RobotId> RobotAt(std::int32_t x, std::int32_t y) const
+		{
+			if (!IsOccupied(x, y))
+			{
+				return std::nullopt;
+			}
+			return m_Ids[CellOf(x, y)];
+		}
+
+		/// Throws if the cell is taken or outside of the grid.
+		void Place(RobotId id, std::int32_t x, std::int32_t y);
+		void Remove(std::int32_t x, std::int32_t y);
+
+		/// Returns false and leaves everything alone if someone is already there. Both cells
+		/// must be in the grid, and the first one must be taken.
+		constexpr bool TryMove(std::int32_t fromX, std::int32_t fromY, std::int32_t toX, std::int32_t toY)
+		{
+			AROBOT_DA(IsOccupied(fromX, fromY), "Nobody to move at ({}, {})", fromX, fromY);
+			AROBOT_DA(IsInBounds(toX, toY), "Moving to ({}, {}), outside of the grid", toX, toY);
+			if (fromX == toX && fromY == toY)
+			{
+				return true;
+			}
+
+			if (IsOccupied(toX, toY))
+			{
+				return false;
+			}
+
+			auto const [fromWord, fromBit] {BitOf(fromX, fromY)};
+			auto const [toWord, toBit] {BitOf(toX, toY)};
+			m_Bits[fromWord] &= ~(std::uint64_t{1} << fromBit);
+			m_Bits[toWord] |= std::uint64_t{1} << toBit;
+			m_Ids[CellOf(toX, toY)] = m_Ids[CellOf(fromX, fromY)];
+			return true;
+		}
+
+		/// How many robots are in the rectangle; whatever part of it is outside of the grid
+		/// is just empty.
+		[[nodiscard]]
+		std::size_t CountInRect(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height) const;
+
+		/// Calls doWhat(id, x, y) for every robot in the rectangle, row by row.
+		template <std::invocable<RobotId, std::int32_t, std::int32_t> Callable>
+		void ForEachInRect(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height,
+			Callable&& doWhat) const
+		{
+			ForEachWordInRect(x, y, width, height,
+				[this, &doWhat](std::size_t row, std::size_t firstCol, std::uint64_t bits) {
+					for (; bits != 0; bits &= bits - 1)
+					{
+						auto const col {firstCol + static_cast<std::size_t>(std::countr_zero(bits))};
+						doWhat(m_Ids[col + row * m_Width], static_cast<std::int32_t>(col),
+							static_cast<std::int32_t>(row));
+					}
+				});
+		}
+
+		void Clear();
+
+		[[nodiscard]]
+		constexpr std::size_t GetCount() const
+		{
+			return m_Count;
+		}
+
+		[[nodiscard]]
+		constexpr std::size_t GetWidth() const
+		{
+			return m_Width;
+		}
+
+		[[nodiscard]]
+		constexpr std::size_t GetHeight() const
+		{
+			return m_Height;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsInBounds(std::int32_t x, std::int32_t y) const
+		{
+			return 0 <= x && static_cast<std::size_t>(x) < m_Width &&
+				0 <= y && static_cast<std::size_t>(y) < m_Height;
+		}
+
+	private:
+		[[nodiscard]]
+		constexpr std::size_t CellOf(std::int32_t x, std::int32_t y) const
+		{
+			return static_cast<std::size_t>(x) + static_cast<std::size_t>(y) * m_Width;
+		}
+
+		// The word, and the bit inside of it.
+		[[nodiscard]]
+		constexpr std::pair<std::size_t, std::size_t> BitOf(std::int32_t x, std::int32_t y) const
+		{
+			auto const col {static_cast<std::size_t>(x)};
+			return {static_cast<std::size_t>(y) * m_WordsPerRow + col / 64, col % 64};
+		}
+
+		// Calls doWhat(row, firstCol, bits) for every word that overlaps the rectangle, with the
+		// bits outside of it masked off; bit i of a word is column firstCol + i.
+		template <class Callable>
+		void ForEachWordInRect(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height,
+			Callable&& doWhat) const
+		{
+			auto const clampTo {[](std::int64_t value, std::size_t max) {
+				return static_cast<std::size_t>(std::clamp<std::int64_t>(value, 0, static_cast<std::int64_t>(max)));
+			}};
+			auto const beginX {clampTo(x, m_Width)};
+			auto const endX {clampTo(std::int64_t{x} + width, m_Width)};
+			auto const beginY {clampTo(y, m_Height)};
+			auto const endY {clampTo(std::int64_t{y} + height, m_Height)};
+			if (beginX >= endX)
+			{
+				return;
+			}
+
+			for (auto row {beginY}; row < endY; ++row)
+			{
+				for (auto word {beginX / 64}; word <= (endX - 1) / 64; ++word)
+				{
+					auto bits {m_Bits[row * m_WordsPerRow + word]};
+					if (bits == 0)
+					{
+						continue;
+					}
+
+					auto const firstCol {word * 64};
+					if (beginX > firstCol)
+					{
+						bits &= ~std::uint64_t{0} << (beginX - firstCol);
+					}
+					if (endX < firstCol + 64)
+					{
+						bits &= ~(~std::uint64_t{0} << (endX - firstCol));
+					}
+					doWhat(row, firstCol, bits);
+				}
+			}
+		}
+
+	private:
+		std::size_t m_Width;
+		std::size_t m_Height;
+		std::size_t m_WordsPerRow;
+		std::size_t m_Count{};
+		std::vector<std::uint64_t> m_Bits{};
+		// Only means something where the bit is set.
+		std::vector<RobotId> m_Ids{};
+	};
+}
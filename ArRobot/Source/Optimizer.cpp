@@ -0,0 +1,235 @@
+#include "pch.hpp"
+#include "Optimizer.hpp"
+
+namespace ArRobot {
+	std::vector<Instruction> Optimizer::Optimize(std::span<Instruction const> program)
+	{
+		m_Program.assign(program.begin(), program.end());
+		m_RewriteCount = 0;
+
+		// Every rewrite may open up more work for the others.
+		for (bool bChanged {true}; bChanged;)
+		{
+			FindJumpTargets();
+			bChanged = RewriteJumpsToNext() | RewriteOverwrittenWrites() | RewriteDeadFlagWrites();
+			if (!m_bStrict)
+			{
+				bChanged = FuseMoves() | ThreadJumps() | bChanged;
+			}
+		}
+
+		if (!m_bStrict)
+		{
+			RemoveDoNothings();
+		}
+
+		return std::move(m_Program);
+	}
+
+	bool Optimizer::RewriteJumpsToNext()
+	{
+		bool bChanged{};
+		for (std::size_t i{}; i < m_Program.size(); ++i)
+		{
+			// Lands where it would have gone anyways.
+			if (m_Program[i].IsJump() && static_cast<std::size_t>(m_Program[i].a) == i + 1)
+			{
+				Kill(i);
+				bChanged = true;
+			}
+		}
+		return bChanged;
+	}
+
+	bool Optimizer::RewriteOverwrittenWrites()
+	{
+		using enum CommandType;
+		bool bChanged{};
+		for (std::size_t i{}; i + 1 < m_Program.size(); ++i)
+		{
+			auto const& curr {m_Program[i]};
+			auto const& next {m_Program[i + 1]};
+
+			// A copy into itself does nothing at all.
+			auto bDead {curr.type == MemCopy && curr.a == curr.b};
+
+			// Overwritten right away, without being read in between. Whoever jumps straight to
+			// the next one does not care either.
+			bDead = bDead || (curr.type == MemSet &&
+				((next.type == MemSet && next.a == curr.a) ||
+				 (next.type == MemCopy && next.a == curr.a && next.b != curr.a)));
+
+			if (bDead)
+			{
+				Kill(i);
+				bChanged = true;
+			}
+		}
+		return bChanged;
+	}
+
+	bool Optimizer::RewriteDeadFlagWrites()
+	{
+		using enum CommandType;
+		auto const size {m_Program.size()};
+
+		// Backwards liveness of the flag; liveIn[size] is running off the end.
+		std::vector<bool> liveIn(size + 1);
+		for (bool bChanged {true}; bChanged;)
+		{
+			bChanged = false;
+			for (auto i {size}; i-- > 0;)
+			{
+				auto const& inst {m_Program[i]};
+				bool bLiveOut{};
+				switch (inst.type)
+				{
+				case Halt: bLiveOut = false; break;
+				case Jump: bLiveOut = liveIn[static_cast<std::size_t>(inst.a)]; break;
+				default:   bLiveOut = liveIn[i + 1]; break;
+				}
+				auto const bLive {inst.ReadsFlag() || (!inst.WritesFlag() && bLiveOut)};
+
+				if (bLive != liveIn[i])
+				{
+					liveIn[i] = bLive;
+					bChanged = true;
+				}
+			}
+		}
+
+		// Nobody reads what these write before it gets overwritten.
+		bool bChanged{};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			if (m_Program[i].OnlyWritesFlag() && !liveIn[i + 1])
+			{
+				Kill(i);
+				bChanged = true;
+			}
+		}
+		return bChanged;
+	}
+
+	bool Optimizer::FuseMoves()
+	{
+		using enum CommandType;
+		bool bChanged{};
+		for (std::size_t i{}; i < m_Program.size(); ++i)
+		{
+			auto& curr {m_Program[i]};
+			if (curr.type != Move)
+			{
+				continue;
+			}
+
+			// DoNothings are about to be removed anyways. Nobody may jump in between though, or
+			// the second Move would also run on its own.
+			auto next {i + 1};
+			while (next < m_Program.size() && !m_IsJumpTarget[next] && m_Program[next].type == DoNothing)
+			{
+				++next;
+			}
+
+			if (next < m_Program.size() && !m_IsJumpTarget[next] && m_Program[next].type == Move &&
+				IsSameWay(curr, m_Program[next]))
+			{
+				curr.a += m_Program[next].a;
+				curr.b += m_Program[next].b;
+				Kill(next);
+				bChanged = true;
+			}
+		}
+		return bChanged;
+	}
+
+	bool Optimizer::IsSameWay(Instruction const& lhs, Instruction const& rhs)
+	{
+		// Along one axis and the same direction, so if the robot was gonna fall off the grid half
+		// way, it still falls off with a single Move. Turning is never fused, a diagonal would cut
+		// the corner the two Moves go around, and whoever stands on it.
+		auto const bAlongX {lhs.b == 0 && rhs.b == 0 && lhs.a * rhs.a >= 0};
+		auto const bAlongY {lhs.a == 0 && rhs.a == 0 && lhs.b * rhs.b >= 0};
+		return bAlongX || bAlongY;
+	}
+
+	bool Optimizer::ThreadJumps()
+	{
+		using enum CommandType;
+		bool bChanged{};
+		for (auto& inst : m_Program)
+		{
+			if (!inst.IsJump())
+			{
+				continue;
+			}
+
+			// Follows a chain of Jumps to its end; a chain that loops forever is left alone.
+			auto target {inst.a};
+			for (std::size_t hops{}; hops < m_Program.size() &&
+				m_Program[static_cast<std::size_t>(target)].type == Jump; ++hops)
+			{
+				target = m_Program[static_cast<std::size_t>(target)].a;
+			}
+
+			if (target != inst.a && m_Program[static_cast<std::size_t>(target)].type != Jump)
+			{
+				inst.a = target;
+				++m_RewriteCount;
+				bChanged = true;
+			}
+		}
+		return bChanged;
+	}
+
+	void Optimizer::RemoveDoNothings()
+	{
+		// The last instruction stays, so every jump target still has something to land on.
+		auto const size {m_Program.size()};
+		std::vector<std::int32_t> newIndices(size);
+		std::int32_t kept{};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			newIndices[i] = kept;
+			kept += m_Program[i].type != CommandType::DoNothing || i + 1 == size;
+		}
+
+		// A removed instruction is where the next kept one ends up, which is also where
+		// falling through it would have led.
+		std::size_t dest{};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			auto inst {m_Program[i]};
+			if (inst.type == CommandType::DoNothing && i + 1 != size)
+			{
+				++m_RewriteCount;
+				continue;
+			}
+
+			if (inst.IsJump())
+			{
+				inst.a = newIndices[static_cast<std::size_t>(inst.a)];
+			}
+			m_Program[dest++] = inst;
+		}
+		m_Program.resize(dest);
+	}
+
+	void Optimizer::Kill(std::size_t index)
+	{
+		m_Program[index] = {CommandType::DoNothing, m_Program[index].ticks};
+		++m_RewriteCount;
+	}
+
+	void Optimizer::FindJumpTargets()
+	{
+		m_IsJumpTarget.assign(m_Program.size(), false);
+		for (auto const& inst : m_Program)
+		{
+			if (inst.IsJump())
+			{
+				m_IsJumpTarget[static_cast<std::size_t>(inst.a)] = true;
+			}
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	/// Peephole optimizer over assembled programs.
+	///
+	/// A robot spends one tick on every instruction, so in strict mode instructions are only
+	/// ever rewritten in place into a DoNothing (which keeps their tick count); the robot does
+	/// the same things on the same ticks. Outside of strict mode dead instructions are deleted,
+	/// Moves in a straight line are fused and jumps are threaded. The robot still ends up in the
+	/// same places and memory, but gets there sooner, skipping some of the cells in between.
+	class Optimizer
+	{
+	public:
+		explicit Optimizer(bool bStrict = true) : m_bStrict{bStrict}
+		{
+		}
+
+		std::vector<Instruction> Optimize(std::span<Instruction const> program);
+
+		[[nodiscard]]
+		constexpr bool IsStrict() const
+		{
+			return m_bStrict;
+		}
+
+		constexpr void SetStrict(bool value)
+		{
+			m_bStrict = value;
+		}
+
+		/// How many instructions the last call to Optimize rewrote or removed.
+		[[nodiscard]]
+		constexpr std::size_t GetRewriteCount() const
+		{
+			return m_RewriteCount;
+		}
+
+	private:
+		// Each one returns whether it changed anything.
+		bool RewriteJumpsToNext();
+		bool RewriteOverwrittenWrites();
+		bool RewriteDeadFlagWrites();
+		bool FuseMoves();
+		bool ThreadJumps();
+		void RemoveDoNothings();
+
+		// Whether two Moves can become one.
+		[[nodiscard]]
+		static bool IsSameWay(Instruction const& lhs, Instruction const& rhs);
+
+		void Kill(std::size_t index);
+		void FindJumpTargets();
+
+	private:
+		std::vector<Instruction> m_Program{};
+		std::vector<bool> m_IsJumpTarget{};
+		std::size_t m_RewriteCount{};
+		bool m_bStrict;
+	};
+}
@@ -0,0 +1,284 @@
+#include "pch.hpp"
+#include "Parser.hpp"
+
+namespace ArRobot {
+	SyntaxTree Parser::Parse(std::string_view code)
+	{
+		return Parse(m_Tokenizer.Tokenize(code));
+	}
+
+	SyntaxTree Parser::Parse(std::vector<Token> tokens)
+	{
+		SyntaxTree tree{std::move(tokens)};
+		m_pTree = &tree;
+		m_Pos   = 0;
+
+		for (SkipNewLines(); !IsAtEnd(); SkipNewLines())
+		{
+			ParseDeclaration();
+		}
+
+		m_pTree = nullptr;
+		return tree;
+	}
+
+	void Parser::ParseDeclaration()
+	{
+		auto const begin {m_Pos};
+		Expect(TokenType::Hash, "a declaration (#proc, #sticker or #enum)");
+
+		auto const& keyword {Expect(TokenType::Keyword, "proc, sticker or enum after #")};
+		switch (keyword.As<TokenType::Keyword>().type)
+		{
+		case KeywordType::Proc:    ParseProc(begin);    break;
+		case KeywordType::Sticker: ParseSticker(begin); break;
+		case KeywordType::Enum:    ParseEnum(begin);    break;
+		default: AROBOT_UNREACHABLE_CODE();
+		}
+	}
+
+	void Parser::ParseProc(std::uint32_t begin)
+	{
+		auto const name {ExpectName("the name of the proc")};
+		if (m_pTree->FindProc(name))
+		{
+			throw ParseError{"Proc {} was declared twice", name};
+		}
+
+		auto const params {ParseParams()};
+		auto const body {ParseBody()};
+		m_pTree->m_Procs.push_back(
+			m_pTree->m_Arena.Make<Ast::Proc>(SpanFrom(begin), name, params, body));
+	}
+
+	void Parser::ParseSticker(std::uint32_t begin)
+	{
+		auto const name {ExpectName("the name of the sticker")};
+		if (m_pTree->FindSticker(name))
+		{
+			throw ParseError{"Sticker {} was declared twice", name};
+		}
+
+		auto const mark {m_NumScratch.size()};
+		Expect(TokenType::LeftSquareBracket, "[ to start the values of the sticker");
+		do
+		{
+			m_NumScratch.push_back(Expect(TokenType::Number, "a number").As<TokenType::Number>().num);
+		} while (Match(TokenType::Comma));
+		Expect(TokenType::RightSquareBracket, "] to close the values of the sticker");
+
+		auto const values {Commit(m_NumScratch, mark)};
+		m_pTree->m_Stickers.push_back(
+			m_pTree->m_Arena.Make<Ast::Sticker>(SpanFrom(begin), name, values));
+	}
+
+	void Parser::ParseEnum(std::uint32_t begin)
+	{
+		auto const name {ExpectName("the name of the enum")};
+		if (m_pTree->FindEnum(name))
+		{
+			throw ParseError{"Enum {} was declared twice", name};
+		}
+
+		auto const mark {m_NameScratch.size()};
+		SkipNewLines();
+		Expect(TokenType::LeftCurlyBrace, "{ to start the members of the enum");
+		for (;;)
+		{
+			SkipNewLines();
+			if (Match(TokenType::RightCurlyBrace))
+			{
+				break; // The trailing comma is allowed.
+			}
+
+			auto const member {ExpectName("the name of an enum member")};
+			if (std::ranges::find(m_NameScratch.begin() + mark, m_NameScratch.end(), member)
+				!= m_NameScratch.end())
+			{
+				throw ParseError{"Enum member {}.{} was declared twice", name, member};
+			}
+			m_NameScratch.push_back(member);
+
+			SkipNewLines();
+			if (!Match(TokenType::Comma))
+			{
+				SkipNewLines();
+				Expect(TokenType::RightCurlyBrace, ", or } after an enum member");
+				break;
+			}
+		}
+
+		auto const members {Commit(m_NameScratch, mark)};
+		m_pTree->m_Enums.push_back(
+			m_pTree->m_Arena.Make<Ast::Enum>(SpanFrom(begin), name, members));
+	}
+
+	std::span<Ast::Param const> Parser::ParseParams()
+	{
+		if (!Match(TokenType::LeftPeren))
+		{
+			return {};
+		}
+
+		auto const mark {m_ParamScratch.size()};
+		if (!Check(TokenType::RightPeren))
+		{
+			do
+			{
+				auto const begin {m_Pos};
+				auto const type {ExpectName("the type of a parameter")};
+
+				// Only cmd has arguments, but the parser does not care.
+				std::span<std::string_view const> typeArgs{};
+				if (Match(TokenType::LeftPeren))
+				{
+					auto const nameMark {m_NameScratch.size()};
+					if (!Check(TokenType::RightPeren))
+					{
+						do
+						{
+							m_NameScratch.push_back(ExpectName("a type"));
+						} while (Match(TokenType::Comma));
+					}
+					Expect(TokenType::RightPeren, ") to close the argument types");
+					typeArgs = Commit(m_NameScratch, nameMark);
+				}
+
+				auto const name {ExpectName("the name of a parameter")};
+				m_ParamScratch.push_back({SpanFrom(begin), type, typeArgs, name});
+			} while (Match(TokenType::Comma));
+		}
+		Expect(TokenType::RightPeren, ") to close the parameter list");
+
+		return Commit(m_ParamScratch, mark);
+	}
+
+	std::span<Ast::Stmt const> Parser::ParseBody()
+	{
+		SkipNewLines();
+		Expect(TokenType::LeftCurlyBrace, "{ to start the body of the proc");
+
+		auto const mark {m_StmtScratch.size()};
+		for (SkipNewLines(); !Match(TokenType::RightCurlyBrace); SkipNewLines())
+		{
+			if (IsAtEnd())
+			{
+				throw ParseError{"Missing }} at the end of the body of the proc"};
+			}
+
+			m_StmtScratch.push_back(ParseStatement());
+			ExpectEndOfStatement();
+		}
+
+		return Commit(m_StmtScratch, mark);
+	}
+
+	Ast::Stmt Parser::ParseStatement()
+	{
+		using enum TokenType;
+		auto const begin {m_Pos};
+		if (Match(Colon))
+		{
+			auto const label {ExpectName("the name of the label")};
+			return {Ast::StmtType::Label, SpanFrom(begin), label, {}};
+		}
+
+		auto const name {ExpectName("a command")};
+		auto const type {Match(ExclamationMark) ? Ast::StmtType::Invoke : Ast::StmtType::Command};
+
+		auto const mark {m_ArgScratch.size()};
+		if (!Check(NewLine) && !Check(RightCurlyBrace) && !IsAtEnd())
+		{
+			do
+			{
+				m_ArgScratch.push_back(ParseArg());
+			} while (Match(Comma));
+		}
+
+		auto const args {Commit(m_ArgScratch, mark)};
+		return {type, SpanFrom(begin), name, args};
+	}
+
+	Ast::Arg Parser::ParseArg()
+	{
+		using enum TokenType;
+		auto const begin {m_Pos};
+		if (Check(Number))
+		{
+			auto const num {Peek().As<Number>().num};
+			++m_Pos;
+			return {Ast::ArgType::Number, SpanFrom(begin), num};
+		}
+
+		if (Match(DollarSign))
+		{
+			auto const name {ExpectName("the name of a sticker after $")};
+			return {Ast::ArgType::Sticker, SpanFrom(begin), 0, name};
+		}
+
+		auto const name {ExpectName("an argument")};
+		if (Match(Dot))
+		{
+			auto const member {ExpectName("the name of an enum member after .")};
+			return {Ast::ArgType::EnumMember, SpanFrom(begin), 0, name, member};
+		}
+
+		return {Ast::ArgType::Name, SpanFrom(begin), 0, name};
+	}
+
+	Token const& Parser::Peek() const
+	{
+		static Token const s_End{TokenType::None};
+		return IsAtEnd() ? s_End : m_pTree->m_Tokens[m_Pos];
+	}
+
+	bool Parser::IsAtEnd() const
+	{
+		return m_Pos >= m_pTree->m_Tokens.size();
+	}
+
+	bool Parser::Check(TokenType type) const
+	{
+		return !IsAtEnd() && m_pTree->m_Tokens[m_Pos].GetType() == type;
+	}
+
+	bool Parser::Match(TokenType type)
+	{
+		if (Check(type))
+		{
+			++m_Pos;
+			return true;
+		}
+		return false;
+	}
+
+	Token const& Parser::Expect(TokenType type, std::string_view what)
+	{
+		if (!Check(type))
+		{
+			auto const& found {Peek()};
+			throw ParseError{"Expected {} but found {} (token #{})", what, found, m_Pos};
+		}
+		return m_pTree->m_Tokens[m_Pos++];
+	}
+
+	std::string_view Parser::ExpectName(std::string_view what)
+	{
+		return Expect(TokenType::Name, what).As<TokenType::Name>().glyph;
+	}
+
+	void Parser::ExpectEndOfStatement()
+	{
+		// The closing brace ends the statement too, so the last one does not need its own line.
+		if (!Match(TokenType::NewLine) && !Check(TokenType::RightCurlyBrace) && !IsAtEnd())
+		{
+			auto const& found {Peek()};
+			throw ParseError{"Expected the end of the line but found {} (token #{})", found, m_Pos};
+		}
+	}
+
+	void Parser::SkipNewLines()
+	{
+		while (Match(TokenType::NewLine));
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Ast.hpp"
+#include "Tokenizer.hpp"
+
+namespace ArRobot {
+	/// Recursive-descent parser for ArRobot source code. Nodes are placed straight into the
+	/// arena of the tree being built; lists are gathered in scratch vectors that are reused
+	/// between nodes, then copied into the arena once their size is known.
+	class Parser
+	{
+	public:
+		Parser() = default;
+
+		SyntaxTree Parse(std::string_view code);
+		SyntaxTree Parse(std::vector<Token> tokens);
+
+	private:
+		void ParseDeclaration();
+		void ParseProc(std::uint32_t begin);
+		void ParseSticker(std::uint32_t begin);
+		void ParseEnum(std::uint32_t begin);
+		std::span<Ast::Param const> ParseParams();
+		std::span<Ast::Stmt const> ParseBody();
+		Ast::Stmt ParseStatement();
+		Ast::Arg ParseArg();
+
+		Token const& Peek() const;
+		bool IsAtEnd() const;
+		bool Check(TokenType type) const;
+		bool Match(TokenType type);
+		Token const& Expect(TokenType type, std::string_view what);
+		std::string_view ExpectName(std::string_view what);
+		void ExpectEndOfStatement();
+		void SkipNewLines();
+
+		constexpr TokenSpan SpanFrom(std::uint32_t begin) const
+		{
+			return {begin, m_Pos};
+		}
+
+		template <class T>
+		std::span<T const> Commit(std::vector<T>& scratch, std::size_t mark)
+		{
+			auto const res {m_pTree->m_Arena.Copy(std::span<T const>{scratch}.subspan(mark))};
+			scratch.resize(mark);
+			return res;
+		}
+
+	private:
+		SyntaxTree* m_pTree{};
+		std::uint32_t m_Pos{};
+		Tokenizer m_Tokenizer{};
+
+		std::vector<Ast::Arg> m_ArgScratch{};
+		std::vector<Ast::Stmt> m_StmtScratch{};
+		std::vector<Ast::Param> m_ParamScratch{};
+		std::vector<std::string_view> m_NameScratch{};
+		std::vector<std::int32_t> m_NumScratch{};
+	};
+}
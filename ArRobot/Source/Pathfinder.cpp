@@ -0,0 +1,294 @@
+#include "pch.hpp"
+#include "Pathfinder.hpp"
+
+namespace ArRobot {
+	DistanceField::DistanceField(Arge::Grid<BlockType> const& grid, BlockType target)
+		: m_Grid{grid}, m_Target{target}, m_Distances{grid.GetWidth(), grid.GetHeight()},
+		m_IsAffected(m_Distances.GetSize())
+	{
+		std::ranges::fill(m_Distances, gc_Unreachable);
+		std::vector<std::pair<std::uint32_t, std::size_t>> queue{};
+		for (std::size_t cell{}; cell < m_Distances.GetSize(); ++cell)
+		{
+			if (IsSource(cell))
+			{
+				m_Distances.AtIndex(cell) = 0;
+				queue.push_back({0, cell});
+			}
+		}
+		Relax(queue);
+	}
+
+	std::optional<std::pair<std::int32_t, std::int32_t>> DistanceField::StepFrom(std::int32_t x, std::int32_t y) const
+	{
+		auto const here {At(x, y)};
+		// Right next to a Wall that is being looked for is as close as it gets.
+		if (here == 0 || (here == 1 && !Pathfinder::IsPassable(m_Target)))
+		{
+			return std::pair {0, 0};
+		}
+		if (here == gc_Unreachable)
+		{
+			return std::nullopt;
+		}
+
+		// Straight steps first, so robots don't zig-zag when they don't have to.
+		static constexpr std::array<std::pair<std::int32_t, std::int32_t>, 8> Steps {{
+			{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1},
+		}};
+		for (auto const [dx, dy] : Steps)
+		{
+			auto const nx {x + dx};
+			auto const ny {y + dy};
+			if (m_Grid.IsInBoundsSigned(nx, ny) && At(nx, ny) < here &&
+				Pathfinder::IsPassable(m_Grid.At(static_cast<std::size_t>(nx), static_cast<std::size_t>(ny))))
+			{
+				return std::pair {dx, dy};
+			}
+		}
+
+		AROBOT_UNREACHABLE_CODE();
+	}
+
+	void DistanceField::Repair(std::int32_t x, std::int32_t y, BlockType oldBlock)
+	{
+		auto const changed {static_cast<std::size_t>(x) + static_cast<std::size_t>(y) * m_Grid.GetWidth()};
+		auto const newBlock {m_Grid.AtIndex(changed)};
+		auto const bSourceChanged {(oldBlock == m_Target) != (newBlock == m_Target)};
+		if (!bSourceChanged && Pathfinder::IsPassable(oldBlock) == Pathfinder::IsPassable(newBlock))
+		{
+			return;
+		}
+
+		// Whatever got its distance through the changed cell may be further away now. Those
+		// are forgotten, and their neighbours that still know better fill them back in.
+		auto& affected {m_Affected};
+		affected.assign(1, changed);
+		m_IsAffected[changed] = true;
+		for (std::size_t i{}; i < affected.size(); ++i)
+		{
+			auto const distance {m_Distances.AtIndex(affected[i])};
+			if (distance == gc_Unreachable)
+			{
+				continue;
+			}
+
+			ForEachNeighbour(affected[i], [&](std::size_t next) {
+				if (!m_IsAffected[next] && m_Distances.AtIndex(next) == distance + 1)
+				{
+					m_IsAffected[next] = true;
+					affected.push_back(next);
+				}
+			});
+		}
+
+		auto& queue {m_Queue};
+		queue.clear();
+		for (auto const cell : affected)
+		{
+			m_Distances.AtIndex(cell) = gc_Unreachable;
+		}
+		for (auto const cell : affected)
+		{
+			if (IsSource(cell))
+			{
+				m_Distances.AtIndex(cell) = 0;
+				queue.push_back({0, cell});
+				continue;
+			}
+
+			ForEachNeighbour(cell, [&](std::size_t next) {
+				if (auto const distance {m_Distances.AtIndex(next)}; !m_IsAffected[next] && distance != gc_Unreachable)
+				{
+					queue.push_back({distance, next});
+				}
+			});
+		}
+
+		// Only what this repair touched, so the next one starts out clean without going over
+		// the whole grid.
+		for (auto const cell : affected)
+		{
+			m_IsAffected[cell] = false;
+		}
+		Relax(queue);
+	}
+
+	void DistanceField::Relax(std::vector<std::pair<std::uint32_t, std::size_t>>& queue)
+	{
+		// Every step costs the same, so this is a BFS that may start at different distances.
+		std::ranges::make_heap(queue, std::greater{});
+		while (!queue.empty())
+		{
+			std::ranges::pop_heap(queue, std::greater{});
+			auto const [distance, cell] {queue.back()};
+			queue.pop_back();
+			if (distance != m_Distances.AtIndex(cell))
+			{
+				continue; // Something shorter got here first.
+			}
+
+			// Walls only hand out distances when they are the target, to the cells next to them.
+			if (!IsPassable(cell) && !IsSource(cell))
+			{
+				continue;
+			}
+
+			ForEachNeighbour(cell, [&](std::size_t next) {
+				if (IsPassable(next) && distance + 1 < m_Distances.AtIndex(next))
+				{
+					m_Distances.AtIndex(next) = distance + 1;
+					queue.push_back({distance + 1, next});
+					std::ranges::push_heap(queue, std::greater{});
+				}
+			});
+		}
+	}
+
+	bool DistanceField::IsSource(std::size_t cell) const
+	{
+		return m_Grid.AtIndex(cell) == m_Target;
+	}
+
+	bool DistanceField::IsPassable(std::size_t cell) const
+	{
+		return Pathfinder::IsPassable(m_Grid.AtIndex(cell));
+	}
+
+	Pathfinder::Pathfinder(Arge::Grid<BlockType> const& grid) : m_Grid{grid}
+	{
+	}
+
+	std::vector<std::pair<std::int32_t, std::int32_t>> Pathfinder::FindPath(
+		std::pair<std::int32_t, std::int32_t> from, std::pair<std::int32_t, std::int32_t> to)
+	{
+		auto const width {m_Grid.GetWidth()};
+		auto const isOpen {[this](std::int32_t x, std::int32_t y) {
+			return m_Grid.IsInBoundsSigned(x, y) &&
+				IsPassable(m_Grid.At(static_cast<std::size_t>(x), static_cast<std::size_t>(y)));
+		}};
+		if (!isOpen(from.first, from.second) || !isOpen(to.first, to.second))
+		{
+			return {};
+		}
+
+		if (m_Stamps.size() != m_Grid.GetSize())
+		{
+			m_Costs.assign(m_Grid.GetSize(), 0);
+			m_Parents.assign(m_Grid.GetSize(), 0);
+			m_Stamps.assign(m_Grid.GetSize(), 0);
+			m_Search = 0;
+		}
+		++m_Search;
+
+		auto const cellOf {[width](std::int32_t x, std::int32_t y) {
+			return static_cast<std::size_t>(x) + static_cast<std::size_t>(y) * width;
+		}};
+		// Diagonals cost one too, so the further of the two axes is exactly how far it is
+		// without walls.
+		auto const estimate {[to](std::int32_t x, std::int32_t y) {
+			return static_cast<std::uint32_t>(std::max(std::abs(to.first - x), std::abs(to.second - y)));
+		}};
+
+		// (cost so far + estimate, cell)
+		std::vector<std::pair<std::uint32_t, std::size_t>> open{};
+		auto const start {cellOf(from.first, from.second)};
+		auto const goal {cellOf(to.first, to.second)};
+		m_Stamps[start] = m_Search;
+		m_Costs[start] = 0;
+		m_Parents[start] = start;
+		open.push_back({estimate(from.first, from.second), start});
+
+		while (!open.empty())
+		{
+			std::ranges::pop_heap(open, std::greater{});
+			auto const [score, cell] {open.back()};
+			open.pop_back();
+
+			auto const x {static_cast<std::int32_t>(cell % width)};
+			auto const y {static_cast<std::int32_t>(cell / width)};
+			if (score != m_Costs[cell] + estimate(x, y))
+			{
+				continue; // Found a cheaper way here since.
+			}
+
+			if (cell == goal)
+			{
+				std::vector<std::pair<std::int32_t, std::int32_t>> res{};
+				for (auto curr {goal}; ; curr = m_Parents[curr])
+				{
+					res.push_back({static_cast<std::int32_t>(curr % width), static_cast<std::int32_t>(curr / width)});
+					if (curr == start)
+					{
+						break;
+					}
+				}
+				std::ranges::reverse(res);
+				return res;
+			}
+
+			for (std::int32_t dy {-1}; dy <= 1; ++dy)
+			{
+				for (std::int32_t dx {-1}; dx <= 1; ++dx)
+				{
+					if ((dx == 0 && dy == 0) || !isOpen(x + dx, y + dy))
+					{
+						continue;
+					}
+
+					auto const next {cellOf(x + dx, y + dy)};
+					auto const cost {m_Costs[cell] + 1};
+					if (m_Stamps[next] != m_Search || cost < m_Costs[next])
+					{
+						m_Stamps[next] = m_Search;
+						m_Costs[next] = cost;
+						m_Parents[next] = cell;
+						open.push_back({cost + estimate(x + dx, y + dy), next});
+						std::ranges::push_heap(open, std::greater{});
+					}
+				}
+			}
+		}
+		return {};
+	}
+
+	DistanceField const& Pathfinder::GetField(BlockType target)
+	{
+		auto const index {static_cast<std::size_t>(target)};
+		if (index >= m_Fields.size())
+		{
+			throw GenericError{"{} is never in a grid, so there is no way to it", target};
+		}
+
+		if (!m_Fields[index])
+		{
+			m_Fields[index] = std::make_unique<DistanceField>(m_Grid, target);
+		}
+		return *m_Fields[index];
+	}
+
+	std::optional<std::pair<std::int32_t, std::int32_t>> Pathfinder::StepToward(
+		BlockType target, std::int32_t x, std::int32_t y)
+	{
+		return GetField(target).StepFrom(x, y);
+	}
+
+	void Pathfinder::OnBlockChanged(std::int32_t x, std::int32_t y, BlockType oldBlock)
+	{
+		for (auto& pField : m_Fields)
+		{
+			if (pField)
+			{
+				pField->Repair(x, y, oldBlock);
+			}
+		}
+	}
+
+	void Pathfinder::ClearCache()
+	{
+		for (auto& pField : m_Fields)
+		{
+			pField.reset();
+		}
+	}
+}
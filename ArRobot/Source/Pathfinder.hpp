@@ -0,0 +1,134 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "ArRobotException.hpp"
+#include "BlockType.hpp"
+
+#include <Arge/Arge.hpp>
+
+namespace ArRobot {
+	/// How far every cell of a grid is from the closest block of one type, walking the way robots
+	/// do: eight ways around, a diagonal step counting as one, never through a Wall or a Pit.
+	/// Walls and Pits can still be what is looked for, in which case standing next to one counts
+	/// as getting there.
+	///
+	/// Built with a BFS from every target at once, and repaired around a cell when it changes
+	/// instead of built all over again.
+	class DistanceField
+	{
+	public:
+		static constexpr std::uint32_t gc_Unreachable{std::numeric_limits<std::uint32_t>::max()};
+
+		DistanceField(Arge::Grid<BlockType> const& grid, BlockType target);
+
+		[[nodiscard]]
+		constexpr std::uint32_t At(std::int32_t x, std::int32_t y) const
+		{
+			return m_Distances.At(static_cast<std::size_t>(x), static_cast<std::size_t>(y));
+		}
+
+		[[nodiscard]]
+		constexpr BlockType GetTarget() const
+		{
+			return m_Target;
+		}
+
+		/// Which way to go from (x, y) to get closer; (0, 0) once there, std::nullopt if there is
+		/// no way there at all.
+		[[nodiscard]]
+		std::optional<std::pair<std::int32_t, std::int32_t>> StepFrom(std::int32_t x, std::int32_t y) const;
+
+		/// The grid already holds the new block, oldBlock is what was there before.
+		void Repair(std::int32_t x, std::int32_t y, BlockType oldBlock);
+
+	private:
+		// Everything that got worse is already gc_Unreachable, and whoever may make it better
+		// again is in the queue.
+		void Relax(std::vector<std::pair<std::uint32_t, std::size_t>>& queue);
+
+		[[nodiscard]]
+		bool IsSource(std::size_t cell) const;
+		[[nodiscard]]
+		bool IsPassable(std::size_t cell) const;
+
+		// Calls doWhat(neighbour) for the (up to eight) cells around cell.
+		template <class Callable>
+		void ForEachNeighbour(std::size_t cell, Callable&& doWhat) const
+		{
+			auto const width {m_Grid.GetWidth()};
+			auto const x {cell % width};
+			auto const y {cell / width};
+			for (std::int32_t dy {-1}; dy <= 1; ++dy)
+			{
+				for (std::int32_t dx {-1}; dx <= 1; ++dx)
+				{
+					auto const nx {static_cast<std::size_t>(static_cast<std::int64_t>(x) + dx)};
+					auto const ny {static_cast<std::size_t>(static_cast<std::int64_t>(y) + dy)};
+					if ((dx != 0 || dy != 0) && m_Grid.IsInBounds(nx, ny))
+					{
+						doWhat(nx + ny * width);
+					}
+				}
+			}
+		}
+
+	private:
+		Arge::Grid<BlockType> const& m_Grid;
+		BlockType m_Target;
+		Arge::Array2D<std::uint32_t> m_Distances;
+
+		// Kept around between repairs, so one costs as much as the cells it touches, not the
+		// whole grid; m_IsAffected is all false outside of Repair.
+		std::vector<bool> m_IsAffected;
+		std::vector<std::size_t> m_Affected{};
+		std::vector<std::pair<std::uint32_t, std::size_t>> m_Queue{};
+	};
+
+	/// Finds the way around a Grid<BlockType>, for robots and for whoever else asks. Distance
+	/// fields are built the first time someone heads for a type of block, and kept up to date
+	/// through OnBlockChanged, so stepping toward the nearest block is a handful of lookups.
+	///
+	/// Jump point search was left out on purpose: robots mostly want "the nearest X", which the
+	/// distance fields already answer, and A* is only there for the odd point to point path.
+	class Pathfinder
+	{
+	public:
+		explicit Pathfinder(Arge::Grid<BlockType> const& grid);
+
+		[[nodiscard]]
+		static constexpr bool IsPassable(BlockType block)
+		{
+			return block != BlockType::Wall && block != BlockType::Pit;
+		}
+
+		/// A*, from and to included; empty if there is no way, or either end is not passable.
+		[[nodiscard]]
+		std::vector<std::pair<std::int32_t, std::int32_t>> FindPath(
+			std::pair<std::int32_t, std::int32_t> from, std::pair<std::int32_t, std::int32_t> to);
+
+		/// Builds the field the first time.
+		DistanceField const& GetField(BlockType target);
+
+		/// See DistanceField::StepFrom; (x, y) has to be in the grid.
+		[[nodiscard]]
+		std::optional<std::pair<std::int32_t, std::int32_t>> StepToward(
+			BlockType target, std::int32_t x, std::int32_t y);
+
+		/// Has to be told about every block that changes after the first field was built, or the
+		/// fields go stale.
+		void OnBlockChanged(std::int32_t x, std::int32_t y, BlockType oldBlock);
+
+		void ClearCache();
+
+	private:
+		Arge::Grid<BlockType> const& m_Grid;
+		// One per kind of block that can be in a grid.
+		std::array<std::unique_ptr<DistanceField>, 4> m_Fields{};
+
+		// Kept around so A* does not have to clear width * height cells every time; a cell only
+		// counts as visited if its stamp is the current search.
+		std::vector<std::uint32_t> m_Costs{};
+		std::vector<std::size_t> m_Parents{};
+		std::vector<std::uint32_t> m_Stamps{};
+		std::uint32_t m_Search{};
+	};
+}
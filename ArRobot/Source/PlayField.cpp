@@ -1,12 +1,69 @@
 #include "pch.hpp"
 #include "PlayField.hpp"
+#include "WorldFile.hpp"
 
 namespace ArRobot {
+	PlayField::PlayField(WorldFile const& world)
+		: m_Grid{world.GetGrid().GetWidth(), world.GetGrid().GetHeight(), world.GetCellWidth(), world.GetCellHeight()}
+	{
+		m_Grid.AssignWords(world.GetGrid().GetWords());
+		for (auto const& spawn : world.GetSpawns())
+		{
+			AddRobot(spawn.x, spawn.y).LoadProgram(world.GetProgram(spawn.program), world.GetMemorySize(spawn.program));
+		}
+	}
+
+	Robot& PlayField::AddRobot(std::int32_t x, std::int32_t y)
+	{
+		Robot robot{m_Grid, x, y};
+		robot.SetOccupancy(&m_Occupancy, static_cast<OccupancyIndex::RobotId>(m_Robots.size()));
+		robot.SetPathfinder(&m_Pathfinder);
+		robot.SetRng(m_Rng.Split(m_Robots.size()));
+		if (m_pTraceSink)
+		{
+			robot.SetTraceBuffer(m_pTraceSink->OpenBuffer(std::format("Robot {}", m_Robots.size())));
+		}
+		return m_Robots.emplace_back(std::move(robot));
+	}
+
+	void PlayField::SetBlock(std::int32_t x, std::int32_t y, BlockType block)
+	{
+		auto const cellX {static_cast<std::size_t>(x)};
+		auto const cellY {static_cast<std::size_t>(y)};
+		BlockType const oldBlock {m_Grid.At(cellX, cellY)};
+		m_Grid.At(cellX, cellY) = block;
+		m_Pathfinder.OnBlockChanged(x, y, oldBlock);
+	}
+
+	void PlayField::Seed(Random::Stream const& rng)
+	{
+		m_Rng = rng;
+		for (std::size_t i{}; i < m_Robots.size(); ++i)
+		{
+			m_Robots[i].SetRng(m_Rng.Split(i));
+		}
+	}
+
 	void PlayField::AddCommand(Command const& newCommand)
 	{
 		ForEachRobot([&newCommand](auto& r) { r.AddCommand(newCommand); });
 	}
 
+	void PlayField::LoadProgram(std::span<Instruction const> program, std::size_t memorySize)
+	{
+		ForEachRobot([program, memorySize](auto& r) { r.LoadProgram(program, memorySize); });
+	}
+
+	void PlayField::SetTraceSink(TraceSink& sink)
+	{
+		for (std::size_t i{}; i < m_Robots.size(); ++i)
+		{
+			m_Robots[i].SetTraceBuffer(sink.OpenBuffer(std::format("Robot {}", i)));
+		}
+		m_pTickTrace = sink.OpenBuffer("PlayField");
+		m_pTraceSink = &sink;
+	}
+
 	void PlayField::Update(float dt)
 	{
 		if (m_TickAcc < m_TickMilliseconds)
@@ -17,10 +74,25 @@ namespace ArRobot {
 		else while (m_TickAcc > m_TickMilliseconds) 
 			// This loop is necessary because of potential lag spikes.
 		{
-			std::cout << "TICK\n";
 			m_TickAcc -= m_TickMilliseconds;
-			ForEachRobot([](auto& r) { r.Tick(); });
+			Tick();
+		}
+	}
+
+	void PlayField::Tick()
+	{
+		++m_TickCount;
+		if (m_pTickTrace)
+		{
+			m_pTickTrace->TryPush({TraceKind::Tick, {}, static_cast<std::int64_t>(m_TickCount)});
 		}
+		ForEachRobot([this](auto& r) {
+			// Faulted robots just stand there from now on, so this only prints once.
+			if (!r.IsFaulted() && r.Tick() != FaultCode::None && m_bPrintFaults)
+			{
+				std::cout << r.GetFault().FormatMessage() << '\n';
+			}
+		});
 	}
 
 	void PlayField::Draw(Arge::Renderer& gfx, Arge::Camera const& camera)
@@ -32,20 +104,21 @@ namespace ArRobot {
 	void PlayField::DrawGrid(Arge::Renderer& gfx, Arge::Camera const& camera)
 	{
 		auto const cellSize{m_Grid.GetCellWidth()};
+		auto const screenSize{cellSize * camera.GetScale()};
+		// A column at a time through the camera, instead of a call to Trans (and the window) per cell.
+		std::vector<Arge::Vec2> corners(m_Grid.GetHeight());
 		for (size_t i{}; i < m_Grid.GetWidth(); ++i)
 		{
 			for (size_t j{}; j < m_Grid.GetHeight(); ++j)
 			{
-				camera.FillRect(gfx,
-					Arge::Vec2{static_cast<float>(i), static_cast<float>(j)} * cellSize,
-					cellSize, cellSize,
-					GetBlockColor(m_Grid.At(i, j))
-				);
+				corners[j] = Arge::Vec2{static_cast<float>(i), static_cast<float>(j)} * cellSize;
+			}
+			camera.TransformPoints(corners, corners);
 
-				camera.DrawRect(gfx,
-					Arge::Vec2{static_cast<float>(i), static_cast<float>(j)} * cellSize,
-					cellSize, cellSize, 0, 2.0f
-				);
+			for (size_t j{}; j < m_Grid.GetHeight(); ++j)
+			{
+				gfx.FillRect(corners[j], screenSize, screenSize, GetBlockColor(m_Grid.At(i, j)));
+				gfx.DrawRect(corners[j], screenSize, screenSize, 0, 2.0f);
 			}
 		}
 	}
@@ -59,6 +132,7 @@ namespace ArRobot {
 		case Item:    return Arge::Colors::Pink;
 		case Wall:    return Arge::Colors::White;
 		case Pit:     return Arge::Colors::Red;
+		case Robot:   break;
 		}
 
 		throw GenericError{"Invalid BlockType: {}", static_cast<std::int32_t>(block)};
@@ -2,20 +2,43 @@
 #include "ArRobotCore.hpp"
 #include "Robot.hpp"
 #include "BlockType.hpp"
+#include "TraceSink.hpp"
+#include "OccupancyIndex.hpp"
+#include "Pathfinder.hpp"
 
 #include <Arge/Arge.hpp>
 
 namespace ArRobot {
+	class WorldFile;
+
 	class PlayField
 	{
 	public:
-		PlayField()
+		PlayField() : PlayField{20, 20}
+		{
+		}
+
+		/// Starts out without robots; wherever they go depends on what ends up in the grid.
+		PlayField(std::size_t width, std::size_t height) : m_Grid{width, height, 50.0f, 50.0f}
 		{
-			m_Robots.emplace_back(m_Grid);
 		}
 
+		/// The grid is copied in one go, since robots change it; the programs are not, so the
+		/// world has to outlive the field. One robot per spawn, and no others.
+		explicit PlayField(WorldFile const& world);
+
+		/// Robots are never on top of each other, so this throws if the cell is taken. The id the
+		/// robot gets in the OccupancyIndex is its index.
+		Robot& AddRobot(std::int32_t x, std::int32_t y);
 		void AddCommand(Command const& newCommand);
+		void LoadProgram(std::span<Instruction const> program, 
+			std::size_t memorySize = Cmd::gc_DefaultMemorySize);
+		/// Every robot gets a buffer of its own in the sink, and the ticks go in one more. Robots
+		/// added later get theirs when they are added.
+		void SetTraceSink(TraceSink& sink);
 		void Update(float dt);
+		/// Ticks every robot once, no matter how much time went by.
+		void Tick();
 		void Draw(Arge::Renderer& gfx, Arge::Camera const& camera);
 		void DrawGrid(Arge::Renderer& gfx, Arge::Camera const& camera);
 		Arge::Color GetBlockColor(BlockType block) const;
@@ -46,6 +69,27 @@ namespace ArRobot {
 			return m_Robots[index];
 		}
 
+		constexpr std::size_t GetRobotCount() const
+		{
+			return m_Robots.size();
+		}
+
+		/// Whether every robot halted or faulted, so ticking any further changes nothing.
+		constexpr bool IsDone() const
+		{
+			return std::ranges::all_of(m_Robots, [](Robot const& r) { return r.IsHalted() || r.IsFaulted(); });
+		}
+
+		constexpr bool IsFaultPrintingEnabled() const
+		{
+			return m_bPrintFaults;
+		}
+
+		constexpr void ToggleFaultPrinting(bool newValue)
+		{
+			m_bPrintFaults = newValue;
+		}
+
 		template <std::invocable<Robot&> Callable>
 		constexpr void ForEachRobot(Callable const& doWhat)
 		{
@@ -55,16 +99,55 @@ namespace ArRobot {
 			}
 		}
 
-		constexpr Arge::Grid<BlockType>& GetGrid()
+		/// Blocks are changed through SetBlock, so the Pathfinder hears about it.
+		constexpr Arge::Grid<BlockType> const& GetGrid() const
 		{
 			return m_Grid;
 		}
 
+		void SetBlock(std::int32_t x, std::int32_t y, BlockType block);
+
+		/// For changing lots of blocks at once (see MapGenerator.hpp); instead of being repaired
+		/// block by block, the distance fields are built again the next time they are needed.
+		template <std::invocable<Arge::Grid<BlockType>&> Callable>
+		void EditGrid(Callable&& edit)
+		{
+			std::forward<Callable>(edit)(m_Grid);
+			m_Pathfinder.ClearCache();
+		}
+
+		/// Robot i gets rng.Split(i), robots added later too; the field keeps rng for itself.
+		void Seed(Random::Stream const& rng);
+
+		[[nodiscard]]
+		constexpr Random::Stream& GetRng()
+		{
+			return m_Rng;
+		}
+
+		constexpr Pathfinder& GetPathfinder()
+		{
+			return m_Pathfinder;
+		}
+
+		constexpr OccupancyIndex const& GetOccupancy() const
+		{
+			return m_Occupancy;
+		}
+
 	private:
 		std::chrono::duration<float, std::milli> m_TickAcc{};
 		std::chrono::duration<float, std::milli> m_TickMilliseconds{1000.0f};
 
+		TraceSink* m_pTraceSink{};
+		std::shared_ptr<TraceBuffer> m_pTickTrace{};
+		std::uint64_t m_TickCount{};
+		bool m_bPrintFaults{true};
+		Random::Stream m_Rng{0};
+
 		std::vector<Robot> m_Robots{};
-		Arge::Grid<BlockType> m_Grid{20, 20, 50.0f, 50.0f};
+		Arge::Grid<BlockType> m_Grid;
+		OccupancyIndex m_Occupancy{m_Grid.GetWidth(), m_Grid.GetHeight()};
+		Pathfinder m_Pathfinder{m_Grid};
 	};
 }
\ No newline at end of file
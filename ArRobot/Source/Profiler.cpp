@@ -0,0 +1,131 @@
+#include "pch.hpp"
+#include "Profiler.hpp"
+
+namespace ArRobot {
+	void Profiler::Reset(std::size_t programSize)
+	{
+		m_ExecutionCounts.assign(programSize, 0);
+		m_BranchCounts.assign(programSize, {});
+		m_TypeTotals.fill(0);
+	}
+
+	std::uint64_t Profiler::GetTotal() const
+	{
+		return std::accumulate(m_TypeTotals.begin(), m_TypeTotals.end(), std::uint64_t{});
+	}
+
+	std::string Profiler::ToText(std::span<Instruction const> program, std::size_t maxHotInstructions) const
+	{
+		AROBOT_DA(program.size() == m_ExecutionCounts.size(), "Profiled a different program");
+
+		auto const total {GetTotal()};
+		std::string res {std::format("Ran {} instructions\n", total)};
+
+		res += "By type:\n";
+		for (std::size_t i{}; i < m_TypeTotals.size(); ++i)
+		{
+			if (auto const count {m_TypeTotals[i]}; count > 0)
+			{
+				auto const type {static_cast<CommandType>(i)};
+				auto const percent {Percent(count, total)};
+				std::format_to(std::back_inserter(res), "  {:<16}{:>10} ({:.1f}%)\n", type, count, percent);
+			}
+		}
+
+		std::vector<std::size_t> hottest(program.size());
+		std::iota(hottest.begin(), hottest.end(), std::size_t{});
+		std::ranges::stable_sort(hottest, std::greater{}, [this](std::size_t i) { return m_ExecutionCounts[i]; });
+
+		res += "Hottest instructions:\n";
+		for (auto const i : hottest | std::views::take(maxHotInstructions))
+		{
+			if (auto const count {m_ExecutionCounts[i]}; count > 0)
+			{
+				auto const percent {Percent(count, total)};
+				auto const desc {Describe(program[i])};
+				std::format_to(std::back_inserter(res), "  #{:<6}{:>10} ({:.1f}%) {}\n", i, count, percent, desc);
+			}
+		}
+
+		res += "Branches:\n";
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			if (auto const& [taken, notTaken] {m_BranchCounts[i]}; taken + notTaken > 0)
+			{
+				auto const percent {Percent(taken, taken + notTaken)};
+				std::format_to(std::back_inserter(res), "  #{:<6}taken {}, not taken {} ({:.1f}% taken)\n",
+					i, taken, notTaken, percent);
+			}
+		}
+		return res;
+	}
+
+	std::string Profiler::ToJson(std::span<Instruction const> program) const
+	{
+		AROBOT_DA(program.size() == m_ExecutionCounts.size(), "Profiled a different program");
+
+		auto const total {GetTotal()};
+		std::string res {std::format("{{\n  \"total\": {},\n  \"types\": {{", total)};
+		auto separator {""};
+		for (std::size_t i{}; i < m_TypeTotals.size(); ++i)
+		{
+			if (auto const count {m_TypeTotals[i]}; count > 0)
+			{
+				auto const type {static_cast<CommandType>(i)};
+				std::format_to(std::back_inserter(res), "{}\n    \"{}\": {}", separator, type, count);
+				separator = ",";
+			}
+		}
+
+		res += "\n  },\n  \"instructions\": [";
+		separator = "";
+		for (std::size_t i{}; i < program.size(); ++i)
+		{
+			auto const type {program[i].type};
+			auto const count {m_ExecutionCounts[i]};
+			std::format_to(std::back_inserter(res), "{}\n    {{ \"index\": {}, \"type\": \"{}\", \"count\": {}",
+				separator, i, type, count);
+
+			if (auto const& [taken, notTaken] {m_BranchCounts[i]}; program[i].IsBranch())
+			{
+				std::format_to(std::back_inserter(res), ", \"taken\": {}, \"notTaken\": {}", taken, notTaken);
+			}
+			res += " }";
+			separator = ",";
+		}
+		res += "\n  ]\n}\n";
+		return res;
+	}
+
+	void Profiler::Export(std::filesystem::path const& path, std::span<Instruction const> program) const
+	{
+		std::ofstream file{path};
+		if (!file)
+		{
+			auto const pathStr {path.string()};
+			throw GenericError{"Could not open {} to export the profile", pathStr};
+		}
+		file << (path.extension() == ".json" ? ToJson(program) : ToText(program));
+	}
+
+	std::string Profiler::Describe(Instruction const& inst)
+	{
+		// Some instructions print nothing, and the rest end with a new line.
+		auto res {inst.ToString()};
+		if (res.empty())
+		{
+			return std::string{Cmd::ToString(inst.type)};
+		}
+
+		if (res.ends_with('\n'))
+		{
+			res.pop_back();
+		}
+		return res;
+	}
+
+	double Profiler::Percent(std::uint64_t part, std::uint64_t total)
+	{
+		return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	/// Counts what a robot runs: how many times each instruction ran, how often each jump was
+	/// taken, and how many instructions of each type ran. Everything is allocated up front by
+	/// Reset, so recording is only bumping a counter or two.
+	class Profiler
+	{
+	public:
+		struct BranchCounts
+		{
+			std::uint64_t taken;
+			std::uint64_t notTaken;
+		};
+
+	public:
+		/// Forgets everything, and makes room for a program this big.
+		void Reset(std::size_t programSize);
+
+		void RecordExecution(std::size_t instIndex, CommandType type)
+		{
+			++m_ExecutionCounts[instIndex];
+			++m_TypeTotals[static_cast<std::size_t>(type)];
+		}
+
+		void RecordBranch(std::size_t instIndex, bool bTaken)
+		{
+			auto& counts {m_BranchCounts[instIndex]};
+			++(bTaken ? counts.taken : counts.notTaken);
+		}
+
+		/// How many times each instruction ran, good for Fuser::FromProfile.
+		[[nodiscard]]
+		constexpr std::span<std::uint64_t const> GetExecutionCounts() const
+		{
+			return m_ExecutionCounts;
+		}
+
+		/// Only the jumps have anything in here.
+		[[nodiscard]]
+		constexpr std::span<BranchCounts const> GetBranchCounts() const
+		{
+			return m_BranchCounts;
+		}
+
+		[[nodiscard]]
+		constexpr std::uint64_t GetTypeTotal(CommandType type) const
+		{
+			return m_TypeTotals[static_cast<std::size_t>(type)];
+		}
+
+		[[nodiscard]]
+		std::uint64_t GetTotal() const;
+
+		/// The program has to be the one that was profiled. Only lists the hottest few 
+		/// instructions, hottest first.
+		[[nodiscard]]
+		std::string ToText(std::span<Instruction const> program, std::size_t maxHotInstructions = 10) const;
+		[[nodiscard]]
+		std::string ToJson(std::span<Instruction const> program) const;
+
+		/// JSON if the file ends with .json, text otherwise.
+		void Export(std::filesystem::path const& path, std::span<Instruction const> program) const;
+
+	private:
+		static std::string Describe(Instruction const& inst);
+		static double Percent(std::uint64_t part, std::uint64_t total);
+
+	private:
+		std::vector<std::uint64_t> m_ExecutionCounts{};
+		std::vector<BranchCounts> m_BranchCounts{};
+		std::array<std::uint64_t, Cmd::gc_CommandTypeCount> m_TypeTotals{};
+	};
+}
@@ -1,5 +1,9 @@
 #include "pch.hpp"
 #include "Robot.hpp"
+#include "Assembler.hpp"
+#include "Optimizer.hpp"
+#include "ControlFlowGraph.hpp"
+#include "MemoryVerifier.hpp"
 
 namespace ArRobot {
 	Robot::Robot(Arge::Grid<BlockType>& parentGrid) : Robot{parentGrid, 0, 0} {};
@@ -15,42 +19,151 @@ namespace ArRobot {
 
 	void Robot::AddCommand(Command const& newCommand)
 	{
-		if (newCommand.GetType() == CommandType::MarkLabel)
+		m_Commands.push_back(newCommand);
+		m_LoadedProgram = {};
+		m_bCommandsChanged = true;
+	}
+
+	void Robot::LoadProgram(std::span<Instruction const> program, std::size_t memorySize)
+	{
+		// Throws if anything is off, so Tick never has to check.
+		ControlFlowGraph const cfg{program};
+		MemoryVerifier{memorySize}.Verify(program);
+		m_GlobalMemory.assign(memorySize, 0);
+		m_Commands.clear();
+		m_AssembledProgram.clear();
+		m_bCommandsChanged = false;
+		m_LoadedProgram = program;
+		// Nothing of the old program carries over, not even how long it still had to wait.
+		m_CommandPtr = 0;
+		m_Cooldown = 0;
+		m_Fault = {};
+		FuseProgram();
+	}
+
+	void Robot::SetMemorySize(std::size_t newSize)
+	{
+		// Commands that were not assembled yet get verified when they are.
+		MemoryVerifier{newSize}.Verify(m_bCommandsChanged ? std::span<Instruction const>{} : GetUnfusedProgram());
+		m_GlobalMemory.assign(newSize, 0);
+	}
+
+	void Robot::SetPosition(std::int32_t x, std::int32_t y)
+	{
+		// Placing first, so nothing changes if it throws.
+		if (m_pOccupancy && (x != m_X || y != m_Y))
 		{
-			m_LabelMap.try_emplace(newCommand.As<CommandType::MarkLabel>().label, m_Commands.size());
+			m_pOccupancy->Place(m_Id, x, y);
+			m_pOccupancy->Remove(m_X, m_Y);
 		}
-		else
+		m_X = x;
+		m_Y = y;
+	}
+
+	void Robot::SetOccupancy(OccupancyIndex* pIndex, OccupancyIndex::RobotId id)
+	{
+		if (m_pOccupancy)
+		{
+			m_pOccupancy->Remove(m_X, m_Y);
+		}
+
+		if (pIndex)
+		{
+			pIndex->Place(id, m_X, m_Y);
+		}
+		m_pOccupancy = pIndex;
+		m_Id = id;
+	}
+
+	void Robot::AssembleCommands()
+	{
+		// Commands can be made without going through the parser, so they get checked the same
+		// way loaded programs do.
+		auto program {Asm::Assemble(m_Commands)};
+		ControlFlowGraph const cfg{program};
+		if (m_bOptimizing)
+		{
+			program = Optimizer{true}.Optimize(program);
+		}
+		MemoryVerifier{MemorySize()}.Verify(program);
+		m_AssembledProgram = std::move(program);
+		m_bCommandsChanged = false;
+		FuseProgram();
+	}
+
+	void Robot::SetFuser(std::optional<Fuser> fuser)
+	{
+		m_Fuser = std::move(fuser);
+		FuseProgram();
+	}
+
+	void Robot::FuseProgram()
+	{
+		// Fusing never moves anything, so the PC stays good.
+		m_FusedProgram.clear();
+		if (auto const program {GetUnfusedProgram()}; m_Fuser && !program.empty())
 		{
-			m_Commands.push_back(newCommand);
+			m_FusedProgram = m_Fuser->Fuse(program);
 		}
+		m_Profiler.Reset(GetProgram().size());
 	}
 
-	void Robot::Tick()
+	FaultCode Robot::Tick()
 	{
+		if (m_Fault.IsFaulted())
+		{
+			return m_Fault.code;
+		}
+
 		if constexpr (false && m_Cooldown > 0)
 		{
 			m_Cooldown -= 1;
 		}
 		else
 		{
-			if (m_CommandPtr >= m_Commands.size())
+			if (m_bCommandsChanged)
 			{
-				AddCommand(Command::MakeHalt());
-				m_CommandPtr = m_Commands.size() - 1;
+				AssembleCommands();
 			}
 
-			auto const& currCommand{m_Commands[m_CommandPtr]};
-			auto const type{currCommand.GetType()};
-			Execute(currCommand);
+			// Everything the robot runs went through a ControlFlowGraph, so every jump lands
+			// somewhere and the program never runs off the end.
+			auto const program{GetProgram()};
+			auto const& currInst{program[m_CommandPtr]};
+			if (m_bProfiling)
+			{
+				// A superinstruction counts as the instructions it stands for, so the profile
+				// looks the same as an unfused robot's, and can go back into Fuser::FromProfile.
+				auto const unfused{GetUnfusedProgram()};
+				for (auto i {m_CommandPtr}; i < m_CommandPtr + currInst.GetWidth(); ++i)
+				{
+					m_Profiler.RecordExecution(i, unfused[i].type);
+				}
+			}
+			Execute(currInst);
 
-			using enum CommandType;
-			if (type != Halt && 
-				type != Jump && type != JumpTrue && type != JumpFalse)
+			// Stays on the instruction that faulted.
+			if (m_Fault.IsFaulted())
+			{
+				return m_Fault.code;
+			}
+
+			if (currInst.type != CommandType::Halt && !currInst.IsBranch())
 			{
-				m_CommandPtr += 1;
+				m_CommandPtr += currInst.GetWidth();
 			}
 			
-			m_Cooldown = m_Commands[m_CommandPtr].GetTickCount();
+			m_Cooldown = program[m_CommandPtr].ticks;
+		}
+		return FaultCode::None;
+	}
+
+	void Robot::ThrowIfFaulted() const
+	{
+		if (m_Fault.IsFaulted())
+		{
+			auto const message {m_Fault.FormatMessage()};
+			throw GenericError{"{}", message};
 		}
 	}
 
@@ -83,17 +196,16 @@ namespace ArRobot {
 			camera.DrawCircle(gfx, center, radius, Arge::Colors::Black, Padding * 0.5f);
 		}
 
-		if (bDebugVisuals)
+		if (auto const program{GetProgram()}; bDebugVisuals && m_CommandPtr < program.size())
 		{
 			// Can't extract it out because it depends on a lot of variables in the current scope.
 			using enum CommandType;
-			switch (auto const& currCommand{m_Commands[m_CommandPtr]}; currCommand.GetType())
+			switch (auto const& currInst{program[m_CommandPtr]}; currInst.type)
 			{
 			case Move:
 			{
-				auto const& data{currCommand.As<Move>()};
 				Arge::Vec2 const centerOffset{cellWidth * 0.5f, cellWidth * 0.5f};
-				auto const screenDelta{m_ParentGrid.GridToScreen(data.x, data.y)};
+				auto const screenDelta{m_ParentGrid.GridToScreen(currInst.a, currInst.b)};
 				auto const targetPos{screenPos + screenDelta + centerOffset};
 				camera.DrawLine(gfx, screenPos + centerOffset, targetPos, Arge::Colors::DarkGreen,
 					0.5f * scaledPadding);
@@ -102,10 +214,11 @@ namespace ArRobot {
 				break;
 			}
 			case CheckDir:
+			case CheckJumpTrue:
+			case CheckJumpFalse:
 			{
-				auto const& data{currCommand.As<CheckDir>()};
 				Arge::Vec2 const centerOffset{cellWidth * 0.5f, cellWidth * 0.5f};
-				auto const screenDelta{m_ParentGrid.GridToScreen(data.x, data.y)};
+				auto const screenDelta{m_ParentGrid.GridToScreen(currInst.a, currInst.b)};
 				auto const targetPos{screenPos + screenDelta + centerOffset};
 				camera.DrawCircle(
 					gfx, targetPos, cellWidth * 0.3f, Arge::Colors::PaleVioletRed, 0.5f * scaledPadding);
@@ -117,152 +230,266 @@ namespace ArRobot {
 		}
 	}
 
-	void Robot::Execute(Command const& cmd)
+	void Robot::Execute(Instruction const& inst)
 	{
+		// Jumps move the PC, the trace still wants to know where this one was.
+		auto const index{m_CommandPtr};
+
 		// None of the branches is allowed to return early!!! There is code under the 
 		// switch that needs to be executed for all commands.
-		switch (cmd.GetType()) 
+		switch (inst.type) 
 		{ 
 			using enum CommandType;
 		case DoNothing: 
 			/* Sleep a little. */ 
 			break;
 		case Move:      
-			HandleMove(cmd); 
+			HandleMove(inst); 
 			break;
 		case PickUp:
 			if (m_bItem)
-				throw GenericError{"Already holding something"};
+				Raise(FaultCode::AlreadyHolding);
 			m_bItem = true;
 			break;
 		case Drop:
 			if (!m_bItem)
-				throw GenericError{"Dropping nothing"};
+				Raise(FaultCode::DroppingNothing);
 			m_bItem = false;
 			break;
+		case StepToward:
+			HandleStepToward(inst);
+			break;
 		case CheckDir:  
-			HandleCheckDir(cmd); 
+			HandleCheckDir(inst); 
 			break;
-		case MarkLabel: 
-			throw GenericError{"MarkLabel may not be executed"};
 		case Jump:      
-			HandleJump(true, cmd.As<Jump>().label); 
+			HandleJump(true, inst.a); 
 			break;
 		case JumpTrue:  
-			HandleJump(m_GlobalMemory.back() != 0, cmd.As<JumpTrue>().label); 
+			HandleJump(m_GlobalMemory[Cmd::gc_FlagAddress] != 0, inst.a); 
 			break;
 		case JumpFalse: 
-			HandleJump(m_GlobalMemory.back() == 0, cmd.As<JumpFalse>().label); 
+			HandleJump(m_GlobalMemory[Cmd::gc_FlagAddress] == 0, inst.a); 
 			break;
 		case Halt:      
 			/* Stop. */ 
 			break;
 		case MemSet:    
-		{
-			auto const& [addr, value] {cmd.As<MemSet>()};
-			m_GlobalMemory[addr] = value; 
+			// The MemoryVerifier already made sure every address is in bounds.
+			m_GlobalMemory[inst.a] = inst.b; 
 			break;
-		}
 		case MemCopy:   
-		{
-			auto const& [to, from] {cmd.As<MemCopy>()};
-			m_GlobalMemory[to] = m_GlobalMemory[from];
+			m_GlobalMemory[inst.a] = m_GlobalMemory[inst.b];
 			break;
-		}
-		case BinaryOp: HandleBinaryOp(cmd); break;
+		case BinaryOp: HandleBinaryOp(inst); break;
 		case MemPrint:
-		{
-			auto const& [addr] {cmd.As<MemPrint>()};
-			std::cout << std::format("mem[{}] = {}\n", addr, m_GlobalMemory[addr]);
+			HandleMemPrint(inst);
 			break;
-		}
 		case MemPrintAll: 
 			HandleMemPrintAll(); 
 			break;
+		case CheckJumpTrue:
+		case CheckJumpFalse:
+			HandleCheckDir(inst);
+			HandleFusedJump(inst);
+			break;
+		case OpJumpTrue:
+		case OpJumpFalse:
+			HandleBinaryOp(inst);
+			HandleFusedJump(inst);
+			break;
+		case MemSetRun:
+			HandleMemSetRun(inst);
+			break;
 		default: 
-			throw GenericError{"Executing invalid Command: {}", cmd};
+			// MarkLabel included, the ControlFlowGraph already keeps these out of programs.
+			Raise(FaultCode::InvalidInstruction, static_cast<std::int64_t>(inst.type));
+			break;
 		}
 
 		if (bDebugPrint)
 		{
-			std::cout << cmd;
+			// Superinstructions show up as what they stand for, like on an unfused robot.
+			auto const run{inst.GetWidth() > 1 ?
+				GetUnfusedProgram().subspan(index, inst.GetWidth()) : std::span{&inst, 1}};
+			for (auto const& ranInst : run)
+			{
+				if (m_pTrace)
+				{
+					m_pTrace->TryPush({TraceKind::Executed, ranInst});
+				}
+				else
+				{
+					std::cout << ranInst;
+				}
+			}
 		}
 	}
 
-	void Robot::HandleMove(Command const& cmd)
+	void Robot::Raise(FaultCode code, std::int64_t lhs, std::int64_t rhs)
 	{
-		auto const& [x, y] {cmd.As<CommandType::Move>()};
-		m_X += x;
-		m_Y += y;
+		// Only the first one counts, the rest are likely caused by it.
+		if (!m_Fault.IsFaulted())
+		{
+			m_Fault = {code, m_CommandPtr, {lhs, rhs}};
+		}
+	}
+
+	void Robot::HandleMove(Instruction const& inst)
+	{
+		// The robot bumps into the edge and stays in the grid, even if it faults. The Optimizer 
+		// only fuses Moves in a straight line, so a fused one that runs into the edge stops where 
+		// the Moves it replaced would have.
+		auto const newX{m_X + inst.a};
+		auto const newY{m_Y + inst.b};
+		auto const gridWidth{m_ParentGrid.GetWidth()};
+		auto const gridHeight{m_ParentGrid.GetHeight()};
+
+		if (newX < 0 || gridWidth <= newX)
+		{
+			Raise(FaultCode::OutOfGridX, newX, static_cast<std::int64_t>(gridWidth));
+		}
+		else if (newY < 0 || gridHeight <= newY)
+		{
+			Raise(FaultCode::OutOfGridY, newY, static_cast<std::int64_t>(gridHeight));
+		}
 
-		if (auto const gridWidth{m_ParentGrid.GetWidth()}; m_X < 0 || gridWidth <= m_X)
+		auto const clampedX{std::clamp(newX, 0, static_cast<std::int32_t>(gridWidth) - 1)};
+		auto const clampedY{std::clamp(newY, 0, static_cast<std::int32_t>(gridHeight) - 1)};
+		if (m_pOccupancy && !m_pOccupancy->TryMove(m_X, m_Y, clampedX, clampedY))
 		{
-			throw GenericError{"Moved out of the grid! (x is {} but width is {})", m_X, gridWidth};
+			Raise(FaultCode::BumpedIntoRobot, *m_pOccupancy->RobotAt(clampedX, clampedY));
+			return;
 		}
 
-		// No else if, because I don't want gridWidth to be in scope.
-		if (auto const gridHeight{m_ParentGrid.GetHeight()};  m_Y < 0 || gridHeight <= m_Y)
+		m_X = clampedX;
+		m_Y = clampedY;
+	}
+
+	void Robot::HandleStepToward(Instruction const& inst)
+	{
+		auto const step {m_pPathfinder ?
+			m_pPathfinder->StepToward(static_cast<BlockType>(inst.a), m_X, m_Y) : std::nullopt};
+		auto const bMoving {step && *step != std::pair {0, 0}};
+		m_GlobalMemory[Cmd::gc_FlagAddress] = bMoving;
+		if (!bMoving)
 		{
-			throw GenericError{"Moved out of the grid! (y is {} but height is {})", m_Y, gridHeight};
+			return;
 		}
+
+		// Someone else is in the way; they are likely going somewhere too, so wait for them
+		// instead of bumping into them.
+		auto const newX {m_X + step->first};
+		auto const newY {m_Y + step->second};
+		if (m_pOccupancy && !m_pOccupancy->TryMove(m_X, m_Y, newX, newY))
+		{
+			return;
+		}
+
+		m_X = newX;
+		m_Y = newY;
 	}
 
-	void Robot::HandleCheckDir(Command const& cmd)
+	void Robot::HandleCheckDir(Instruction const& inst)
 	{
-		auto const& [x, y, block] {cmd.As<CommandType::CheckDir>()};
-		auto const targetX{m_X + x};
-		auto const targetY{m_Y + y};
+		auto const targetX{m_X + inst.a};
+		auto const targetY{m_Y + inst.b};
+		if (static_cast<BlockType>(inst.c) == BlockType::Robot)
+		{
+			// Someone else, the robot does not count itself when checking its own cell.
+			auto const optId {m_pOccupancy ? m_pOccupancy->RobotAt(targetX, targetY) : std::nullopt};
+			m_GlobalMemory[Cmd::gc_FlagAddress] = optId && *optId != m_Id;
+			return;
+		}
+
 		auto const adjacentBlock = m_ParentGrid.IsInBounds(targetX, targetY) ?
 			m_ParentGrid.At(targetX, targetY) : BlockType::Wall;
-		m_GlobalMemory.back() = (adjacentBlock == block);
+		m_GlobalMemory[Cmd::gc_FlagAddress] = (adjacentBlock == static_cast<BlockType>(inst.c));
 	}
 
-	void Robot::HandleBinaryOp(Command const& cmd)
+	void Robot::HandleBinaryOp(Instruction const& inst)
 	{
-		auto const& [opCode, lhs, rhs] {cmd.As<CommandType::BinaryOp>()};
-		m_GlobalMemory[lhs] = OpCodeEnum::Eval(opCode, m_GlobalMemory[lhs], m_GlobalMemory[rhs]);
+		auto& lhs{m_GlobalMemory[inst.b]};
+		lhs = OpCodeEnum::Eval(static_cast<OpCode>(inst.a), lhs, m_GlobalMemory[inst.c]);
 	}
 
-	void Robot::HandleMemPrintAll() const 
+	void Robot::HandleMemPrint(Instruction const& inst) const
 	{
-		// Top line
-		std::cout << std::string(m_GlobalMemory.size() * 4 + 1, '-') << "\n|";
-
-		// Memory indices...
-		for (std::size_t i{}; i < m_GlobalMemory.size(); ++i)
+		if (m_pTrace)
+		{
+			m_pTrace->TryPush({TraceKind::MemValue, inst, inst.a, m_GlobalMemory[inst.a]});
+		}
+		else
 		{
-			std::cout << std::format("{:^3}|", i);
+			std::cout << std::format("mem[{}] = {}\n", inst.a, m_GlobalMemory[inst.a]);
 		}
+	}
 
-		// Middle line
-		std::cout << '\n' << std::string(m_GlobalMemory.size() * 4 + 1, '-') << "\n|";
+	void Robot::HandleMemPrintAll() const 
+	{
+		if (!m_pTrace)
+		{
+			std::cout << TraceSink::FormatMemory(m_GlobalMemory);
+			return;
+		}
 
-		// Memory values...
-		for (auto const mem : m_GlobalMemory)
+		auto const size {static_cast<std::int64_t>(m_GlobalMemory.size())};
+		if (m_GlobalMemory.size() + 1 > m_pTrace->GetCapacity())
 		{
-			std::cout << std::format("{:<3}|", mem);
+			// Would be dropped every single time, so it says so instead.
+			m_pTrace->TryPush({TraceKind::MemTooBig, {}, size, static_cast<std::int64_t>(m_pTrace->GetCapacity())});
+			return;
 		}
 
-		// Bottom line
-		std::cout << '\n' << std::string(m_GlobalMemory.size() * 4 + 1, '-') << "\n";
+		// All in one go, so the sink never sees half of it.
+		m_pTrace->TryPushGenerated(m_GlobalMemory.size() + 1, [this, size](std::size_t i) {
+			return i == 0 ? TraceRecord{TraceKind::MemDump, {}, size} : 
+				TraceRecord{TraceKind::MemValue, {}, static_cast<std::int64_t>(i - 1), m_GlobalMemory[i - 1]};
+		});
 	}
 
-	void Robot::HandleJump(bool cond, std::string_view label)
+	void Robot::HandleJump(bool cond, std::int32_t target)
 	{
+		if (m_bProfiling)
+		{
+			m_Profiler.RecordBranch(m_CommandPtr, cond);
+		}
+
+		// The assembler made sure the target exists.
 		if (cond)
 		{
-			if (auto const it{m_LabelMap.find(label)}; it != m_LabelMap.end())
-			{
-				m_CommandPtr = it->second;
-			}
-			else
-			{
-				throw GenericError{"Jumping to non-existant label: {}", label};
-			}
+			m_CommandPtr = static_cast<std::size_t>(target);
 		}
 		else
 		{
 			m_CommandPtr += 1;
 		}
 	}
+
+	void Robot::HandleFusedJump(Instruction const& inst)
+	{
+		// The jump is still right after the superinstruction, and its branch is counted there,
+		// where an unfused robot counts it.
+		auto const jumpIndex{m_CommandPtr + 1};
+		auto const& jump{GetProgram()[jumpIndex]};
+		auto const bFlag{m_GlobalMemory[Cmd::gc_FlagAddress] != 0};
+		auto const bOnTrue{inst.type == CommandType::CheckJumpTrue || inst.type == CommandType::OpJumpTrue};
+		auto const bTaken{bFlag == bOnTrue};
+		if (m_bProfiling)
+		{
+			m_Profiler.RecordBranch(jumpIndex, bTaken);
+		}
+		m_CommandPtr = bTaken ? static_cast<std::size_t>(jump.a) : jumpIndex + 1;
+	}
+
+	void Robot::HandleMemSetRun(Instruction const& inst)
+	{
+		// The MemSets keep their operands, even the ones that got fused themselves.
+		auto const program{GetProgram()};
+		for (std::size_t i{}; i < inst.GetWidth(); ++i)
+		{
+			auto const& memSet{program[m_CommandPtr + i]};
+			m_GlobalMemory[memSet.a] = memSet.b;
+		}
+	}
 }
@@ -1,6 +1,14 @@
 #pragma once 
 #include "ArRobotCore.hpp"
 #include "Command.hpp"
+#include "Instruction.hpp"
+#include "Fuser.hpp"
+#include "Profiler.hpp"
+#include "TraceSink.hpp"
+#include "Fault.hpp"
+#include "OccupancyIndex.hpp"
+#include "Pathfinder.hpp"
+#include "Util/Random.hpp"
 #include "ArRobotException.hpp"
 #include "BlockType.hpp"
 
@@ -9,42 +17,149 @@
 namespace ArRobot {
 	class Robot
 	{
-	private:
-		struct MyStringHasher
-		{
-			using is_transparent = void;
-			auto operator()(std::string_view str) const 
-			{
-				return std::hash<std::string_view>{}(str);
-			}
-		};
-
 	public:
 		explicit Robot(Arge::Grid<BlockType>& parentGrid);
 		explicit Robot(Arge::Grid<BlockType>& parentGrid, std::int32_t x, std::int32_t y);
 
 	private:
-		void Execute(Command const& cmd);
-		void HandleCall(Command const& cmd);
+		void Execute(Instruction const& inst);
+		void HandleCall(Instruction const& inst);
 		void HandleReturn();
-		void HandleMove(Command const& cmd);
-		void HandleCheckDir(Command const& cmd);
-		void HandleBinaryOp(Command const& cmd);
+		void Raise(FaultCode code, std::int64_t lhs = 0, std::int64_t rhs = 0);
+		void HandleMove(Instruction const& inst);
+		void HandleStepToward(Instruction const& inst);
+		void HandleCheckDir(Instruction const& inst);
+		void HandleBinaryOp(Instruction const& inst);
+		void HandleMemPrint(Instruction const& inst) const;
 		void HandleMemPrintAll() const;
-		void HandleJump(bool cond, std::string_view label);
+		void HandleJump(bool cond, std::int32_t target);
+		void HandleFusedJump(Instruction const& inst);
+		void HandleMemSetRun(Instruction const& inst);
+		void AssembleCommands();
+		void FuseProgram();
 
 	public:
+		// The commands are assembled the next time the robot ticks, so jumps may come before 
+		// the labels they jump to.
 		void AddCommand(Command const& newCommand);
-		void Tick();
+		// Runs an already assembled program (see Assembler.hpp) without copying it, so it must 
+		// outlive the robot; replaces any commands added before, and wipes the memory.
+		void LoadProgram(std::span<Instruction const> program, 
+			std::size_t memorySize = Cmd::gc_DefaultMemorySize);
+		// Also wipes the memory.
+		void SetMemorySize(std::size_t newSize);
+		// Superinstructions are off until given a Fuser (see Fuser.hpp); std::nullopt turns 
+		// them back off.
+		void SetFuser(std::optional<Fuser> fuser);
+		/// Runs the next instruction, unless the robot faulted before; a faulted robot stays
+		/// where it is until it gets a new program. Never throws because of what the program 
+		/// does, only because of programs that do not assemble.
+		FaultCode Tick();
+		/// For the ones that would rather have an exception.
+		void ThrowIfFaulted() const;
+
+		/// What was loaded or added, before any Fuser got to it.
+		[[nodiscard]]
+		constexpr std::span<Instruction const> GetUnfusedProgram() const
+		{
+			return m_LoadedProgram.empty() ? std::span<Instruction const>{m_AssembledProgram} : m_LoadedProgram;
+		}
+
+		/// What the robot is actually running, superinstructions included.
+		[[nodiscard]]
+		constexpr std::span<Instruction const> GetProgram() const
+		{
+			return m_FusedProgram.empty() ? GetUnfusedProgram() : m_FusedProgram;
+		}
+
+		/// Which instruction of GetProgram() runs next.
+		[[nodiscard]]
+		constexpr std::size_t GetCommandPtr() const
+		{
+			return m_CommandPtr;
+		}
+
+		/// Everything the robot ran since profiling was turned on, or since the program last 
+		/// changed. Superinstructions count as what they fused, so the program it profiled is
+		/// GetUnfusedProgram().
+		[[nodiscard]]
+		constexpr Profiler const& GetProfiler() const
+		{
+			return m_Profiler;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsProfilingEnabled() const
+		{
+			return m_bProfiling;
+		}
+
+		constexpr void ToggleProfiling(bool newValue)
+		{
+			m_bProfiling = newValue;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsOptimizingEnabled() const
+		{
+			return m_bOptimizing;
+		}
+
+		/// Commands from AddCommand go through the strict Optimizer (see Optimizer.hpp) once this
+		/// is on. The timing stays the same, but writes the program never reads again are gone,
+		/// and Deref can tell. Loaded programs are run as they are either way.
+		constexpr void ToggleOptimizing(bool newValue)
+		{
+			m_bOptimizing = newValue;
+			m_bCommandsChanged = m_bCommandsChanged || m_LoadedProgram.empty();
+		}
+
+		/// Moves the robot in the OccupancyIndex too, if it is in one, so this throws if someone
+		/// is already there.
+		void SetPosition(std::int32_t x, std::int32_t y);
+		/// Robots in an OccupancyIndex bump into each other, and can Check for each other. The
+		/// robot takes its current cell right away; nullptr takes it out again.
+		void SetOccupancy(OccupancyIndex* pIndex, OccupancyIndex::RobotId id);
+		/// StepToward asks this one the way; without one there never is a way. Has to be made for
+		/// the robot's own grid.
+		constexpr void SetPathfinder(Pathfinder* pPathfinder)
+		{
+			m_pPathfinder = pPathfinder;
+		}
 
-		constexpr void SetPosition(std::int32_t x, std::int32_t y)
+		/// Whatever the robot draws comes from here, so it only depends on the seed it was given.
+		[[nodiscard]]
+		constexpr Random::Stream& GetRng()
 		{
-			m_X = x; 
-			m_Y = y;
+			return m_Rng;
+		}
+
+		constexpr void SetRng(Random::Stream const& rng)
+		{
+			m_Rng = rng;
 		}
 
 		void Draw(Arge::Renderer& renny, Arge::Camera const& camera) const;
 
+		[[nodiscard]]
+		constexpr bool IsHalted() const
+		{
+			auto const program{GetProgram()};
+			return !program.empty() && program[m_CommandPtr].type == CommandType::Halt;
+		}
+
+		[[nodiscard]]
+		constexpr bool IsFaulted() const
+		{
+			return m_Fault.IsFaulted();
+		}
+
+		[[nodiscard]]
+		constexpr Fault const& GetFault() const
+		{
+			return m_Fault;
+		}
+
 		[[nodiscard]]
 		constexpr bool IsCarryingItem() const
 		{
@@ -80,6 +195,13 @@ namespace ArRobot {
 			bDebugPrint = newValue;
 		}
 
+		/// Debug printing and the MemPrint commands go here instead of std::cout (see 
+		/// TraceSink.hpp); nullptr goes back to std::cout.
+		void SetTraceBuffer(std::shared_ptr<TraceBuffer> pBuffer)
+		{
+			m_pTrace = std::move(pBuffer);
+		}
+
 		[[nodiscard]]
 		constexpr bool IsDebugVisualsEnabled() const
 		{
@@ -93,20 +215,30 @@ namespace ArRobot {
 
 	private:
 		Arge::Grid<BlockType>& m_ParentGrid;
+		OccupancyIndex* m_pOccupancy{};
+		OccupancyIndex::RobotId m_Id{};
+		Pathfinder* m_pPathfinder{};
+		Random::Stream m_Rng{0};
 
-		// Switching the hasher and the equal_to operator will give you a cryptic error message,
-		// and will not be caught by intellisense.
-		std::unordered_map<
-			std::string, std::size_t, MyStringHasher, std::equal_to<>
-		> m_LabelMap{};
 		std::vector<Command> m_Commands{};
+		std::vector<Instruction> m_AssembledProgram{};
+		std::span<Instruction const> m_LoadedProgram{};
+		std::optional<Fuser> m_Fuser{};
+		std::vector<Instruction> m_FusedProgram{};
+		Profiler m_Profiler{};
+		bool m_bProfiling{};
+		bool m_bOptimizing{};
+		// Even without commands, the robot assembles a lonely Halt to run.
+		bool m_bCommandsChanged{true};
 		std::size_t m_CommandPtr{};
+		Fault m_Fault{};
 		std::size_t m_Cooldown{};
 		bool bDebugPrint{};
+		std::shared_ptr<TraceBuffer> m_pTrace{};
 		bool bDebugVisuals{};
 
 		// Brace initialization does not work here.
-		std::vector<std::int32_t> m_GlobalMemory = std::vector<std::int32_t>(16);
+		std::vector<std::int32_t> m_GlobalMemory = std::vector<std::int32_t>(Cmd::gc_DefaultMemorySize);
 
 		std::int32_t m_X{};
 		std::int32_t m_Y{};
@@ -0,0 +1,100 @@
+#include "pch.hpp"
+#include "SimulationHost.hpp"
+
+namespace ArRobot {
+	SimulationHost::SimulationHost(std::size_t threadCount, std::uint64_t seed) : m_Root{seed}
+	{
+		if (threadCount == 0)
+		{
+			throw GenericError{"A SimulationHost needs at least one thread"};
+		}
+
+		m_Workers.reserve(threadCount);
+		for (std::size_t i{}; i < threadCount; ++i)
+		{
+			m_Workers.emplace_back([this, i](std::stop_token stopToken) { Work(i, stopToken); });
+		}
+	}
+
+	std::size_t SimulationHost::DefaultThreadCount()
+	{
+		// Zero when it cannot tell.
+		return std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	PlayField& SimulationHost::AddField()
+	{
+		auto& field {*m_Fields.emplace_back(std::make_unique<PlayField>())};
+		field.ToggleFaultPrinting(false);
+		field.Seed(m_Root.Split(m_Fields.size() - 1));
+		m_Stats.emplace_back();
+		return field;
+	}
+
+	void SimulationHost::Run(std::uint64_t ticks)
+	{
+		auto const begin {std::chrono::steady_clock::now()};
+		{
+			std::unique_lock lock{m_Mutex};
+			m_TicksToRun = ticks;
+			m_BusyCount = m_Workers.size();
+			m_RunFieldTicks = 0;
+			++m_Generation;
+			m_Wake.notify_all();
+			m_Done.wait(lock, [this] { return m_BusyCount == 0; });
+			m_FieldTicks += m_RunFieldTicks;
+		}
+		m_RunTime += std::chrono::steady_clock::now() - begin;
+	}
+
+	void SimulationHost::Work(std::size_t worker, std::stop_token stopToken)
+	{
+		std::uint64_t seenGeneration{};
+		while (true)
+		{
+			std::uint64_t ticks{};
+			{
+				std::unique_lock lock{m_Mutex};
+				if (!m_Wake.wait(lock, stopToken, [&] { return m_Generation != seenGeneration; }))
+				{
+					return; // Stopped.
+				}
+				seenGeneration = m_Generation;
+				ticks = m_TicksToRun;
+			}
+
+			std::uint64_t fieldTicks{};
+			for (auto i {worker}; i < m_Fields.size(); i += m_Workers.size())
+			{
+				fieldTicks += RunField(i, ticks);
+			}
+
+			std::scoped_lock lock{m_Mutex};
+			m_RunFieldTicks += fieldTicks;
+			if (--m_BusyCount == 0)
+			{
+				m_Done.notify_one();
+			}
+		}
+	}
+
+	std::uint64_t SimulationHost::RunField(std::size_t index, std::uint64_t ticks)
+	{
+		auto& field {*m_Fields[index]};
+		std::uint64_t ran{};
+		for (; ran < ticks && !field.IsDone(); ++ran)
+		{
+			field.Tick();
+		}
+
+		auto& stats {m_Stats[index]};
+		stats.ticks += ran;
+		stats.haltedCount = 0;
+		stats.faultedCount = 0;
+		field.ForEachRobot([&stats](Robot const& r) {
+			stats.haltedCount += r.IsHalted();
+			stats.faultedCount += r.IsFaulted();
+		});
+		return ran;
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "PlayField.hpp"
+
+namespace ArRobot {
+	/// Runs a bunch of independent PlayFields without a window, spread over a fixed pool of
+	/// threads. A field always ticks on the same thread (field i on thread i % threadCount), so
+	/// its robots, grid and distance fields stay in that core's cache and nothing needs a lock.
+	class SimulationHost
+	{
+	public:
+		/// How a field did, summed over every Run.
+		struct FieldStats
+		{
+			std::uint64_t ticks{};
+			std::size_t haltedCount{};
+			std::size_t faultedCount{};
+		};
+
+		/// Field i is seeded with Stream{seed}.Split(i), so the same seed gives the same fields
+		/// on any number of threads.
+		explicit SimulationHost(std::size_t threadCount = DefaultThreadCount(), std::uint64_t seed = 0);
+
+		SimulationHost(SimulationHost const&) = delete;
+		SimulationHost& operator=(SimulationHost const&) = delete;
+
+		[[nodiscard]]
+		static std::size_t DefaultThreadCount();
+
+		/// The field keeps its faults to itself, nobody would read them here. Not while running.
+		PlayField& AddField();
+
+		/// Ticks every field up to ticks more times and waits for all of them. Fields stop early
+		/// once every robot in them halted or faulted.
+		void Run(std::uint64_t ticks);
+
+		[[nodiscard]]
+		PlayField& GetField(std::size_t index)
+		{
+			return *m_Fields[index];
+		}
+
+		[[nodiscard]]
+		std::size_t GetFieldCount() const
+		{
+			return m_Fields.size();
+		}
+
+		[[nodiscard]]
+		FieldStats const& GetStats(std::size_t index) const
+		{
+			return m_Stats[index];
+		}
+
+		[[nodiscard]]
+		std::size_t GetThreadCount() const
+		{
+			return m_Workers.size();
+		}
+
+		/// Every tick of every field, over every Run.
+		[[nodiscard]]
+		std::uint64_t GetFieldTicks() const
+		{
+			return m_FieldTicks;
+		}
+
+		/// Wall clock time spent in Run.
+		[[nodiscard]]
+		std::chrono::duration<double> GetRunTime() const
+		{
+			return m_RunTime;
+		}
+
+		[[nodiscard]]
+		double GetFieldTicksPerSecond() const
+		{
+			return m_RunTime.count() > 0.0 ? static_cast<double>(m_FieldTicks) / m_RunTime.count() : 0.0;
+		}
+
+	private:
+		void Work(std::size_t worker, std::stop_token stopToken);
+		// Only ever called by the thread owning the field.
+		std::uint64_t RunField(std::size_t index, std::uint64_t ticks);
+
+	private:
+		std::vector<std::unique_ptr<PlayField>> m_Fields{};
+		std::vector<FieldStats> m_Stats{};
+		Random::Stream m_Root;
+
+		std::uint64_t m_FieldTicks{};
+		std::chrono::duration<double> m_RunTime{};
+
+		// Everything below is guarded by m_Mutex. Workers run again whenever m_Generation goes up,
+		// and the last one to finish wakes up Run.
+		std::mutex m_Mutex{};
+		std::condition_variable_any m_Wake{};
+		std::condition_variable m_Done{};
+		std::uint64_t m_Generation{};
+		std::uint64_t m_TicksToRun{};
+		std::size_t m_BusyCount{};
+		std::uint64_t m_RunFieldTicks{};
+
+		// Last, so they are stopped and joined before anything they use goes.
+		std::vector<std::jthread> m_Workers{};
+	};
+}
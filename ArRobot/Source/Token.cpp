@@ -23,6 +23,8 @@ namespace ArRobot {
 		case Hash:               return "#";
 		case LeftSquareBracket:  return "[";
 		case RightSquareBracket: return "]";
+		case LeftCurlyBrace:     return "{";
+		case RightCurlyBrace:    return "}";
 		case Dot:                return ".";
 		case Comma:              return ",";
 		case ExclamationMark:    return "!";
@@ -30,6 +32,7 @@ namespace ArRobot {
 		case Colon:              return ":";
 		case SemiColon:          return ";";
 		case Star:               return "*";
+		case NewLine:            return "NewLine";
 		default:
 			throw GenericError{"(Invalid or unimplemented Token)"};
 		}
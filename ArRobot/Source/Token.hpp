@@ -15,6 +15,8 @@ namespace ArRobot {
 		Hash,
 		LeftSquareBracket,
 		RightSquareBracket,
+		LeftCurlyBrace,
+		RightCurlyBrace,
 		Dot,
 		Comma,
 		ExclamationMark,
@@ -24,6 +26,9 @@ namespace ArRobot {
 		DoubleQuote,
 		SingleQuote,
 		Star,
+
+		// Statements end at the end of the line, so the parser needs to see them.
+		NewLine,
 	};
 
 	// Impl block for the TokenType enum
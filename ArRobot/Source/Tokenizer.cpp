@@ -8,10 +8,18 @@ namespace ArRobot {
 
 	void Tokenizer::DoIteration()
 	{
-		if (auto const c {m_Code.front()}; std::isspace(c))
+		if (auto const c {m_Code.front()}; c == '\n')
+		{
+			ParseNewLine();
+		}
+		else if (std::isspace(c))
 		{
 			m_Code.remove_prefix(1);
 		}
+		else if (m_Code.starts_with("(*"))
+		{
+			SkipComment();
+		}
 		else if (std::isdigit(c) || c == '-')
 		{
 			ParseNumber();
@@ -59,6 +67,8 @@ namespace ArRobot {
 			case '#':  return Hash;
 			case '[':  return LeftSquareBracket;
 			case ']':  return RightSquareBracket;
+			case '{':  return LeftCurlyBrace;
+			case '}':  return RightCurlyBrace;
 			case '.':  return Dot;
 			case ',':  return Comma;
 			case '!':  return ExclamationMark;
@@ -67,6 +77,7 @@ namespace ArRobot {
 			case ';':  return SemiColon;
 			case '\'': return SingleQuote;
 			case '"':  return DoubleQuote;
+			case '*':  return Star;
 			default:
 				throw ParseError{"Invalid token: {}; remove this token", c};
 			}
@@ -74,6 +85,28 @@ namespace ArRobot {
 		m_Code.remove_prefix(1);
 	}
 
+	void Tokenizer::ParseNewLine()
+	{
+		// Blank lines carry no meaning, so a run of them collapses into a single token.
+		if (!m_Tokens.empty() && m_Tokens.back().GetType() != TokenType::NewLine)
+		{
+			AddToken(TokenType::NewLine);
+		}
+		m_Code.remove_prefix(1);
+	}
+
+	void Tokenizer::SkipComment()
+	{
+		if (auto const end {m_Code.find("*)", 2)}; end != std::string_view::npos)
+		{
+			m_Code.remove_prefix(end + 2);
+		}
+		else
+		{
+			throw ParseError{"Unterminated comment; close it with *)"};
+		}
+	}
+
 	void Tokenizer::ParseNumber()
 	{
 		auto const res {m_NumberParser.Parse(m_Code)};
@@ -16,6 +16,8 @@ namespace ArRobot {
 		void ParseNumber();
 		void ParseName();
 		void ParseOperator();
+		void ParseNewLine();
+		void SkipComment();
 
 		constexpr void SetState(St newState) { m_CurrState = newState; }
 		constexpr St GetCurrState() const    { return m_CurrState; }
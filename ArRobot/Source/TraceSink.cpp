@@ -0,0 +1,167 @@
+#include "pch.hpp"
+#include "TraceSink.hpp"
+
+namespace ArRobot {
+	TraceBuffer::TraceBuffer(std::string name, std::size_t capacity)
+		: m_Name{std::move(name)}, m_Records(std::bit_ceil(std::max(capacity, std::size_t{1}))), 
+		  m_Mask{m_Records.size() - 1}
+	{
+	}
+
+	void TraceBuffer::DrainInto(std::vector<TraceRecord>& out)
+	{
+		auto const tail {m_Tail.load(std::memory_order_relaxed)};
+		auto const head {m_Head.load(std::memory_order_acquire)};
+		for (auto i {tail}; i != head; ++i)
+		{
+			out.push_back(m_Records[i & m_Mask]);
+		}
+		m_Tail.store(head, std::memory_order_release);
+	}
+
+	TraceSink::TraceSink(std::filesystem::path const& logPath, std::chrono::milliseconds interval)
+		: m_File{logPath}, m_Interval{interval}
+	{
+		if (!m_File)
+		{
+			auto const pathStr {logPath.string()};
+			throw GenericError{"Could not open {} for tracing", pathStr};
+		}
+		m_Thread = std::jthread{[this](std::stop_token stopToken) { Run(stopToken); }};
+	}
+
+	TraceSink::~TraceSink()
+	{
+		m_Thread.request_stop();
+		if (m_Thread.joinable())
+		{
+			m_Thread.join();
+		}
+		Flush();
+	}
+
+	std::shared_ptr<TraceBuffer> TraceSink::OpenBuffer(std::string name, std::size_t capacity)
+	{
+		auto pBuffer {std::make_shared<TraceBuffer>(std::move(name), capacity)};
+		std::scoped_lock lock{m_BuffersMutex};
+		m_Buffers.push_back(pBuffer);
+		return pBuffer;
+	}
+
+	void TraceSink::Flush()
+	{
+		DrainAll();
+		std::scoped_lock lock{m_DrainMutex};
+		m_File.flush();
+	}
+
+	std::string TraceSink::FormatMemory(std::span<std::int32_t const> memory)
+	{
+		auto const line {std::string(memory.size() * 4 + 1, '-')};
+
+		// Top line
+		auto res {line + "\n|"};
+
+		// Memory indices...
+		for (std::size_t i{}; i < memory.size(); ++i)
+		{
+			std::format_to(std::back_inserter(res), "{:^3}|", i);
+		}
+
+		// Middle line
+		res += '\n' + line + "\n|";
+
+		// Memory values...
+		for (auto const mem : memory)
+		{
+			std::format_to(std::back_inserter(res), "{:<3}|", mem);
+		}
+
+		// Bottom line
+		res += '\n' + line + '\n';
+		return res;
+	}
+
+	void TraceSink::Run(std::stop_token stopToken)
+	{
+		while (!stopToken.stop_requested())
+		{
+			{
+				std::unique_lock lock{m_WakeMutex};
+				m_Wake.wait_for(lock, stopToken, m_Interval, [] { return false; });
+			}
+			DrainAll();
+		}
+	}
+
+	void TraceSink::DrainAll()
+	{
+		// New buffers may show up while draining, they wait for the next round.
+		std::vector<std::shared_ptr<TraceBuffer>> buffers{};
+		{
+			std::scoped_lock lock{m_BuffersMutex};
+			buffers = m_Buffers;
+		}
+
+		std::scoped_lock lock{m_DrainMutex};
+		m_ReportedDrops.resize(buffers.size());
+		for (std::size_t i{}; i < buffers.size(); ++i)
+		{
+			auto& buffer {*buffers[i]};
+			m_Scratch.clear();
+			buffer.DrainInto(m_Scratch);
+			Format(buffer, m_Scratch);
+
+			if (auto const dropped {buffer.GetDroppedCount()}; dropped != m_ReportedDrops[i])
+			{
+				auto const newlyDropped {dropped - m_ReportedDrops[i]};
+				std::format_to(std::back_inserter(m_Text), "[{}] dropped {} records\n", buffer.GetName(), newlyDropped);
+				m_ReportedDrops[i] = dropped;
+			}
+		}
+
+		m_File << m_Text;
+		m_Text.clear();
+	}
+
+	void TraceSink::Format(TraceBuffer const& buffer, std::span<TraceRecord const> records)
+	{
+		auto const& name {buffer.GetName()};
+		for (std::size_t i{}; i < records.size(); ++i)
+		{
+			switch (auto const& record {records[i]}; record.kind)
+			{
+			case TraceKind::Executed:
+				// Instructions already end with a new line, but some print nothing at all.
+				if (auto const str {record.inst.ToString()}; !str.empty())
+				{
+					std::format_to(std::back_inserter(m_Text), "[{}] {}", name, str);
+				}
+				break;
+			case TraceKind::MemValue:
+				std::format_to(std::back_inserter(m_Text), "[{}] mem[{}] = {}\n", name, record.a, record.b);
+				break;
+			case TraceKind::MemDump:
+			{
+				// Pushed all at once, so the values are all there.
+				auto const count {static_cast<std::size_t>(record.a)};
+				std::vector<std::int32_t> memory(count);
+				for (std::size_t cell{}; cell < count; ++cell)
+				{
+					memory[cell] = static_cast<std::int32_t>(records[i + 1 + cell].b);
+				}
+				std::format_to(std::back_inserter(m_Text), "[{}]\n{}", name, FormatMemory(memory));
+				i += count;
+				break;
+			}
+			case TraceKind::MemTooBig:
+				std::format_to(std::back_inserter(m_Text), "[{}] memory of {} cells does not fit in a buffer of {} records\n", 
+					name, record.a, record.b);
+				break;
+			case TraceKind::Tick:
+				std::format_to(std::back_inserter(m_Text), "[{}] TICK {}\n", name, record.a);
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "Instruction.hpp"
+
+namespace ArRobot {
+	enum class TraceKind : std::uint8_t
+	{
+		/// An instruction ran.
+		Executed,
+		/// a = address, b = value.
+		MemValue,
+		/// The next a records are MemValues, the whole memory of the robot.
+		MemDump,
+		/// A MemDump of a cells that would never fit in the buffer, b = its capacity.
+		MemTooBig,
+		/// a = which tick.
+		Tick,
+	};
+
+	/// Kept raw on purpose, formatting waits for the TraceSink thread.
+	struct TraceRecord
+	{
+		TraceKind kind{};
+		Instruction inst{};
+		std::int64_t a{};
+		std::int64_t b{};
+	};
+
+	/// A fixed size ring of TraceRecords, with one thread pushing (the robot) and one draining
+	/// (the TraceSink). Pushing never blocks or allocates; when the ring is full, records are
+	/// dropped and counted instead.
+	class TraceBuffer
+	{
+	public:
+		/// The capacity gets rounded up to a power of two.
+		TraceBuffer(std::string name, std::size_t capacity);
+
+		bool TryPush(TraceRecord const& record)
+		{
+			return TryPush(std::span{&record, 1});
+		}
+
+		/// Either all of them make it, or none of them do.
+		bool TryPush(std::span<TraceRecord const> records)
+		{
+			return TryPushGenerated(records.size(), [records](std::size_t i) { return records[i]; });
+		}
+
+		/// Like TryPush, but makeRecord(i) makes the i-th record right in the ring, so nothing
+		/// has to be put together anywhere else first.
+		template <class TMake>
+		bool TryPushGenerated(std::size_t count, TMake&& makeRecord)
+		{
+			auto const head {m_Head.load(std::memory_order_relaxed)};
+			auto const tail {m_Tail.load(std::memory_order_acquire)};
+			if (m_Records.size() - (head - tail) < count)
+			{
+				m_DroppedCount.fetch_add(count, std::memory_order_relaxed);
+				return false;
+			}
+
+			for (std::size_t i{}; i < count; ++i)
+			{
+				m_Records[(head + i) & m_Mask] = makeRecord(i);
+			}
+			m_Head.store(head + count, std::memory_order_release);
+			return true;
+		}
+
+		/// Only one thread may drain at a time.
+		void DrainInto(std::vector<TraceRecord>& out);
+
+		[[nodiscard]]
+		std::uint64_t GetDroppedCount() const
+		{
+			return m_DroppedCount.load(std::memory_order_relaxed);
+		}
+
+		[[nodiscard]]
+		constexpr std::string const& GetName() const
+		{
+			return m_Name;
+		}
+
+		[[nodiscard]]
+		constexpr std::size_t GetCapacity() const
+		{
+			return m_Records.size();
+		}
+
+	private:
+		std::string m_Name;
+		std::vector<TraceRecord> m_Records;
+		std::size_t m_Mask;
+
+		// On lines of their own, so the robot and the sink don't fight over them.
+		alignas(64) std::atomic<std::size_t> m_Head{};
+		alignas(64) std::atomic<std::size_t> m_Tail{};
+		alignas(64) std::atomic<std::uint64_t> m_DroppedCount{};
+	};
+
+	/// Drains TraceBuffers on a thread of its own, and formats what is in them into a log file.
+	/// Records of one buffer stay in order, but different buffers get interleaved in chunks.
+	class TraceSink
+	{
+	public:
+		explicit TraceSink(std::filesystem::path const& logPath,
+			std::chrono::milliseconds interval = std::chrono::milliseconds{10});
+		~TraceSink();
+
+		TraceSink(TraceSink const&) = delete;
+		TraceSink& operator=(TraceSink const&) = delete;
+
+		/// The buffer lives for as long as either of the sink and the one pushing to it need it.
+		std::shared_ptr<TraceBuffer> OpenBuffer(std::string name, std::size_t capacity = 4096);
+
+		/// Drains everything right now, and flushes the file.
+		void Flush();
+
+		/// The same table MemPrintAll prints.
+		static std::string FormatMemory(std::span<std::int32_t const> memory);
+
+	private:
+		void Run(std::stop_token stopToken);
+		void DrainAll();
+		void Format(TraceBuffer const& buffer, std::span<TraceRecord const> records);
+
+	private:
+		std::ofstream m_File;
+		std::chrono::milliseconds m_Interval;
+
+		std::mutex m_BuffersMutex{};
+		std::vector<std::shared_ptr<TraceBuffer>> m_Buffers{};
+
+		// Draining and writing the file, from either thread.
+		std::mutex m_DrainMutex{};
+		std::vector<std::uint64_t> m_ReportedDrops{};
+		std::vector<TraceRecord> m_Scratch{};
+		std::string m_Text{};
+
+		std::mutex m_WakeMutex{};
+		std::condition_variable_any m_Wake{};
+		// Last, so it is the first thing to go.
+		std::jthread m_Thread{};
+	};
+}
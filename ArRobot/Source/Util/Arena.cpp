@@ -0,0 +1,57 @@
+#include "pch.hpp"
+#include "Arena.hpp"
+
+namespace ArRobot {
+	Arena::Arena(std::size_t blockSize) : m_BlockSize{blockSize}
+	{
+		AROBOT_DA(blockSize > 0, "An arena with empty blocks can not allocate anything");
+	}
+
+	void* Arena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		AROBOT_DA(std::has_single_bit(alignment), "Alignment {} is not a power of two", alignment);
+
+		for (;;)
+		{
+			auto const address{reinterpret_cast<std::uintptr_t>(m_pCurr)};
+			auto const padding{(alignment - address % alignment) % alignment};
+			if (m_pCurr && static_cast<std::size_t>(m_pEnd - m_pCurr) >= padding + size)
+			{
+				auto* const pRes{m_pCurr + padding};
+				m_pCurr = pRes + size;
+				return pRes;
+			}
+
+			AddBlock(size + alignment);
+		}
+	}
+
+	void Arena::Reset()
+	{
+		m_CurrBlock = 0;
+		m_pCurr = m_Blocks.empty() ? nullptr : m_Blocks.front().pData.get();
+		m_pEnd  = m_Blocks.empty() ? nullptr : m_pCurr + m_Blocks.front().size;
+	}
+
+	void Arena::AddBlock(std::size_t minSize)
+	{
+		// Blocks left over from before the last Reset are reused first.
+		while (!m_Blocks.empty() && m_CurrBlock + 1 < m_Blocks.size())
+		{
+			auto& block{m_Blocks[++m_CurrBlock]};
+			if (block.size >= minSize)
+			{
+				m_pCurr = block.pData.get();
+				m_pEnd  = m_pCurr + block.size;
+				return;
+			}
+		}
+
+		auto const size{std::max(m_BlockSize, minSize)};
+		m_Blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+		m_CurrBlock = m_Blocks.size() - 1;
+		m_pCurr = m_Blocks.back().pData.get();
+		m_pEnd  = m_pCurr + size;
+		m_BytesReserved += size;
+	}
+}
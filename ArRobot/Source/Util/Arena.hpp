@@ -0,0 +1,68 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "../ArRobotException.hpp"
+
+namespace ArRobot {
+	/// Bump allocator; everything allocated from it dies with it, all at once. No destructor
+	/// is ever run, so only trivially destructible types may live in here.
+	class Arena
+	{
+	public:
+		static constexpr std::size_t DefaultBlockSize{64 * 1024};
+
+		explicit Arena(std::size_t blockSize = DefaultBlockSize);
+
+		Arena(Arena const&)                = delete;
+		Arena& operator=(Arena const&)     = delete;
+		Arena(Arena&&) noexcept            = default;
+		Arena& operator=(Arena&&) noexcept = default;
+
+		void* Allocate(std::size_t size, std::size_t alignment);
+
+		template <class T, class... Args> requires std::is_trivially_destructible_v<T>
+		T* Make(Args&&... args)
+		{
+			return ::new (Allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+		}
+
+		// Copies the elements into the arena; the source can be thrown away afterwards.
+		template <class T> requires std::is_trivially_destructible_v<T>
+		std::span<T const> Copy(std::span<T const> elements)
+		{
+			if (elements.empty())
+			{
+				return {};
+			}
+
+			auto* const pDest{static_cast<T*>(Allocate(elements.size_bytes(), alignof(T)))};
+			std::ranges::uninitialized_copy(elements, std::span{pDest, elements.size()});
+			return {pDest, elements.size()};
+		}
+
+		// Keeps the blocks around so the next round of allocations does not hit the heap.
+		void Reset();
+
+		[[nodiscard]]
+		constexpr std::size_t GetBytesReserved() const
+		{
+			return m_BytesReserved;
+		}
+
+	private:
+		void AddBlock(std::size_t minSize);
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> pData;
+			std::size_t size;
+		};
+
+		std::vector<Block> m_Blocks{};
+		std::size_t m_CurrBlock{};
+		std::byte* m_pCurr{};
+		std::byte* m_pEnd{};
+		std::size_t m_BlockSize;
+		std::size_t m_BytesReserved{};
+	};
+}
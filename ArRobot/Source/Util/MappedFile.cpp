@@ -0,0 +1,131 @@
+#include "pch.hpp"
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ArRobot {
+#ifdef _WIN32
+	MappedFile::MappedFile(std::filesystem::path const& path)
+	{
+		auto const pathString {path.string()};
+		auto* const hFile {CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+		if (hFile == INVALID_HANDLE_VALUE)
+		{
+			throw GenericError{"Could not open \"{}\"", pathString};
+		}
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(hFile, &size))
+		{
+			CloseHandle(hFile);
+			throw GenericError{"Could not get the size of \"{}\"", pathString};
+		}
+		if (size.QuadPart == 0)
+		{
+			CloseHandle(hFile);
+			return;
+		}
+
+		// The view keeps the mapping, and the mapping the file, alive; neither handle is needed after.
+		auto* const hMapping {CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+		CloseHandle(hFile);
+		if (!hMapping)
+		{
+			throw GenericError{"Could not map \"{}\"", pathString};
+		}
+		auto const* const pView {MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)};
+		CloseHandle(hMapping);
+		if (!pView)
+		{
+			throw GenericError{"Could not map \"{}\"", pathString};
+		}
+
+		m_pData = static_cast<std::byte const*>(pView);
+		m_Size = static_cast<std::size_t>(size.QuadPart);
+	}
+
+	void MappedFile::Unmap() noexcept
+	{
+		if (m_pData)
+		{
+			UnmapViewOfFile(m_pData);
+		}
+		m_pData = nullptr;
+		m_Size = 0;
+	}
+#else
+	MappedFile::MappedFile(std::filesystem::path const& path)
+	{
+		auto const pathString {path.string()};
+		auto const fd {open(path.c_str(), O_RDONLY)};
+		if (fd < 0)
+		{
+			throw GenericError{"Could not open \"{}\"", pathString};
+		}
+
+		struct stat info{};
+		if (fstat(fd, &info) != 0)
+		{
+			close(fd);
+			throw GenericError{"Could not get the size of \"{}\"", pathString};
+		}
+		if (info.st_size == 0)
+		{
+			close(fd);
+			return;
+		}
+
+		// The mapping keeps the file alive on its own.
+		auto* const pView {mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+		close(fd);
+		if (pView == MAP_FAILED)
+		{
+			throw GenericError{"Could not map \"{}\"", pathString};
+		}
+
+		m_pData = static_cast<std::byte const*>(pView);
+		m_Size = static_cast<std::size_t>(info.st_size);
+	}
+
+	void MappedFile::Unmap() noexcept
+	{
+		if (m_pData)
+		{
+			munmap(const_cast<std::byte*>(m_pData), m_Size);
+		}
+		m_pData = nullptr;
+		m_Size = 0;
+	}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		Unmap();
+	}
+
+	MappedFile::MappedFile(MappedFile&& rhs) noexcept
+		: m_pData{std::exchange(rhs.m_pData, nullptr)}, m_Size{std::exchange(rhs.m_Size, 0)}
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			Unmap();
+			m_pData = std::exchange(rhs.m_pData, nullptr);
+			m_Size = std::exchange(rhs.m_Size, 0);
+		}
+		return *this;
+	}
+}
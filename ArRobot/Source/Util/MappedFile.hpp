@@ -0,0 +1,36 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "../ArRobotException.hpp"
+
+namespace ArRobot {
+	/// A whole file mapped into memory, read-only. The OS only reads a page once something
+	/// touches it, so opening a huge file is as quick as opening a tiny one.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		/// Throws a GenericError if the file can not be opened or mapped.
+		explicit MappedFile(std::filesystem::path const& path);
+		~MappedFile();
+
+		MappedFile(MappedFile const&)            = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+		MappedFile(MappedFile&& rhs) noexcept;
+		MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+		/// Page aligned; empty files are not mapped at all and have no bytes.
+		[[nodiscard]]
+		constexpr std::span<std::byte const> GetBytes() const
+		{
+			return {m_pData, m_Size};
+		}
+
+	private:
+		void Unmap() noexcept;
+
+	private:
+		std::byte const* m_pData{};
+		std::size_t m_Size{};
+	};
+}
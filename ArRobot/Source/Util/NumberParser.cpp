@@ -144,7 +144,8 @@ namespace ArRobot {
 		}
 
 		return {
-			.offset = static_cast<std::size_t>(std::distance(numStr.begin(), it)),
+			// The minus sign was chopped off numStr, but it still counts.
+			.offset = static_cast<std::size_t>(std::distance(numStr.begin(), it)) + bMinus,
 			.num    = static_cast<std::int32_t>(resNum),
 		};
 	}
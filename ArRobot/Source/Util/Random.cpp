@@ -16,6 +16,77 @@ namespace ArRobot::Random {
 	ARCALC_DEFINE_RANDOM_INT_FUNC(Float, float);
 	ARCALC_DEFINE_RANDOM_INT_FUNC(Double, double);
 
+	// Raw numbers are made this many at a time, on the stack.
+	static constexpr std::size_t gc_FillChunk{256};
+
+	void FillInts(Stream& rng, std::span<std::int32_t> out, std::int32_t min, std::int32_t max) {
+		AROBOT_DA(min <= max, "Tried to generate random numbers with the range reversed");
+		auto const range {static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1};
+		// Multiplying by the range maps [0, 2^32) onto [0, range) in the upper half. Whatever
+		// lands in the lower half below threshold would make some results more likely than
+		// others, so it draws again; that is less than range / 2^32 of the time.
+		auto const threshold {static_cast<std::uint32_t>((std::uint64_t{1} << 32) % range)};
+
+		std::array<std::uint32_t, gc_FillChunk> raw{};
+		for (std::size_t i{}; i < out.size(); i += raw.size()) {
+			auto const count {std::min(raw.size(), out.size() - i)};
+			rng.Fill(std::span{raw}.first(count));
+			for (std::size_t j{}; j < count; ++j) {
+				auto product {static_cast<std::uint64_t>(raw[j]) * range};
+				while (static_cast<std::uint32_t>(product) < threshold) {
+					product = static_cast<std::uint64_t>(rng()) * range;
+				}
+				out[i + j] = static_cast<std::int32_t>(min + static_cast<std::int64_t>(product >> 32));
+			}
+		}
+	}
+
+	void FillInts(std::span<std::int32_t> out, std::int32_t min, std::int32_t max) {
+		FillInts(Engine(), out, min, max);
+	}
+
+	void FillFloats(Stream& rng, std::span<float> out, float min, float max) {
+		AROBOT_DA(min <= max, "Tried to generate random numbers with the range reversed");
+		auto const range {max - min};
+		// Rounding can still land on max when min is large next to the range, so anything that
+		// does is pulled back to the last float below it.
+		auto const last {std::nextafter(max, min)};
+		// The range itself may not fit in a float (-FLT_MAX to FLT_MAX), but its halves always do.
+		auto const bHugeRange {!std::isfinite(range)};
+		auto const halfRange {max / 2 - min / 2};
+
+		std::array<std::uint32_t, gc_FillChunk> raw{};
+		for (std::size_t i{}; i < out.size(); i += raw.size()) {
+			auto const count {std::min(raw.size(), out.size() - i)};
+			rng.Fill(std::span{raw}.first(count));
+			for (std::size_t j{}; j < count; ++j) {
+				// A float only has 24 bits to put them in, so t is exactly in [0, 1).
+				auto const t {static_cast<float>(raw[j] >> 8) / static_cast<float>(1 << 24)};
+				auto const value {bHugeRange ? std::fma(t, halfRange, std::fma(t, halfRange, min)) : std::fma(t, range, min)};
+				out[i + j] = std::min(value, last);
+			}
+		}
+	}
+
+	void FillFloats(std::span<float> out, float min, float max) {
+		FillFloats(Engine(), out, min, max);
+	}
+
+	void FillBools(Stream& rng, std::span<bool> out) {
+		// Every number is 32 coin flips.
+		std::array<std::uint32_t, gc_FillChunk> raw{};
+		for (std::size_t i{}; i < out.size(); i += raw.size() * 32) {
+			auto const count {std::min(raw.size() * 32, out.size() - i)};
+			rng.Fill(std::span{raw}.first((count + 31) / 32));
+			for (std::size_t j{}; j < count; ++j) {
+				out[i + j] = (raw[j / 32] >> (j % 32)) & 1;
+			}
+		}
+	}
+
+	void FillBools(std::span<bool> out) {
+		FillBools(Engine(), out);
+	}
 }
 
 #undef ARCALC_DEFINE_RANDOM_INT_FUNC
\ No newline at end of file
@@ -4,12 +4,149 @@
 #include "../ArRobotException.hpp"
 
 namespace ArRobot::Random {
+	/// Philox4x32-10: every four numbers are a hash of where in the stream they are, so a
+	/// stream is 32 bytes, jumps anywhere for free, and splits into as many independent streams
+	/// as anybody wants. A field and each of its robots get a stream split off one root seed, so
+	/// what they draw never depends on who else draws, or on which thread.
+	class Stream {
+	public:
+		using result_type = std::uint32_t;
+
+		constexpr explicit Stream(std::uint64_t seed)
+			: m_Key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {
+		}
+
+		/// Same id, same stream; different ids never overlap with each other or with this one.
+		[[nodiscard]]
+		constexpr Stream Split(std::uint64_t id) const {
+			// Drawing only ever uses the lower half of the counter, splitting the upper.
+			auto const block {Block({static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(id >> 32), 1, 0}, m_Key)};
+			return Stream{block[0] | (static_cast<std::uint64_t>(block[1]) << 32)};
+		}
+
+		constexpr result_type operator()() {
+			if (auto const block {m_Position >> 2}; block != m_BufferedBlock) {
+				m_Buffer = Block({static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32), 0, 0}, m_Key);
+				m_BufferedBlock = block;
+			}
+			return m_Buffer[m_Position++ & 3];
+		}
+
+		/// Same numbers as calling this out.size() times, but whole blocks are made Lanes at a
+		/// time, with every lane's counter in an array of its own so the rounds vectorize.
+		constexpr void Fill(std::span<result_type> out) {
+			std::size_t i{};
+			for (; i < out.size() && (m_Position & 3) != 0; ++i) {
+				out[i] = (*this)();
+			}
+			for (; out.size() - i >= Lanes * 4; i += Lanes * 4) {
+				FillLanes(m_Position >> 2, out.subspan(i, Lanes * 4));
+				m_Position += Lanes * 4;
+			}
+			for (; i < out.size(); ++i) {
+				out[i] = (*this)();
+			}
+		}
+
+		constexpr void Discard(std::uint64_t count) {
+			m_Position += count;
+		}
+
+		/// How many numbers were drawn so far.
+		[[nodiscard]]
+		constexpr std::uint64_t GetPosition() const {
+			return m_Position;
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		/// The four numbers at counter under key; everything else is built on this.
+		[[nodiscard]]
+		static constexpr std::array<std::uint32_t, 4> Block(
+			std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key) {
+			for (std::size_t round{}; round < 10; ++round) {
+				auto const product0 {static_cast<std::uint64_t>(0xD2511F53U) * counter[0]};
+				auto const product1 {static_cast<std::uint64_t>(0xCD9E8D57U) * counter[2]};
+				counter = {
+					static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+					static_cast<std::uint32_t>(product1),
+					static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+					static_cast<std::uint32_t>(product0),
+				};
+				key[0] += 0x9E3779B9U;
+				key[1] += 0xBB67AE85U;
+			}
+			return counter;
+		}
+
+	private:
+		static constexpr std::size_t Lanes{8};
+
+		// Blocks firstBlock to firstBlock + Lanes, the same as Block would make one by one.
+		constexpr void FillLanes(std::uint64_t firstBlock, std::span<result_type> out) const {
+			std::array<std::uint32_t, Lanes> c0{}, c1{}, c2{}, c3{};
+			for (std::size_t lane{}; lane < Lanes; ++lane) {
+				c0[lane] = static_cast<std::uint32_t>(firstBlock + lane);
+				c1[lane] = static_cast<std::uint32_t>((firstBlock + lane) >> 32);
+			}
+
+			auto key {m_Key};
+			for (std::size_t round{}; round < 10; ++round) {
+				for (std::size_t lane{}; lane < Lanes; ++lane) {
+					auto const product0 {static_cast<std::uint64_t>(0xD2511F53U) * c0[lane]};
+					auto const product1 {static_cast<std::uint64_t>(0xCD9E8D57U) * c2[lane]};
+					auto const next0 {static_cast<std::uint32_t>(product1 >> 32) ^ c1[lane] ^ key[0]};
+					auto const next2 {static_cast<std::uint32_t>(product0 >> 32) ^ c3[lane] ^ key[1]};
+					c1[lane] = static_cast<std::uint32_t>(product1);
+					c3[lane] = static_cast<std::uint32_t>(product0);
+					c0[lane] = next0;
+					c2[lane] = next2;
+				}
+				key[0] += 0x9E3779B9U;
+				key[1] += 0xBB67AE85U;
+			}
+
+			for (std::size_t lane{}; lane < Lanes; ++lane) {
+				out[lane * 4 + 0] = c0[lane];
+				out[lane * 4 + 1] = c1[lane];
+				out[lane * 4 + 2] = c2[lane];
+				out[lane * 4 + 3] = c3[lane];
+			}
+		}
+
+	private:
+		std::array<std::uint32_t, 2> m_Key;
+		std::uint64_t m_Position{};
+		std::uint64_t m_BufferedBlock{std::numeric_limits<std::uint64_t>::max()};
+		std::array<std::uint32_t, 4> m_Buffer{};
+	};
+
+	/// What every thread's stream starts out with, so nothing is random from run to run unless
+	/// somebody seeds it to be.
+	inline constexpr std::uint64_t gc_DefaultSeed{0xA5B0'7000'5EED'0001};
+
 	namespace Secret {
-		inline static std::random_device s_Urbg{};
-		inline static std::mt19937 s_Rng{s_Urbg()};
+		// One per thread, so nobody has to lock.
+		inline thread_local Stream s_Rng{gc_DefaultSeed};
 	}
 
-	constexpr std::mt19937& Engine() { return Secret::s_Rng; }
+	inline Stream& Engine() { return Secret::s_Rng; }
+
+	/// Only the calling thread's stream, the others stay where they are. For anything spread
+	/// over threads, hand out Splits of one Stream instead; fields and robots only ever draw
+	/// from those.
+	inline void Seed(std::uint64_t seed) { Secret::s_Rng = Stream{seed}; }
+
+	/// Bulk versions of Int32, Float and Bool, for when millions of numbers are needed. Ints use
+	/// Lemire's multiply and shift, which is unbiased and almost never draws twice; floats are in
+	/// [min, max). Without a stream they draw from the calling thread's.
+	void FillInts(Stream& rng, std::span<std::int32_t> out, std::int32_t min, std::int32_t max);
+	void FillInts(std::span<std::int32_t> out, std::int32_t min, std::int32_t max);
+	void FillFloats(Stream& rng, std::span<float> out, float min, float max);
+	void FillFloats(std::span<float> out, float min, float max);
+	void FillBools(Stream& rng, std::span<bool> out);
+	void FillBools(std::span<bool> out);
 
 #define ARCALC_DECLARE_RANDOM_INT_FUNC(_funcName, _type) \
 	_type _funcName();                                   \
@@ -30,11 +167,11 @@ namespace ArRobot::Random {
 	ValueType Generic(ValueType min, ValueType max) {
 		AROBOT_DA(min <= max, "Tried to generate a random number with the range reversed");
 		if constexpr (std::is_same_v<ValueType, bool>) {
-			return std::bernoulli_distribution{}(Secret::s_Rng);
+			return std::bernoulli_distribution{}(Engine());
 		} else if constexpr (std::is_integral_v<ValueType>) {
-			return std::uniform_int_distribution{min, max}(Secret::s_Rng);
+			return std::uniform_int_distribution{min, max}(Engine());
 		} else {
-			return std::uniform_real_distribution{min, max}(Secret::s_Rng);
+			return std::uniform_real_distribution{min, max}(Engine());
 		}
 	}
 
@@ -48,4 +185,4 @@ namespace ArRobot::Random {
 		using LimitsType = std::numeric_limits<ValueType>;
 		return Generic(LimitsType::min(), LimitsType::max());
 	}
-}
\ No newline at end of file
+}
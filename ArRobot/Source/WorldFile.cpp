@@ -0,0 +1,245 @@
+#include "pch.hpp"
+#include "WorldFile.hpp"
+#include "Compiler.hpp"
+#include "Assembler.hpp"
+#include "Optimizer.hpp"
+#include "ControlFlowGraph.hpp"
+#include "MemoryVerifier.hpp"
+
+namespace ArRobot {
+	WorldFile::WorldFile(std::filesystem::path const& path) : m_File{path}, m_Bytes{m_File.GetBytes()}
+	{
+		Open();
+	}
+
+	WorldFile::WorldFile(std::span<std::byte const> bytes) : m_Bytes{bytes}
+	{
+		Open();
+	}
+
+	std::span<Instruction const> WorldFile::GetProgram(std::size_t index) const
+	{
+		AROBOT_DA(index < m_Programs.size(), "The world has no program {}", index);
+		auto const& entry {m_Programs[index]};
+		return ViewAs<Instruction>(m_ProgramSection, entry.offset, entry.instructionCount, "program");
+	}
+
+	std::size_t WorldFile::GetMemorySize(std::size_t index) const
+	{
+		AROBOT_DA(index < m_Programs.size(), "The world has no program {}", index);
+		return static_cast<std::size_t>(m_Programs[index].memorySize);
+	}
+
+	void WorldFile::Open()
+	{
+		using namespace WorldFormat;
+		auto const& header {ViewAs<Header>(m_Bytes, 0, 1, "header").front()};
+		if (header.magic != gc_Magic)
+		{
+			throw GenericError{"Not a world file"};
+		}
+		if (header.version != gc_Version)
+		{
+			auto const version {header.version};
+			throw GenericError{"World file version {} is not supported, only {}", version, gc_Version};
+		}
+
+		std::optional<std::span<std::byte const>> gridSection{};
+		std::optional<std::span<std::byte const>> spawnSection{};
+		std::optional<std::span<std::byte const>> programSection{};
+		for (auto const& section : ViewAs<Section>(m_Bytes, sizeof(Header), header.sectionCount, "section table"))
+		{
+			if (section.offset % 8 != 0)
+			{
+				auto const offset {section.offset};
+				throw GenericError{"World file section at {} is not aligned", offset};
+			}
+
+			auto* const pFound {section.type == SectionType::Grid ? &gridSection :
+				section.type == SectionType::Spawns ? &spawnSection :
+				section.type == SectionType::Programs ? &programSection : nullptr};
+			if (!pFound)
+			{
+				continue;
+			}
+			if (pFound->has_value())
+			{
+				auto const type {static_cast<std::uint32_t>(section.type)};
+				throw GenericError{"World file has section {} twice", type};
+			}
+			*pFound = ViewAs<std::byte>(m_Bytes, section.offset, section.size, "section");
+		}
+		if (!gridSection)
+		{
+			throw GenericError{"World file has no grid"};
+		}
+
+		auto const& grid {ViewAs<GridHeader>(*gridSection, 0, 1, "grid header").front()};
+		if (grid.bitsPerCell != Arge::PackedTraits<BlockType>::BitsPerCell)
+		{
+			auto const bits {grid.bitsPerCell};
+			throw GenericError{"World file grid has {} bits per cell", bits};
+		}
+		// Keeps the word count from overflowing; a grid this big would not fit anyway.
+		if (grid.width > gridSection->size() * GridView::CellsPerWord || grid.height > gridSection->size())
+		{
+			throw GenericError{"World file grid is bigger than the file"};
+		}
+		auto const width {static_cast<std::size_t>(grid.width)};
+		auto const height {static_cast<std::size_t>(grid.height)};
+		m_Grid = {ViewAs<GridView::Word>(*gridSection, sizeof(GridHeader), GridView::GetWordsPerRow(width) * height, "grid"),
+			width, height};
+		m_CellWidth = grid.cellWidth;
+		m_CellHeight = grid.cellHeight;
+
+		if (programSection)
+		{
+			m_ProgramSection = *programSection;
+			auto const count {ViewAs<std::uint64_t>(m_ProgramSection, 0, 1, "program count").front()};
+			m_Programs = ViewAs<ProgramEntry>(m_ProgramSection, sizeof(std::uint64_t), count, "program table");
+			for (auto const& entry : m_Programs)
+			{
+				[[maybe_unused]] auto const program {ViewAs<Instruction>(m_ProgramSection, entry.offset, entry.instructionCount, "program")};
+			}
+		}
+
+		if (spawnSection)
+		{
+			if (spawnSection->size() % sizeof(Spawn) != 0)
+			{
+				throw GenericError{"World file spawns are cut off"};
+			}
+			m_Spawns = ViewAs<Spawn>(*spawnSection, 0, spawnSection->size() / sizeof(Spawn), "spawns");
+			for (auto const& spawn : m_Spawns)
+			{
+				if (!m_Grid.IsInBounds(static_cast<std::size_t>(spawn.x), static_cast<std::size_t>(spawn.y)) ||
+					spawn.program >= m_Programs.size())
+				{
+					auto const x {spawn.x};
+					auto const y {spawn.y};
+					auto const program {spawn.program};
+					throw GenericError{"World file spawn at ({}, {}) with program {} is off", x, y, program};
+				}
+			}
+		}
+	}
+
+	template <class T>
+	std::span<T const> WorldFile::ViewAs(std::span<std::byte const> bytes, std::uint64_t offset,
+		std::uint64_t count, std::string_view what)
+	{
+		// Written so nothing overflows, no matter what the file says.
+		if (offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T))
+		{
+			throw GenericError{"World file {} reaches past its end", what};
+		}
+		auto const* const pFirst {bytes.data() + offset};
+		if (reinterpret_cast<std::uintptr_t>(pFirst) % alignof(T) != 0)
+		{
+			throw GenericError{"World file {} is not aligned", what};
+		}
+		return {reinterpret_cast<T const*>(pFirst), static_cast<std::size_t>(count)};
+	}
+
+	WorldWriter::WorldWriter(Arge::Grid<BlockType> grid) : m_Grid{std::move(grid)}
+	{
+	}
+
+	std::uint32_t WorldWriter::AddProgram(std::span<Instruction const> program, std::size_t memorySize)
+	{
+		ControlFlowGraph const cfg{program};
+		MemoryVerifier{memorySize}.Verify(program);
+		m_Programs.push_back({{program.begin(), program.end()}, memorySize});
+		return static_cast<std::uint32_t>(m_Programs.size() - 1);
+	}
+
+	std::uint32_t WorldWriter::AddSource(std::string_view code, std::size_t memorySize)
+	{
+		auto const commands {Compiler{}.Compile(code)};
+		return AddProgram(Optimizer{}.Optimize(Asm::Assemble(commands)), memorySize);
+	}
+
+	std::uint32_t WorldWriter::ImportSource(std::filesystem::path const& path, std::size_t memorySize)
+	{
+		std::ifstream file{path};
+		if (!file)
+		{
+			auto const pathStr {path.string()};
+			throw GenericError{"Could not open {} to import it", pathStr};
+		}
+		std::string const code{std::istreambuf_iterator<char>{file}, {}};
+		return AddSource(code, memorySize);
+	}
+
+	void WorldWriter::AddSpawn(std::int32_t x, std::int32_t y, std::uint32_t program)
+	{
+		if (!m_Grid.IsInBoundsSigned(x, y) || program >= m_Programs.size())
+		{
+			throw GenericError{"Can not spawn a robot at ({}, {}) with program {}", x, y, program};
+		}
+		m_Spawns.push_back({x, y, program});
+	}
+
+	std::vector<std::byte> WorldWriter::Serialize() const
+	{
+		using namespace WorldFormat;
+		std::vector<std::byte> res{};
+		auto const append {[&res](void const* pData, std::size_t size) {
+			auto const* const pBytes {static_cast<std::byte const*>(pData)};
+			res.insert(res.end(), pBytes, pBytes + size);
+		}};
+		auto const beginSection {[&res](Section& section) {
+			res.resize((res.size() + 7) / 8 * 8);
+			section.offset = res.size();
+		}};
+
+		std::array<Section, 3> sections {{{SectionType::Grid}, {SectionType::Spawns}, {SectionType::Programs}}};
+		Header const header {gc_Magic, gc_Version, static_cast<std::uint32_t>(sections.size())};
+		append(&header, sizeof(header));
+		// Filled in once everything else is where it goes.
+		res.resize(res.size() + sizeof(sections));
+
+		beginSection(sections[0]);
+		GridHeader const gridHeader {m_Grid.GetWidth(), m_Grid.GetHeight(), m_Grid.GetCellWidth(), m_Grid.GetCellHeight(),
+			Arge::PackedTraits<BlockType>::BitsPerCell};
+		append(&gridHeader, sizeof(gridHeader));
+		auto const words {m_Grid.GetWords()};
+		append(words.data(), words.size_bytes());
+		sections[0].size = res.size() - sections[0].offset;
+
+		beginSection(sections[1]);
+		append(m_Spawns.data(), m_Spawns.size() * sizeof(Spawn));
+		sections[1].size = res.size() - sections[1].offset;
+
+		beginSection(sections[2]);
+		std::uint64_t const count {m_Programs.size()};
+		append(&count, sizeof(count));
+		auto offset {sizeof(count) + m_Programs.size() * sizeof(ProgramEntry)};
+		for (auto const& program : m_Programs)
+		{
+			ProgramEntry const entry {offset, program.instructions.size(), program.memorySize};
+			append(&entry, sizeof(entry));
+			offset += program.instructions.size() * sizeof(Instruction);
+		}
+		for (auto const& program : m_Programs)
+		{
+			append(program.instructions.data(), program.instructions.size() * sizeof(Instruction));
+		}
+		sections[2].size = res.size() - sections[2].offset;
+
+		std::memcpy(res.data() + sizeof(header), sections.data(), sizeof(sections));
+		return res;
+	}
+
+	void WorldWriter::Write(std::filesystem::path const& path) const
+	{
+		std::ofstream file{path, std::ios::binary};
+		if (!file)
+		{
+			auto const pathStr {path.string()};
+			throw GenericError{"Could not open {} to write the world", pathStr};
+		}
+		auto const bytes {Serialize()};
+		file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include "ArRobotCore.hpp"
+#include "BlockType.hpp"
+#include "Instruction.hpp"
+#include "ArRobotException.hpp"
+#include "Util/MappedFile.hpp"
+
+#include <Arge/Arge.hpp>
+
+namespace ArRobot {
+	/// Where a robot starts out, and which of the world's programs it runs.
+	struct Spawn
+	{
+		std::int32_t x{};
+		std::int32_t y{};
+		std::uint32_t program{};
+		std::uint32_t reserved{};
+
+		constexpr bool operator==(Spawn const&) const = default;
+	};
+
+	/// How a world file is laid out. Everything is little-endian and 8 byte aligned, so it is
+	/// used right where it was mapped:
+	///   Header      magic, version, how many sections
+	///   Section[]   what each section holds, and where
+	///   Grid        GridHeader, then the words of the packed grid, row after row
+	///   Spawns      Spawn[]
+	///   Programs    how many, ProgramEntry[] (offsets from the start of the section), then the
+	///               Instructions of every program, back to back
+	/// Sections may come in any order, and sections of types nobody knows yet are skipped.
+	namespace WorldFormat {
+		static constexpr std::array<char, 8> gc_Magic{'A', 'R', 'W', 'O', 'R', 'L', 'D', '\0'};
+		static constexpr std::uint32_t gc_Version{1};
+
+		enum class SectionType : std::uint32_t
+		{
+			Grid = 1,
+			Spawns,
+			Programs,
+		};
+
+		struct Header
+		{
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t sectionCount;
+		};
+
+		struct Section
+		{
+			SectionType type;
+			std::uint32_t reserved;
+			std::uint64_t offset;
+			std::uint64_t size;
+		};
+
+		struct GridHeader
+		{
+			std::uint64_t width;
+			std::uint64_t height;
+			float cellWidth;
+			float cellHeight;
+			std::uint32_t bitsPerCell;
+			std::uint32_t reserved;
+		};
+
+		struct ProgramEntry
+		{
+			std::uint64_t offset;
+			std::uint64_t instructionCount;
+			std::uint64_t memorySize;
+		};
+
+		// What is on the disk is what is in memory, byte for byte.
+		static_assert(std::endian::native == std::endian::little, "World files are little-endian");
+		static_assert(std::is_trivially_copyable_v<Instruction> && sizeof(Instruction) == 20);
+		static_assert(sizeof(Header) == 16 && sizeof(Section) == 24 && sizeof(GridHeader) == 32);
+		static_assert(sizeof(ProgramEntry) == 24 && sizeof(Spawn) == 16);
+		// Programs are stored with their CommandTypes as they are, so those must never move.
+		static_assert(static_cast<std::int32_t>(CommandType::MemPrintAll) == 14);
+		static_assert(static_cast<std::int32_t>(CommandType::StepToward) == 15);
+	}
+
+	/// A world straight off the disk: the file is mapped, the header and the section table are
+	/// checked, and that is it. The grid and the programs are views into the mapping, so they
+	/// are only good for as long as this lives.
+	class WorldFile
+	{
+	public:
+		using GridView = Arge::PackedArray2DView<BlockType, Arge::PackedTraits<BlockType>::BitsPerCell>;
+
+		/// Throws a GenericError if the file is not a world, is from another version, or anything
+		/// in it points outside of it.
+		explicit WorldFile(std::filesystem::path const& path);
+		/// Same, for a world that is already in memory; the bytes have to outlive this.
+		explicit WorldFile(std::span<std::byte const> bytes);
+
+		/// The whole file, as mapped.
+		[[nodiscard]]
+		constexpr std::span<std::byte const> GetBytes() const
+		{
+			return m_Bytes;
+		}
+
+		[[nodiscard]]
+		constexpr GridView const& GetGrid() const
+		{
+			return m_Grid;
+		}
+
+		[[nodiscard]]
+		constexpr float GetCellWidth() const
+		{
+			return m_CellWidth;
+		}
+
+		[[nodiscard]]
+		constexpr float GetCellHeight() const
+		{
+			return m_CellHeight;
+		}
+
+		[[nodiscard]]
+		constexpr std::span<Spawn const> GetSpawns() const
+		{
+			return m_Spawns;
+		}
+
+		[[nodiscard]]
+		constexpr std::size_t GetProgramCount() const
+		{
+			return m_Programs.size();
+		}
+
+		/// Ready for Robot::LoadProgram, which checks it like any other program.
+		[[nodiscard]]
+		std::span<Instruction const> GetProgram(std::size_t index) const;
+
+		[[nodiscard]]
+		std::size_t GetMemorySize(std::size_t index) const;
+
+	private:
+		void Open();
+
+		// count Ts at offset into bytes, after making sure they are in there and aligned.
+		template <class T>
+		[[nodiscard]]
+		static std::span<T const> ViewAs(std::span<std::byte const> bytes, std::uint64_t offset,
+			std::uint64_t count, std::string_view what);
+
+	private:
+		MappedFile m_File{};
+		std::span<std::byte const> m_Bytes{};
+		GridView m_Grid{};
+		float m_CellWidth{};
+		float m_CellHeight{};
+		std::span<Spawn const> m_Spawns{};
+		std::span<WorldFormat::ProgramEntry const> m_Programs{};
+		std::span<std::byte const> m_ProgramSection{};
+	};
+
+	/// Puts a world together and writes it out the way WorldFile reads it.
+	class WorldWriter
+	{
+	public:
+		explicit WorldWriter(Arge::Grid<BlockType> grid);
+
+		/// Checked the same way Robot::LoadProgram checks it, so a broken program throws here
+		/// instead of when the world gets loaded. Returns the index spawns refer to it by.
+		std::uint32_t AddProgram(std::span<Instruction const> program,
+			std::size_t memorySize = Cmd::gc_DefaultMemorySize);
+		/// Compiles ArRobot source (see Program.txt), then assembles and optimizes it.
+		std::uint32_t AddSource(std::string_view code, std::size_t memorySize = Cmd::gc_DefaultMemorySize);
+		/// AddSource, for a source file.
+		std::uint32_t ImportSource(std::filesystem::path const& path,
+			std::size_t memorySize = Cmd::gc_DefaultMemorySize);
+
+		/// Throws a GenericError if the cell is not on the grid or the program was never added.
+		void AddSpawn(std::int32_t x, std::int32_t y, std::uint32_t program);
+
+		[[nodiscard]]
+		std::vector<std::byte> Serialize() const;
+		void Write(std::filesystem::path const& path) const;
+
+	private:
+		struct Program
+		{
+			std::vector<Instruction> instructions;
+			std::size_t memorySize;
+		};
+
+	private:
+		Arge::Grid<BlockType> m_Grid;
+		std::vector<Spawn> m_Spawns{};
+		std::vector<Program> m_Programs{};
+	};
+}
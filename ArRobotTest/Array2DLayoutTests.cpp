@@ -0,0 +1,143 @@
+#include "pch.h"
+#include <Arge/Arge.hpp>
+
+#define LAYOUT_TEST(_testName) TYPED_TEST(Array2DLayoutTests, _testName)
+
+template <class TLayout>
+class Array2DLayoutTests : public ::testing::Test
+{
+public:
+	static Arge::Array2D<std::int32_t, TLayout> GenerateTestingInstance(std::size_t width, std::size_t height)
+	{
+		return Arge::Array2D<std::int32_t, TLayout> {width, height};
+	}
+
+	// The grid a robot field would use, with a few blocks sprinkled around.
+	static Arge::Array2D<std::int32_t, TLayout> GenerateBenchmarkInstance()
+	{
+		auto res {GenerateTestingInstance(1024, 1024)};
+		for (std::size_t i{}; i < res.GetSize(); ++i)
+		{
+			res.AtIndex(i) = static_cast<std::int32_t>(i % 7 == 0);
+		}
+		return res;
+	}
+
+	template <class Callable>
+	static void Time(std::string_view what, Callable&& doWhat)
+	{
+		auto const begin {std::chrono::steady_clock::now()};
+		auto const checksum {doWhat()};
+		std::chrono::duration<double, std::milli> const took {std::chrono::steady_clock::now() - begin};
+		std::cout << std::format("{:<24} {:<16} {:>9.2f}ms (checksum {})\n",
+			::testing::UnitTest::GetInstance()->current_test_info()->type_param(), what, took.count(), checksum);
+	}
+};
+
+using Layouts = ::testing::Types<Arge::RowMajorLayout, Arge::TiledLayout<8>, Arge::TiledLayout<32>, Arge::MortonLayout>;
+TYPED_TEST_SUITE(Array2DLayoutTests, Layouts);
+
+LAYOUT_TEST(Every_cell_gets_a_slot_of_its_own)
+{
+	for (auto const [width, height] : std::initializer_list<std::pair<std::size_t, std::size_t>> {{13, 7}, {70, 3}, {1, 1}, {8, 16}})
+	{
+		auto array {TestFixture::GenerateTestingInstance(width, height)};
+		ASSERT_EQ(width * height, array.GetSize());
+		for (std::size_t y{}; y < height; ++y)
+		{
+			for (std::size_t x{}; x < width; ++x)
+			{
+				ASSERT_EQ(0, array.At(x, y)) << x << ", " << y << " shares a slot";
+				array.At(x, y) = static_cast<std::int32_t>(1 + x + y * width);
+			}
+		}
+
+		// The iterators go through every cell once, padding or not.
+		std::vector<std::int32_t> seen(array.begin(), array.end());
+		std::ranges::sort(seen);
+		std::vector<std::int32_t> expected(width * height);
+		std::iota(expected.begin(), expected.end(), 1);
+		ASSERT_EQ(expected, seen);
+
+		for (std::size_t i{}; i < array.GetSize(); ++i)
+		{
+			ASSERT_EQ(static_cast<std::int32_t>(i + 1), array.AtIndex(i));
+		}
+	}
+}
+
+LAYOUT_TEST(Grids_take_layouts_too)
+{
+	Arge::Grid<float, TypeParam> grid{9, 5, 2.0f, 2.0f};
+	grid.At(8, 4) = 3.0f;
+	ASSERT_EQ(3.0f, grid.AtIndex(8 + 4 * 9));
+	ASSERT_EQ(3.0f, std::accumulate(grid.begin(), grid.end(), 0.0f));
+}
+
+static constexpr std::array<std::pair<std::ptrdiff_t, std::ptrdiff_t>, 8> gc_Neighbours {{
+	{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1},
+}};
+
+// Not run by default; --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* to compare.
+LAYOUT_TEST(DISABLED_Benchmark_random_neighbours)
+{
+	auto const array {TestFixture::GenerateBenchmarkInstance()};
+	std::mt19937 rng{42};
+	std::uniform_int_distribution<std::size_t> pick{1, 1022};
+	std::vector<std::pair<std::size_t, std::size_t>> cells(1 << 20);
+	std::ranges::generate(cells, [&] { return std::pair {pick(rng), pick(rng)}; });
+
+	// What every Check does, all eight ways around.
+	TestFixture::Time("neighbours", [&] {
+		std::int64_t res{};
+		for (auto const [x, y] : cells)
+		{
+			for (auto const [dx, dy] : gc_Neighbours)
+			{
+				res += array.At(x + dx, y + dy);
+			}
+		}
+		return res;
+	});
+
+	// A robot walking down, then the next column.
+	TestFixture::Time("vertical walk", [&] {
+		std::int64_t res{};
+		for (std::size_t x{}; x < array.GetWidth(); ++x)
+		{
+			for (std::size_t y{}; y < array.GetHeight(); ++y)
+			{
+				res += array.At(x, y);
+			}
+		}
+		return res;
+	});
+}
+
+LAYOUT_TEST(DISABLED_Benchmark_region_scans)
+{
+	auto const array {TestFixture::GenerateBenchmarkInstance()};
+
+	// Every 32x32 square, like looking around a robot.
+	TestFixture::Time("32x32 regions", [&] {
+		std::int64_t res{};
+		for (std::size_t top{}; top < array.GetHeight(); top += 32)
+		{
+			for (std::size_t left{}; left < array.GetWidth(); left += 32)
+			{
+				for (auto y {top}; y < top + 32; ++y)
+				{
+					for (auto x {left}; x < left + 32; ++x)
+					{
+						res += array.At(x, y);
+					}
+				}
+			}
+		}
+		return res;
+	});
+
+	TestFixture::Time("linear", [&] {
+		return std::accumulate(array.begin(), array.end(), std::int64_t{});
+	});
+}
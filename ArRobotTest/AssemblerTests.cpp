@@ -0,0 +1,74 @@
+#include "pch.h"
+#include <Assembler.hpp>
+
+#define ASSEMBLER_TEST(_testName) TEST_F(AssemblerTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class AssemblerTests : public ::testing::Test
+{
+};
+
+namespace {
+	constexpr auto gc_Program {R"(
+		: Start
+		Move 1, 0
+		Check 1, 0, Wall
+		JumpFalse Start
+		MemSet 3, -7
+		Not 3
+		: End
+	)"_arobot};
+
+	// Labels are gone, and a Halt is added at the end.
+	static_assert(gc_Program.size() == 6);
+	static_assert(gc_Program[2].type == CommandType::JumpFalse && gc_Program[2].a == 0);
+	static_assert(gc_Program[1].c == static_cast<std::int32_t>(BlockType::Wall));
+	static_assert(gc_Program[3].b == -7);
+	static_assert(gc_Program[4].b == 3 && gc_Program[4].c == 3);
+	static_assert(gc_Program.back().type == CommandType::Halt);
+}
+
+ASSEMBLER_TEST(Text_and_commands_assemble_the_same)
+{
+	std::vector const commands {
+		Command::MakeMarkLabel("Start"),
+		Command::MakeMove(1, 0),
+		Command::MakeCheckDir(1, 0, BlockType::Wall),
+		Command::MakeJumpFalse("Start"),
+		Command::MakeMemSet(3, -7),
+		Command::MakeBinaryOp(OpCode::Not, 3, 3),
+		Command::MakeMarkLabel("End"),
+	};
+
+	auto const res {Asm::Assemble(commands)};
+	ASSERT_TRUE(std::ranges::equal(gc_Program, res));
+}
+
+ASSEMBLER_TEST(Labels_resolve_forwards_and_backwards)
+{
+	auto const res {Asm::Assemble(
+		"Jump Forward\n"
+		": Back\n"
+		"Halt\n"
+		": Forward\n"
+		"Jump Back\n"
+	)};
+
+	ASSERT_EQ(4, res.size());
+	ASSERT_EQ(2, res[0].a);
+	ASSERT_EQ(1, res[2].a);
+}
+
+ASSEMBLER_TEST(Invalid_programs)
+{
+	ASSERT_THROW(Asm::Assemble("Jump Nowhere"), ParseError);
+	ASSERT_THROW(Asm::Assemble(": A\n: A"), ParseError);
+	ASSERT_THROW(Asm::Assemble("Fly 1, 0"), ParseError);
+	ASSERT_THROW(Asm::Assemble("Move 1"), ParseError);
+	ASSERT_THROW(Asm::Assemble("Move 1, 0, 0"), ParseError);
+	ASSERT_THROW(Asm::Assemble("MemSet -1, 0"), ParseError);
+	ASSERT_THROW(Asm::Assemble("Check 1, 0, Lava"), ParseError);
+	ASSERT_THROW(Asm::Assemble("Move 1, 99999999999"), ParseError);
+}
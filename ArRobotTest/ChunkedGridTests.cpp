@@ -0,0 +1,77 @@
+#include "pch.h"
+#include <BlockType.hpp>
+#include <Arge/Arge.hpp>
+
+#define CHUNKED_GRID_TEST(_testName) TEST_F(ChunkedGridTests, _testName)
+
+using namespace ArRobot;
+
+class ChunkedGridTests : public ::testing::Test
+{
+public:
+	static Arge::ChunkedGrid<BlockType> GenerateTestingInstance()
+	{
+		return Arge::ChunkedGrid<BlockType> {50.0f, 50.0f};
+	}
+};
+
+CHUNKED_GRID_TEST(No_edges)
+{
+	auto grid {GenerateTestingInstance()};
+	ASSERT_EQ(BlockType::Nothing, std::as_const(grid).At(-1'000'000, 5'000'000));
+
+	grid.At(-1, -1) = BlockType::Wall;
+	grid.At(0, 0) = BlockType::Item;
+	grid.At(63, 63) = BlockType::Pit;
+	grid.At(-1'000'000, 5'000'000) = BlockType::Wall;
+
+	ASSERT_EQ(BlockType::Wall, grid.At(-1, -1));
+	ASSERT_EQ(BlockType::Item, grid.At(0, 0));
+	ASSERT_EQ(BlockType::Pit, grid.At(63, 63));
+	ASSERT_EQ(BlockType::Nothing, grid.At(64, 63));
+	ASSERT_EQ(BlockType::Nothing, grid.At(-1, 0));
+	ASSERT_EQ(BlockType::Wall, grid.At(-1'000'000, 5'000'000));
+
+	// (0, 0) and (63, 63) share a chunk, the other two get one each.
+	ASSERT_EQ(3, grid.GetChunkCount());
+	ASSERT_EQ((std::pair<std::int64_t, std::int64_t> {-1, -1}), grid.ScreenToGrid({-0.5f, -49.0f}));
+}
+
+CHUNKED_GRID_TEST(Only_touched_chunks_take_memory)
+{
+	auto grid {GenerateTestingInstance()};
+
+	// Reading and writing the default leave nothing behind.
+	[[maybe_unused]] BlockType const read {grid.At(100, 100)};
+	grid.At(200, 200) = BlockType::Nothing;
+	ASSERT_EQ(0, grid.GetChunkCount());
+
+	grid.At(10, 10) = BlockType::Wall;
+	grid.At(11, 10) = BlockType::Wall;
+	grid.At(11, 10) = BlockType::Item;
+	ASSERT_EQ(1, grid.GetChunkCount());
+
+	grid.At(10, 10) = BlockType::Nothing;
+	ASSERT_EQ(1, grid.GetChunkCount());
+	grid.At(11, 10) = BlockType::Nothing;
+	ASSERT_EQ(0, grid.GetChunkCount());
+	ASSERT_EQ(0, grid.GetMemoryUsage());
+}
+
+CHUNKED_GRID_TEST(Visits_what_was_set)
+{
+	auto grid {GenerateTestingInstance()};
+	std::map<std::pair<std::int64_t, std::int64_t>, BlockType> const expected {
+		{{-65, 3}, BlockType::Wall}, {{-64, 3}, BlockType::Item}, {{1000, -1000}, BlockType::Pit},
+	};
+	for (auto const& [pos, block] : expected)
+	{
+		grid.At(pos.first, pos.second) = block;
+	}
+
+	std::map<std::pair<std::int64_t, std::int64_t>, BlockType> found{};
+	grid.ForEachSet([&found](std::int64_t x, std::int64_t y, BlockType block) {
+		found[{x, y}] = block;
+	});
+	ASSERT_EQ(expected, found);
+}
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include <ControlFlowGraph.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define CFG_TEST(_testName) TEST_F(ControlFlowGraphTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class ControlFlowGraphTests : public ::testing::Test
+{
+public:
+	static ControlFlowGraph GenerateTestingInstance(std::span<Instruction const> program)
+	{
+		return ControlFlowGraph {program};
+	}
+};
+
+CFG_TEST(Splits_blocks_at_jumps_and_targets)
+{
+	auto constexpr program {R"(
+		: Start
+		Move 1, 0
+		Check 1, 0, Wall
+		JumpFalse Start
+		Move 0, 1
+		Jump Start
+	)"_arobot};
+
+	auto const cfg {GenerateTestingInstance(program)};
+	auto const blocks {cfg.GetBlocks()};
+
+	// [Move Check JumpFalse] [Move Jump] [Halt]
+	ASSERT_EQ(3, blocks.size());
+	ASSERT_EQ(0, blocks[0].begin);
+	ASSERT_EQ(3, blocks[0].end);
+	ASSERT_EQ((std::vector<std::size_t> {0, 1}), blocks[0].successors);
+	ASSERT_EQ((std::vector<std::size_t> {0}), blocks[1].successors);
+	ASSERT_TRUE(blocks[2].successors.empty());
+	ASSERT_EQ(1, cfg.BlockOf(4));
+
+	// The Halt the assembler added is never reached.
+	ASSERT_EQ((std::vector<std::size_t> {5}), cfg.FindUnreachable());
+	ASSERT_TRUE(cfg.FindTightLoops().empty());
+}
+
+CFG_TEST(Finds_tight_loops)
+{
+	auto constexpr program {R"(
+		: Wait
+		Check 1, 0, Item
+		JumpFalse Wait
+		: Spin
+		MemSet 0, 1
+		Jump Spin
+	)"_arobot};
+
+	// The first loop can get out once an item shows up, the second one never can.
+	auto const cfg {GenerateTestingInstance(program)};
+	auto const loops {cfg.FindTightLoops()};
+	ASSERT_EQ(1, loops.size());
+	ASSERT_EQ((std::vector<std::size_t> {cfg.BlockOf(2)}), loops.front());
+
+	// Moving around in circles is not being stuck.
+	auto constexpr circles {R"(
+		: Loop
+		Move 1, 0
+		Move -1, 0
+		Jump Loop
+	)"_arobot};
+	ASSERT_TRUE(GenerateTestingInstance(circles).FindTightLoops().empty());
+}
+
+CFG_TEST(Rejects_broken_programs)
+{
+	using enum CommandType;
+	auto const check {[](std::vector<Instruction> const& program) {
+		return GenerateTestingInstance(program);
+	}};
+
+	ASSERT_THROW(check({}), ParseError);
+	ASSERT_THROW(check({{Jump, 1, 5}, {Halt, 1}}), ParseError);
+	ASSERT_THROW(check({{JumpTrue, 1, -1}, {Halt, 1}}), ParseError);
+	ASSERT_THROW(check({{Move, 1, 1, 0}}), ParseError);
+	ASSERT_THROW(check({{MarkLabel, 1}, {Halt, 1}}), ParseError);
+	ASSERT_THROW(check({{static_cast<CommandType>(99), 1}, {Halt, 1}}), ParseError);
+	ASSERT_NO_THROW(check({{Move, 1, 1, 0}, {Jump, 1, 0}}));
+}
+
+CFG_TEST(Robots_check_added_commands_too)
+{
+	// Made without the parser, which would have refused it.
+	Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+	Robot robot{grid};
+	robot.AddCommand(Command::MakeStepToward(BlockType::Robot));
+	ASSERT_THROW(robot.Tick(), ParseError);
+}
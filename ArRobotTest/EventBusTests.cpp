@@ -0,0 +1,94 @@
+#include "pch.h"
+#include <Arge/EventBus.hpp>
+
+#define EVENT_BUS_TEST(_testName) TEST_F(EventBusTests, _testName)
+
+using Arge::EventType;
+
+class EventBusTests : public ::testing::Test
+{
+public:
+	static Arge::EventBus GenerateTestingInstance()
+	{
+		return Arge::EventBus{};
+	}
+
+	static Arge::Event Make(EventType type, std::int32_t tag = 0)
+	{
+		SDL_Event raw{};
+		raw.type = static_cast<Uint32>(type);
+		raw.wheel.y = tag;
+		return Arge::Event{raw};
+	}
+
+	static std::int32_t Tag(Arge::Event const& ev)
+	{
+		return ev.GetRawAccess().wheel.y;
+	}
+};
+
+EVENT_BUS_TEST(Handlers_only_hear_their_type)
+{
+	auto bus {GenerateTestingInstance()};
+	std::vector<std::int32_t> wheels{};
+	std::size_t keys{};
+	bus.Subscribe(EventType::MouseWheel, [&wheels](Arge::Event const& ev) { wheels.push_back(Tag(ev)); });
+	bus.Subscribe(EventType::KeyDown, [&keys](Arge::Event const&) { ++keys; });
+
+	bus.BeginFrame();
+	for (auto const type : {EventType::MouseWheel, EventType::KeyDown, EventType::MouseMotion, EventType::MouseWheel})
+	{
+		bus.Push(Make(type, static_cast<std::int32_t>(bus.GetEvents().size())));
+	}
+	bus.Dispatch();
+	ASSERT_EQ((std::vector {0, 3}), wheels);
+	ASSERT_EQ(1, keys);
+	ASSERT_EQ(4, bus.GetEvents().size());
+
+	// The next frame starts from nothing.
+	bus.BeginFrame();
+	bus.Dispatch();
+	ASSERT_TRUE(bus.GetEvents().empty());
+	ASSERT_EQ(2, wheels.size());
+}
+
+EVENT_BUS_TEST(Subscribing_from_inside_a_handler)
+{
+	auto bus {GenerateTestingInstance()};
+	std::size_t once{};
+	std::size_t late{};
+	Arge::EventBus::SubscriptionId onceId{};
+	onceId = bus.Subscribe(EventType::KeyUp, [&](Arge::Event const&) {
+		++once;
+		bus.Unsubscribe(onceId);
+		bus.Subscribe(EventType::KeyUp, [&late](Arge::Event const&) { ++late; });
+	});
+
+	bus.BeginFrame();
+	bus.Push(Make(EventType::KeyUp));
+	bus.Push(Make(EventType::KeyUp));
+	bus.Dispatch();
+	// Gone right away; the new one waits for the next frame.
+	ASSERT_EQ(1, once);
+	ASSERT_EQ(0, late);
+	ASSERT_EQ(1, bus.GetSubscriberCount(EventType::KeyUp));
+
+	bus.Dispatch();
+	ASSERT_EQ(1, once);
+	ASSERT_EQ(2, late);
+}
+
+EVENT_BUS_TEST(Unsubscribed_handlers_are_dropped)
+{
+	auto bus {GenerateTestingInstance()};
+	std::size_t calls{};
+	auto const id {bus.Subscribe(EventType::MouseMotion, [&calls](Arge::Event const&) { ++calls; })};
+	bus.Subscribe(EventType::MouseMotion, [&calls](Arge::Event const&) { calls += 10; });
+	bus.Unsubscribe(id);
+	ASSERT_EQ(1, bus.GetSubscriberCount(EventType::MouseMotion));
+	ASSERT_EQ(0, bus.GetSubscriberCount(EventType::KeyDown));
+
+	bus.Push(Make(EventType::MouseMotion));
+	bus.Dispatch();
+	ASSERT_EQ(10, calls);
+}
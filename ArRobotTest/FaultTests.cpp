@@ -0,0 +1,98 @@
+#include "pch.h"
+#include <Fault.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+#include <Optimizer.hpp>
+
+#define FAULT_TEST(_testName) TEST_F(FaultTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class FaultTests : public ::testing::Test
+{
+public:
+	static Fault GenerateTestingInstance(FaultCode code, std::int64_t lhs = 0, std::int64_t rhs = 0)
+	{
+		return Fault {code, 3, {lhs, rhs}};
+	}
+};
+
+FAULT_TEST(Robots_stop_on_faults)
+{
+	auto constexpr program {R"(
+		Move 1, 0
+		Move 1, 0
+		Move 1, 0
+	)"_arobot};
+
+	Arge::Grid<BlockType> grid{3, 3, 1.0f, 1.0f};
+	Robot robot{grid};
+	robot.LoadProgram(program);
+	ASSERT_EQ(FaultCode::None, robot.Tick());
+	ASSERT_EQ(FaultCode::None, robot.Tick());
+	ASSERT_EQ(FaultCode::OutOfGridX, robot.Tick());
+
+	// Nothing happens from now on, and the robot never left the grid.
+	ASSERT_EQ(FaultCode::OutOfGridX, robot.Tick());
+	ASSERT_EQ((std::pair {2, 0}), robot.GetPos());
+	ASSERT_EQ(2, robot.GetFault().instIndex);
+	ASSERT_EQ("Moved out of the grid! (x is 3 but width is 3)", robot.GetFault().FormatMessage());
+	ASSERT_THROW(robot.ThrowIfFaulted(), GenericError);
+
+	// A new program starts over.
+	robot.LoadProgram(program);
+	ASSERT_FALSE(robot.IsFaulted());
+	ASSERT_NO_THROW(robot.ThrowIfFaulted());
+}
+
+FAULT_TEST(Fused_moves_stop_at_the_edge_too)
+{
+	auto constexpr program {R"(
+		Move 1, 0
+		Move 1, 0
+		Move 0, 1
+	)"_arobot};
+	auto const fused {Optimizer{false}.Optimize(program)};
+	ASSERT_EQ(program.size() - 1, fused.size());
+
+	for (auto const candidate : {std::span<Instruction const> {program}, std::span<Instruction const> {fused}})
+	{
+		Arge::Grid<BlockType> grid{3, 3, 1.0f, 1.0f};
+		Robot robot{grid, 1, 0};
+		robot.LoadProgram(candidate);
+		while (robot.Tick() == FaultCode::None)
+		{
+		}
+		ASSERT_EQ(FaultCode::OutOfGridX, robot.GetFault().code);
+		ASSERT_EQ((std::pair {2, 0}), robot.GetPos());
+	}
+}
+
+FAULT_TEST(Items)
+{
+	auto constexpr program {R"(
+		PickUp
+		Drop
+		Drop
+	)"_arobot};
+
+	Arge::Grid<BlockType> grid{3, 3, 1.0f, 1.0f};
+	Robot robot{grid};
+	robot.LoadProgram(program);
+	robot.Tick();
+	ASSERT_TRUE(robot.IsCarryingItem());
+	robot.Tick();
+	ASSERT_EQ(FaultCode::DroppingNothing, robot.Tick());
+}
+
+FAULT_TEST(Messages)
+{
+	ASSERT_EQ("Already holding something (at instruction 3)", 
+		GenerateTestingInstance(FaultCode::AlreadyHolding).FormatMessage());
+	ASSERT_EQ("Moved out of the grid! (y is -1 but height is 5)", 
+		GenerateTestingInstance(FaultCode::OutOfGridY, -1, 5).FormatMessage());
+	ASSERT_EQ("Executing invalid Instruction MarkLabel (at instruction 3)", 
+		GenerateTestingInstance(FaultCode::InvalidInstruction, static_cast<std::int64_t>(CommandType::MarkLabel)).FormatMessage());
+	ASSERT_FALSE(GenerateTestingInstance(FaultCode::None).IsFaulted());
+}
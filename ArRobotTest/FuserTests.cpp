@@ -0,0 +1,169 @@
+#include "pch.h"
+#include <Fuser.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define FUSER_TEST(_testName) TEST_F(FuserTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class FuserTests : public ::testing::Test
+{
+public:
+	static Fuser GenerateTestingInstance()
+	{
+		return Fuser {};
+	}
+
+	// Runs until the robot halts, and returns how many ticks that took.
+	static std::size_t RunToHalt(Robot& robot, std::size_t maxTicks = 1000)
+	{
+		for (std::size_t i{}; i < maxTicks; ++i)
+		{
+			robot.Tick();
+			if (robot.IsHalted())
+			{
+				return i + 1;
+			}
+		}
+		return maxTicks;
+	}
+};
+
+namespace {
+	// Counts mem[0] down from 5, walking one cell right every time.
+	constexpr auto gc_CountDown {R"(
+		MemSet 0, 5
+		MemSet 1, 1
+		MemSet 2, 0
+		: Loop
+		Move 1, 0
+		Check 0, 1, Wall
+		JumpTrue Loop
+		Sub 0, 1
+		MemCopy 15, 0
+		Add 15, 2
+		JumpTrue Loop
+		MemSet 3, 9
+		MemSet 4, 9
+	)"_arobot};
+}
+
+FUSER_TEST(Fuses_runs_in_place)
+{
+	auto const res {GenerateTestingInstance().Fuse(gc_CountDown)};
+	ASSERT_EQ(gc_CountDown.size(), res.size());
+
+	using enum CommandType;
+	auto const types {res | std::views::transform(&Instruction::type)};
+	ASSERT_TRUE(std::ranges::equal(types, std::array {
+		MemSetRun, MemSetRun, MemSet, 
+		Move, CheckJumpTrue, JumpTrue, BinaryOp, MemCopy, OpJumpTrue, JumpTrue, 
+		MemSetRun, MemSet, Halt
+	}));
+
+	// Everything after the superinstructions stays, for whoever jumps there.
+	ASSERT_EQ(3, res[0].c);
+	ASSERT_EQ(2, res[1].c);
+	// A superinstruction takes as long as what it fused.
+	ASSERT_EQ(gc_CountDown[4].ticks + gc_CountDown[5].ticks, res[4].ticks);
+	ASSERT_EQ(gc_CountDown[0].ticks + gc_CountDown[1].ticks + gc_CountDown[2].ticks, res[0].ticks);
+}
+
+FUSER_TEST(Fused_robots_run_in_lockstep)
+{
+	// Jumping into the middle of a MemSetRun too.
+	auto constexpr midRun {R"(
+		MemSet 15, 1
+		JumpTrue Mid
+		MemSet 0, 1
+		: Mid
+		MemSet 1, 2
+		MemSet 2, 3
+		MemSet 3, 4
+		MemSet 4, 5
+	)"_arobot};
+
+	for (auto const program : {std::span<Instruction const>{gc_CountDown}, std::span<Instruction const>{midRun}})
+	{
+		Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+		Robot plain{grid};
+		Robot fused{grid};
+		plain.LoadProgram(program);
+		fused.LoadProgram(program);
+		fused.SetFuser(GenerateTestingInstance());
+
+		// The fused robot gets through a whole run per tick, the plain one needs a tick for 
+		// each instruction of it.
+		for (std::size_t tick{}; !fused.IsHalted(); ++tick)
+		{
+			ASSERT_LT(tick, 1000);
+			auto const width {fused.GetProgram()[fused.GetCommandPtr()].GetWidth()};
+			fused.Tick();
+			for (std::size_t i{}; i < width; ++i)
+			{
+				plain.Tick();
+			}
+			ASSERT_EQ(plain.GetPos(), fused.GetPos()) << "On tick " << tick;
+			ASSERT_EQ(plain.GetCommandPtr(), fused.GetCommandPtr()) << "On tick " << tick;
+			for (std::size_t i{}; i < plain.MemorySize(); ++i)
+			{
+				ASSERT_EQ(plain.Deref(i), fused.Deref(i)) << "At address " << i << " on tick " << tick;
+			}
+		}
+		ASSERT_TRUE(plain.IsHalted());
+	}
+}
+
+FUSER_TEST(Profiles_of_fused_robots_match)
+{
+	Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+	Robot plain{grid};
+	Robot fused{grid};
+	for (auto* pRobot : {&plain, &fused})
+	{
+		pRobot->LoadProgram(gc_CountDown);
+		pRobot->ToggleProfiling(true);
+	}
+	fused.SetFuser(GenerateTestingInstance());
+	RunToHalt(plain);
+	RunToHalt(fused);
+
+	auto const& lhs {plain.GetProfiler()};
+	auto const& rhs {fused.GetProfiler()};
+	ASSERT_TRUE(std::ranges::equal(lhs.GetExecutionCounts(), rhs.GetExecutionCounts()));
+	auto const taken {[](Profiler::BranchCounts const& counts) { return std::pair {counts.taken, counts.notTaken}; }};
+	ASSERT_TRUE(std::ranges::equal(lhs.GetBranchCounts(), rhs.GetBranchCounts(), {}, taken, taken));
+	for (std::size_t i{}; i < Cmd::gc_CommandTypeCount; ++i)
+	{
+		auto const type {static_cast<CommandType>(i)};
+		ASSERT_EQ(lhs.GetTypeTotal(type), rhs.GetTypeTotal(type)) << "For type " << i;
+	}
+	ASSERT_EQ(0, rhs.GetTypeTotal(CommandType::CheckJumpTrue));
+}
+
+FUSER_TEST(Profile_picks_the_hot_runs)
+{
+	Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+	Robot robot{grid};
+	robot.LoadProgram(gc_CountDown);
+	robot.ToggleProfiling(true);
+	RunToHalt(robot);
+
+	auto const counts {robot.GetProfiler().GetExecutionCounts()};
+	ASSERT_EQ(5, counts[3]);
+	ASSERT_EQ(1, counts[0]);
+
+	// The loop runs a lot more than the MemSets at both ends.
+	using enum CommandType;
+	auto const fuser {Fuser::FromProfile(gc_CountDown, counts, 0.1)};
+	ASSERT_TRUE(fuser.IsEnabled(CheckJumpTrue));
+	ASSERT_TRUE(fuser.IsEnabled(OpJumpTrue));
+	ASSERT_FALSE(fuser.IsEnabled(MemSetRun));
+	ASSERT_FALSE(fuser.IsEnabled(CheckJumpFalse));
+
+	auto const res {fuser.Fuse(gc_CountDown)};
+	ASSERT_EQ(MemSet, res[0].type);
+	ASSERT_EQ(CheckJumpTrue, res[4].type);
+}
@@ -0,0 +1,217 @@
+#include "pch.h"
+#include <Arge/InputLog.hpp>
+
+#define INPUT_LOG_TEST(_testName) TEST_F(InputLogTests, _testName)
+
+using namespace Arge;
+
+class InputLogTests : public ::testing::Test
+{
+public:
+	// Neither can be copied or moved.
+	struct Input
+	{
+		Keyboard keyboard{};
+		Mouse mouse{};
+	};
+
+	static std::unique_ptr<Input> GenerateTestingInstance()
+	{
+		return std::make_unique<Input>();
+	}
+
+	static Event Key(SDL_Scancode scancode, bool bDown)
+	{
+		SDL_Event res{};
+		res.key.type = bDown ? SDL_KEYDOWN : SDL_KEYUP;
+		res.key.state = bDown ? SDL_PRESSED : SDL_RELEASED;
+		res.key.keysym.scancode = scancode;
+		return Event{res};
+	}
+
+	static Event Button(Uint8 button, bool bDown, std::int32_t x, std::int32_t y)
+	{
+		SDL_Event res{};
+		res.button.type = bDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+		res.button.state = bDown ? SDL_PRESSED : SDL_RELEASED;
+		res.button.button = button;
+		res.button.x = x;
+		res.button.y = y;
+		return Event{res};
+	}
+
+	static Event Motion(std::int32_t x, std::int32_t y)
+	{
+		SDL_Event res{};
+		res.motion.type = SDL_MOUSEMOTION;
+		res.motion.x = x;
+		res.motion.y = y;
+		return Event{res};
+	}
+
+	static Event Of(Uint32 type)
+	{
+		SDL_Event res{};
+		res.type = type;
+		return Event{res};
+	}
+
+	// What the Engine does with a frame's events, minus the window.
+	static InputSnapshot Feed(Input& input, std::span<Event const> events)
+	{
+		input.keyboard.BeginFrame();
+		input.mouse.BeginFrame();
+		for (auto const& ev : events)
+		{
+			auto const& raw {ev.GetRawAccess()};
+			switch (raw.type)
+			{
+			case SDL_KEYDOWN:
+			case SDL_KEYUP:           input.keyboard.OnKeyEvent(raw.key);   break;
+			case SDL_MOUSEMOTION:     input.mouse.OnMotionEvent(raw.motion); break;
+			case SDL_MOUSEBUTTONDOWN:
+			case SDL_MOUSEBUTTONUP:   input.mouse.OnButtonEvent(raw.button); break;
+			default: break;
+			}
+		}
+		return InputSnapshot::Take(input.mouse, input.keyboard);
+	}
+
+	// A short drag with the left button while holding shift, and some keys on the way.
+	static std::vector<std::vector<Event>> Session()
+	{
+		return {
+			{Motion(5, 5)},
+			{Key(SDL_SCANCODE_LSHIFT, true), Button(SDL_BUTTON_LEFT, true, 5, 5), Of(SDL_TEXTINPUT), Of(SDL_WINDOWEVENT)},
+			{Motion(10, 6), Key(SDL_SCANCODE_W, true), Motion(20, 8)},
+			{},
+			{Key(SDL_SCANCODE_LSHIFT, false), Motion(25, 9), Of(SDL_QUIT)},
+			{Button(SDL_BUTTON_LEFT, false, 25, 9), Key(SDL_SCANCODE_W, false)},
+		};
+	}
+};
+
+INPUT_LOG_TEST(Frames_survive_the_round_trip)
+{
+	auto const pInput {GenerateTestingInstance()};
+	std::stringstream log{};
+	InputLog::WriteHeader(log);
+	auto const session {Session()};
+	std::vector<InputSnapshot> snapshots{};
+	for (std::size_t i{}; i < session.size(); ++i)
+	{
+		snapshots.push_back(Feed(*pInput, session[i]));
+		InputLog::WriteFrame(log, 0.25f * static_cast<float>(i), session[i], snapshots.back());
+	}
+
+	InputLog::ReadHeader(log);
+	for (std::size_t i{}; i < session.size(); ++i)
+	{
+		auto const optFrame {InputLog::ReadFrame(log)};
+		ASSERT_TRUE(optFrame.has_value());
+		ASSERT_EQ(0.25f * static_cast<float>(i), optFrame->dt);
+		ASSERT_EQ(snapshots[i], optFrame->snapshot);
+
+		// Text input, the window and quitting are left out. The rest only keeps what the test
+		// events have in them anyways, the timestamps and ids are all zero.
+		std::vector<Event> expected{};
+		std::ranges::copy_if(session[i], std::back_inserter(expected),
+			[](Event const& ev) { return InputLog::IsRecorded(ev.GetRawAccess().type); });
+		ASSERT_EQ(expected.size(), optFrame->events.size());
+		for (std::size_t e{}; e < expected.size(); ++e)
+		{
+			ASSERT_EQ(0, std::memcmp(&expected[e].GetRawAccess(), &optFrame->events[e], sizeof(SDL_Event)));
+		}
+	}
+	ASSERT_EQ(std::nullopt, InputLog::ReadFrame(log));
+}
+
+INPUT_LOG_TEST(Events_only_take_what_they_need)
+{
+	std::stringstream log{};
+	InputLog::WriteFrame(log, 0.0f, std::vector {Motion(1, 2)}, {});
+	// The frame, the type, and the motion itself; a whole SDL_Event would be 56.
+	ASSERT_EQ(18 + 4 + 20, log.str().size());
+
+	auto const optFrame {InputLog::ReadFrame(log, 7)};
+	ASSERT_TRUE(optFrame.has_value());
+	ASSERT_EQ(7, optFrame->events[0].motion.windowID);
+	ASSERT_EQ(2, optFrame->events[0].motion.y);
+
+	// Events that are never recorded are not played back either.
+	std::stringstream odd{};
+	InputLog::WriteFrame(odd, 0.0f, std::vector {Motion(1, 2)}, {});
+	auto bytes {odd.str()};
+	auto const type {static_cast<Uint32>(SDL_WINDOWEVENT)};
+	std::memcpy(bytes.data() + 18, &type, sizeof(type));
+	std::stringstream window {bytes};
+	ASSERT_THROW(InputLog::ReadFrame(window), ArGenericError);
+}
+
+INPUT_LOG_TEST(Playing_back_gives_the_same_input)
+{
+	auto const pRecorded {GenerateTestingInstance()};
+	std::stringstream log{};
+	InputLog::WriteHeader(log);
+	for (auto const& events : Session())
+	{
+		InputLog::WriteFrame(log, 1.0f / 60.0f, events, Feed(*pRecorded, events));
+	}
+
+	auto const pPlayed {GenerateTestingInstance()};
+	InputLog::ReadHeader(log);
+	std::size_t frameCount{};
+	while (auto const optFrame {InputLog::ReadFrame(log)})
+	{
+		std::vector<Event> events{};
+		std::ranges::transform(optFrame->events, std::back_inserter(events), [](SDL_Event const& raw) { return Event{raw}; });
+		ASSERT_EQ(optFrame->snapshot, Feed(*pPlayed, events)) << "frame " << frameCount;
+		++frameCount;
+	}
+	ASSERT_EQ(6, frameCount);
+}
+
+INPUT_LOG_TEST(Held_keys_go_in_the_order_they_went_down)
+{
+	auto const pInput {GenerateTestingInstance()};
+	auto const held {[&pInput](std::vector<Event> const& events) { return Feed(*pInput, events).heldKeys; }};
+	ASSERT_EQ((std::vector {SDL_SCANCODE_LSHIFT, SDL_SCANCODE_A}),
+		held({Key(SDL_SCANCODE_LSHIFT, true), Key(SDL_SCANCODE_A, true), Key(SDL_SCANCODE_A, true)}));
+	ASSERT_EQ(std::vector {SDL_SCANCODE_A}, held({Key(SDL_SCANCODE_LSHIFT, false)}));
+	ASSERT_EQ(std::vector<SDL_Scancode>{}, held({Key(SDL_SCANCODE_A, false), Key(SDL_SCANCODE_B, false)}));
+
+	// Buttons go in a bit each.
+	ASSERT_EQ(0b101, Feed(*pInput, std::vector {Button(SDL_BUTTON_LEFT, true, 0, 0), Button(SDL_BUTTON_RIGHT, true, 0, 0)}).mouseButtons);
+}
+
+INPUT_LOG_TEST(Bad_logs_are_refused)
+{
+	std::stringstream notALog {"ARIMAGE\0\1\0\0\0"};
+	ASSERT_THROW(InputLog::ReadHeader(notALog), ArGenericError);
+
+	std::stringstream empty{};
+	ASSERT_THROW(InputLog::ReadHeader(empty), ArGenericError);
+
+	std::stringstream future{};
+	future.write(InputLog::Magic.data(), InputLog::Magic.size());
+	auto const version {InputLog::Version + 1};
+	future.write(reinterpret_cast<char const*>(&version), sizeof(version));
+	ASSERT_THROW(InputLog::ReadHeader(future), ArGenericError);
+
+	// A frame that promises an event and stops.
+	std::stringstream cut{};
+	InputLog::WriteHeader(cut);
+	InputLog::WriteFrame(cut, 0.0f, std::vector {Motion(1, 2)}, {});
+	auto bytes {cut.str()};
+	bytes.resize(bytes.size() - 10);
+	std::stringstream cutOff {bytes};
+	InputLog::ReadHeader(cutOff);
+	ASSERT_THROW(InputLog::ReadFrame(cutOff), ArGenericError);
+
+	// Nor are they written with more held keys than the count fits.
+	InputSnapshot tooMany{};
+	tooMany.heldKeys.assign(256, SDL_SCANCODE_A);
+	std::stringstream full{};
+	ASSERT_THROW(InputLog::WriteFrame(full, 0.0f, std::vector<Event>{}, tooMany), ArGenericError);
+	ASSERT_TRUE(full.str().empty());
+}
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include <Arge/Keyboard.hpp>
+#include <Arge/Mouse.hpp>
+
+#define INPUT_TEST(_testName) TEST_F(InputTests, _testName)
+
+using Arge::Keycode;
+
+class InputTests : public ::testing::Test
+{
+public:
+	// Neither can be copied or moved.
+	static std::unique_ptr<Arge::Keyboard> GenerateTestingInstance()
+	{
+		return std::make_unique<Arge::Keyboard>();
+	}
+
+	static SDL_KeyboardEvent Key(SDL_Keycode sym, SDL_Scancode scancode, bool bDown, bool bRepeat = false)
+	{
+		SDL_KeyboardEvent res{};
+		res.type = bDown ? SDL_KEYDOWN : SDL_KEYUP;
+		res.state = bDown ? SDL_PRESSED : SDL_RELEASED;
+		res.repeat = bRepeat;
+		res.keysym.sym = sym;
+		res.keysym.scancode = scancode;
+		return res;
+	}
+
+	static SDL_MouseButtonEvent Button(Uint8 button, bool bDown, std::int32_t x, std::int32_t y)
+	{
+		SDL_MouseButtonEvent res{};
+		res.type = bDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+		res.state = bDown ? SDL_PRESSED : SDL_RELEASED;
+		res.button = button;
+		res.x = x;
+		res.y = y;
+		return res;
+	}
+};
+
+INPUT_TEST(Keys_follow_their_events)
+{
+	auto const pKeyboard {GenerateTestingInstance()};
+	auto& keyboard {*pKeyboard};
+	// Looked up every time, like a game does every frame; until RefreshKeymap or an event says
+	// where a character key is, it is just not down.
+	auto const escape {[&keyboard] { return keyboard[Keycode::Escape]; }};
+	ASSERT_FALSE(escape().IsDown());
+
+	keyboard.BeginFrame();
+	keyboard.OnKeyEvent(Key(SDLK_ESCAPE, SDL_SCANCODE_ESCAPE, true));
+	ASSERT_TRUE(escape().IsDown());
+	ASSERT_TRUE(escape().IsPressed());
+
+	// Held down: repeats change nothing, and the press only lasts a frame.
+	keyboard.BeginFrame();
+	keyboard.OnKeyEvent(Key(SDLK_ESCAPE, SDL_SCANCODE_ESCAPE, true, true));
+	ASSERT_TRUE(escape().IsDown());
+	ASSERT_FALSE(escape().IsPressed());
+
+	keyboard.BeginFrame();
+	keyboard.OnKeyEvent(Key(SDLK_ESCAPE, SDL_SCANCODE_ESCAPE, false));
+	ASSERT_FALSE(escape().IsDown());
+	ASSERT_TRUE(escape().IsJustReleased());
+
+	keyboard.BeginFrame();
+	ASSERT_FALSE(escape().IsJustReleased());
+	ASSERT_FALSE(keyboard[Keycode::Return].IsDown());
+}
+
+INPUT_TEST(Quick_taps_are_not_lost)
+{
+	auto const pKeyboard {GenerateTestingInstance()};
+	auto& keyboard {*pKeyboard};
+	keyboard.BeginFrame();
+	keyboard.OnKeyEvent(Key(SDLK_SPACE, SDL_SCANCODE_SPACE, true));
+	keyboard.OnKeyEvent(Key(SDLK_SPACE, SDL_SCANCODE_SPACE, false));
+
+	auto const& space {keyboard[Keycode::Space]};
+	ASSERT_FALSE(space.IsDown());
+	ASSERT_TRUE(space.IsPressed());
+	ASSERT_TRUE(space.IsJustReleased());
+}
+
+INPUT_TEST(Characters_go_by_where_the_layout_put_them)
+{
+	auto const pKeyboard {GenerateTestingInstance()};
+	auto& keyboard {*pKeyboard};
+	// On an AZERTY keyboard, 'a' is where QWERTY has its 'q'.
+	keyboard.OnKeyEvent(Key('a', SDL_SCANCODE_Q, true));
+	ASSERT_TRUE(keyboard[static_cast<Keycode>('a')].IsDown());
+	ASSERT_FALSE(keyboard[static_cast<Keycode>('q')].IsDown());
+}
+
+INPUT_TEST(Mouse_buttons_and_position)
+{
+	Arge::Mouse mouse{};
+	mouse.BeginFrame();
+	mouse.OnButtonEvent(Button(SDL_BUTTON_LEFT, true, 10, 20));
+	ASSERT_TRUE(mouse.left.IsPressed());
+	ASSERT_FALSE(mouse.right.IsDown());
+	ASSERT_EQ(10.0f, mouse.pos.x);
+
+	SDL_MouseMotionEvent motion{};
+	motion.x = 30;
+	motion.y = 40;
+	mouse.BeginFrame();
+	mouse.OnMotionEvent(motion);
+	ASSERT_TRUE(mouse.left.IsDown());
+	ASSERT_FALSE(mouse.left.IsPressed());
+	ASSERT_EQ(40.0f, mouse.pos.y);
+
+	mouse.BeginFrame();
+	mouse.OnButtonEvent(Button(SDL_BUTTON_LEFT, false, 30, 40));
+	ASSERT_TRUE(mouse.left.IsJustReleased());
+	ASSERT_FALSE(mouse.left.IsDown());
+}
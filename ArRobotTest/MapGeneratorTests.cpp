@@ -0,0 +1,160 @@
+#include "pch.h"
+#include <MapGenerator.hpp>
+#include <PlayField.hpp>
+
+#define MAP_GENERATOR_TEST(_testName) TEST_F(MapGeneratorTests, _testName)
+
+using namespace ArRobot;
+
+class MapGeneratorTests : public ::testing::Test
+{
+public:
+	static MapGenerator GenerateTestingInstance(std::size_t threadCount = 3)
+	{
+		return MapGenerator {1234, threadCount};
+	}
+
+	static Arge::Grid<BlockType> MakeGrid(std::size_t width = 101, std::size_t height = 64)
+	{
+		return Arge::Grid<BlockType> {width, height, 1.0f, 1.0f};
+	}
+
+	static std::vector<BlockType> Cells(Arge::Grid<BlockType> const& grid)
+	{
+		return std::vector<BlockType>(grid.begin(), grid.end());
+	}
+};
+
+MAP_GENERATOR_TEST(Mazes_are_perfect)
+{
+	auto grid {MakeGrid()};
+	GenerateTestingInstance().Maze(grid);
+
+	// 50 x 31 rooms, and a tree of them has one passage less than it has rooms.
+	auto constexpr RoomCount {50 * 31};
+	ASSERT_EQ(2 * RoomCount - 1, grid.GetSize() - grid.Count(BlockType::Wall, 0, 0, 101, 64));
+	for (std::size_t x{}; x < 101; ++x)
+	{
+		ASSERT_EQ(BlockType::Wall, grid.At(x, 0));
+		ASSERT_EQ(BlockType::Wall, grid.At(x, 62));
+		ASSERT_EQ(BlockType::Wall, grid.At(x, 63));
+	}
+
+	// Every room can be reached from the first one, walking straight only.
+	std::vector<bool> seen(grid.GetSize());
+	std::vector<std::pair<std::size_t, std::size_t>> todo {{1, 1}};
+	seen[1 + 101] = true;
+	std::size_t reached{};
+	while (!todo.empty())
+	{
+		auto const [x, y] {todo.back()};
+		todo.pop_back();
+		reached += x % 2 == 1 && y % 2 == 1;
+		for (auto const [nx, ny] : {std::pair {x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}})
+		{
+			if (grid.At(nx, ny) != BlockType::Wall && !seen[nx + ny * 101])
+			{
+				seen[nx + ny * 101] = true;
+				todo.push_back({nx, ny});
+			}
+		}
+	}
+	ASSERT_EQ(RoomCount, reached);
+}
+
+MAP_GENERATOR_TEST(Same_seed_same_map_on_any_number_of_threads)
+{
+	auto lhs {MakeGrid(300, 257)};
+	auto rhs {MakeGrid(300, 257)};
+	for (auto* const pGrid : {&lhs, &rhs})
+	{
+		auto const generator {GenerateTestingInstance(pGrid == &lhs ? 1 : 7)};
+		generator.Caves(*pGrid);
+		generator.Scatter(*pGrid, 0.05f, 0.02f);
+	}
+	ASSERT_EQ(Cells(lhs), Cells(rhs));
+
+	auto other {MakeGrid(300, 257)};
+	MapGenerator{4321}.Caves(other);
+	ASSERT_NE(Cells(lhs), Cells(other));
+
+	auto maze {MakeGrid(300, 257)};
+	auto otherMaze {MakeGrid(300, 257)};
+	GenerateTestingInstance(1).Maze(maze);
+	GenerateTestingInstance(5).Maze(otherMaze);
+	ASSERT_EQ(Cells(maze), Cells(otherMaze));
+}
+
+MAP_GENERATOR_TEST(Caves_settle_into_walls_and_open_space)
+{
+	auto const generator {GenerateTestingInstance()};
+	auto grid {MakeGrid(200, 200)};
+	generator.Caves(grid, 1.0f);
+	ASSERT_EQ(grid.GetSize(), grid.Count(BlockType::Wall, 0, 0, 200, 200));
+
+	generator.Caves(grid, 0.45f, 5);
+	auto const walls {grid.Count(BlockType::Wall, 0, 0, 200, 200)};
+	ASSERT_GT(walls, grid.GetSize() / 5);
+	ASSERT_LT(walls, grid.GetSize() * 4 / 5);
+	// Outside counts as Wall, so corners always close up.
+	ASSERT_EQ(BlockType::Wall, grid.At(0, 0));
+	ASSERT_EQ(BlockType::Wall, grid.At(199, 199));
+}
+
+MAP_GENERATOR_TEST(Scatter_only_lands_on_nothing)
+{
+	auto grid {MakeGrid(200, 200)};
+	auto const generator {GenerateTestingInstance()};
+	generator.Maze(grid);
+	auto const before {Cells(grid)};
+	generator.Scatter(grid, 0.1f, 0.1f);
+
+	std::size_t items{};
+	std::size_t pits{};
+	auto const after {Cells(grid)};
+	for (std::size_t i{}; i < after.size(); ++i)
+	{
+		if (before[i] != BlockType::Nothing)
+		{
+			ASSERT_EQ(before[i], after[i]);
+		}
+		items += after[i] == BlockType::Item;
+		pits += after[i] == BlockType::Pit;
+	}
+
+	// About a tenth of the 19'601 open cells each.
+	ASSERT_NEAR(1'960, items, 300);
+	ASSERT_NEAR(1'960, pits, 300);
+}
+
+MAP_GENERATOR_TEST(Play_fields_take_generated_maps)
+{
+	PlayField playField{41, 41};
+	playField.AddRobot(1, 1);
+	ASSERT_EQ(std::nullopt, playField.GetPathfinder().StepToward(BlockType::Item, 1, 1));
+
+	playField.EditGrid([](Arge::Grid<BlockType>& grid) {
+		auto const generator {GenerateTestingInstance()};
+		generator.Maze(grid);
+		generator.Scatter(grid, 0.01f, 0.0f);
+	});
+	ASSERT_GT(playField.GetGrid().Count(BlockType::Item, 0, 0, 41, 41), 0);
+	ASSERT_NE(std::nullopt, playField.GetPathfinder().StepToward(BlockType::Item, 1, 1));
+}
+
+// Not run by default; --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* to compare.
+MAP_GENERATOR_TEST(DISABLED_Benchmark_cells_per_second)
+{
+	auto grid {MakeGrid(4096, 4096)};
+	auto const generator {GenerateTestingInstance(MapGenerator::DefaultThreadCount())};
+	auto const time {[&grid](std::string_view what, auto&& doWhat) {
+		auto const begin {std::chrono::steady_clock::now()};
+		doWhat();
+		std::chrono::duration<double> const took {std::chrono::steady_clock::now() - begin};
+		std::cout << std::format("{:<12} {:>8.1f}M cells/s\n", what, static_cast<double>(grid.GetSize()) / took.count() / 1e6);
+	}};
+
+	time("Maze", [&] { generator.Maze(grid); });
+	time("Caves", [&] { generator.Caves(grid); });
+	time("Scatter", [&] { generator.Scatter(grid, 0.05f, 0.05f); });
+}
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include <MemoryVerifier.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define MEMORY_VERIFIER_TEST(_testName) TEST_F(MemoryVerifierTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class MemoryVerifierTests : public ::testing::Test
+{
+public:
+	static MemoryVerifier GenerateTestingInstance(std::size_t memorySize = Cmd::gc_DefaultMemorySize)
+	{
+		return MemoryVerifier {memorySize};
+	}
+};
+
+MEMORY_VERIFIER_TEST(Accepts_addresses_in_bounds)
+{
+	auto constexpr program {R"(
+		MemSet 0, 1
+		MemCopy 14, 0
+		Add 15, 14
+		MemPrint 15
+	)"_arobot};
+
+	ASSERT_NO_THROW(GenerateTestingInstance().Verify(program));
+}
+
+MEMORY_VERIFIER_TEST(Names_the_offending_instruction)
+{
+	auto const verifier {GenerateTestingInstance()};
+	auto const messageOf {[&verifier](std::string_view code) {
+		try
+		{
+			verifier.Verify(Asm::Assemble(code));
+		}
+		catch (ParseError const& err)
+		{
+			return err.GetMessage();
+		}
+		return std::string{};
+	}};
+
+	ASSERT_EQ("Instruction 1 writes to address 16, but the robot only has 16 memory cells",
+		messageOf("MemSet 0, 1\nMemSet 16, 1"));
+	ASSERT_EQ("Instruction 0 reads from address 99, but the robot only has 16 memory cells",
+		messageOf("MemCopy 0, 99"));
+	ASSERT_EQ("Instruction 0 reads from address 20, but the robot only has 16 memory cells",
+		messageOf("Sub 0, 20"));
+	ASSERT_EQ("Instruction 0 prints address 16, but the robot only has 16 memory cells",
+		messageOf("MemPrint 16"));
+}
+
+MEMORY_VERIFIER_TEST(Memory_size_is_per_program)
+{
+	auto constexpr program {R"(
+		MemSet 31, 7
+		MemCopy 20, 31
+	)"_arobot};
+
+	ASSERT_THROW(GenerateTestingInstance().Verify(program), ParseError);
+	ASSERT_NO_THROW(GenerateTestingInstance(32).Verify(program));
+
+	// The flag has to fit.
+	ASSERT_THROW(GenerateTestingInstance(Cmd::gc_FlagAddress), GenericError);
+
+	Arge::Grid<BlockType> grid{4, 4, 1.0f, 1.0f};
+	Robot robot{grid};
+	ASSERT_THROW(robot.LoadProgram(program), ParseError);
+	robot.LoadProgram(program, 32);
+	ASSERT_EQ(32, robot.MemorySize());
+	robot.Tick();
+	robot.Tick();
+	ASSERT_EQ(7, robot.Deref(20));
+
+	// Shrinking it under a loaded program does not work either.
+	ASSERT_THROW(robot.SetMemorySize(16), ParseError);
+}
@@ -72,4 +72,5 @@ NUM_PARSER_TEST(Offset_returned)
 	ASSERT_EQ(4, numPar.Parse("1234*      1234").offset);
 	ASSERT_EQ(4, numPar.Parse("1234\n     1234").offset);
 	ASSERT_EQ(4, numPar.Parse("0xFF\n     1234").offset);
+	ASSERT_EQ(3, numPar.Parse("-12, 0").offset);
 }
\ No newline at end of file
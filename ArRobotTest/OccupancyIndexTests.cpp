@@ -0,0 +1,132 @@
+#include "pch.h"
+#include <OccupancyIndex.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define OCCUPANCY_TEST(_testName) TEST_F(OccupancyIndexTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class OccupancyIndexTests : public ::testing::Test
+{
+public:
+	static OccupancyIndex GenerateTestingInstance()
+	{
+		// Wider than a word, so rows take more than one.
+		return OccupancyIndex {100, 10};
+	}
+};
+
+OCCUPANCY_TEST(Place_move_and_remove)
+{
+	auto index {GenerateTestingInstance()};
+	index.Place(7, 3, 4);
+	ASSERT_TRUE(index.IsOccupied(3, 4));
+	ASSERT_EQ(7, index.RobotAt(3, 4));
+	ASSERT_FALSE(index.RobotAt(4, 3));
+	ASSERT_FALSE(index.IsOccupied(-1, 4));
+	ASSERT_THROW(index.Place(8, 3, 4), GenericError);
+	ASSERT_THROW(index.Place(8, 100, 0), GenericError);
+
+	index.Place(8, 70, 4);
+	ASSERT_FALSE(index.TryMove(3, 4, 70, 4));
+	ASSERT_TRUE(index.TryMove(3, 4, 64, 9));
+	ASSERT_FALSE(index.IsOccupied(3, 4));
+	ASSERT_EQ(7, index.RobotAt(64, 9));
+	ASSERT_EQ(2, index.GetCount());
+
+	index.Remove(64, 9);
+	ASSERT_FALSE(index.IsOccupied(64, 9));
+	ASSERT_EQ(1, index.GetCount());
+}
+
+OCCUPANCY_TEST(Range_queries)
+{
+	auto index {GenerateTestingInstance()};
+	std::vector<std::pair<std::int32_t, std::int32_t>> const cells {{0, 0}, {63, 1}, {64, 1}, {99, 1}, {50, 9}};
+	for (std::size_t i{}; i < cells.size(); ++i)
+	{
+		index.Place(static_cast<OccupancyIndex::RobotId>(i), cells[i].first, cells[i].second);
+	}
+
+	ASSERT_EQ(5, index.CountInRect(0, 0, 100, 10));
+	ASSERT_EQ(5, index.CountInRect(-50, -50, 500, 500));
+	ASSERT_EQ(2, index.CountInRect(63, 0, 2, 2));
+	ASSERT_EQ(1, index.CountInRect(64, 1, 35, 1));
+	ASSERT_EQ(0, index.CountInRect(1, 0, 62, 9));
+	ASSERT_EQ(0, index.CountInRect(0, 0, 0, 10));
+
+	std::vector<OccupancyIndex::RobotId> found{};
+	index.ForEachInRect(50, 0, 50, 10, [&](OccupancyIndex::RobotId id, std::int32_t x, std::int32_t y) {
+		ASSERT_EQ(cells[id], (std::pair {x, y}));
+		found.push_back(id);
+	});
+	ASSERT_EQ((std::vector<OccupancyIndex::RobotId> {1, 2, 3, 4}), found);
+}
+
+OCCUPANCY_TEST(Robots_bump_into_each_other)
+{
+	auto constexpr program {R"(
+		Check 1, 0, Robot
+		JumpTrue Blocked
+		Halt
+		: Blocked
+		Move 1, 0
+	)"_arobot};
+
+	Arge::Grid<BlockType> grid{5, 5, 1.0f, 1.0f};
+	auto index {OccupancyIndex {5, 5}};
+	Robot lhs{grid, 1, 1};
+	Robot rhs{grid, 2, 1};
+	lhs.SetOccupancy(&index, 0);
+	rhs.SetOccupancy(&index, 1);
+	ASSERT_THROW(rhs.SetPosition(1, 1), GenericError);
+	ASSERT_EQ(1, index.RobotAt(2, 1));
+
+	lhs.LoadProgram(program);
+	rhs.LoadProgram(program);
+	for (std::size_t i{}; i < 3; ++i)
+	{
+		lhs.Tick();
+		rhs.Tick();
+	}
+
+	// Only the one on the left saw someone, and did not get to move.
+	ASSERT_TRUE(rhs.IsHalted());
+	ASSERT_EQ(FaultCode::BumpedIntoRobot, lhs.GetFault().code);
+	ASSERT_EQ(1, lhs.GetFault().operands[0]);
+	ASSERT_EQ((std::pair {1, 1}), lhs.GetPos());
+
+	rhs.SetOccupancy(nullptr, 1);
+	ASSERT_FALSE(index.IsOccupied(2, 1));
+	lhs.LoadProgram(program);
+	lhs.Tick();
+	lhs.Tick();
+	ASSERT_TRUE(lhs.IsHalted());
+}
+
+OCCUPANCY_TEST(Robots_do_not_see_themselves)
+{
+	auto constexpr program {R"(
+		Check 0, 0, Robot
+		MemCopy 0, 15
+		Check 1, 0, Robot
+		MemCopy 1, 15
+	)"_arobot};
+
+	Arge::Grid<BlockType> grid{5, 5, 1.0f, 1.0f};
+	auto index {OccupancyIndex {5, 5}};
+	Robot lhs{grid, 1, 1};
+	Robot rhs{grid, 2, 1};
+	lhs.SetOccupancy(&index, 0);
+	rhs.SetOccupancy(&index, 1);
+	lhs.LoadProgram(program);
+	for (std::size_t i{}; i < 4; ++i)
+	{
+		lhs.Tick();
+	}
+
+	ASSERT_EQ(0, lhs.Deref(0));
+	ASSERT_EQ(1, lhs.Deref(1));
+}
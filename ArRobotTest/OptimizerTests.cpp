@@ -0,0 +1,306 @@
+#include "pch.h"
+#include <Optimizer.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define OPTIMIZER_TEST(_testName) TEST_F(OptimizerTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class OptimizerTests : public ::testing::Test
+{
+public:
+	static Optimizer GenerateTestingInstance(bool bStrict)
+	{
+		return Optimizer {bStrict};
+	}
+
+	// Everything someone watching the grid could tell about a robot.
+	struct Snapshot
+	{
+		std::pair<std::int32_t, std::int32_t> pos;
+		bool bItem;
+		bool bHalted;
+		bool bCrashed;
+
+		bool operator==(Snapshot const&) const = default;
+	};
+
+	class Runner
+	{
+	public:
+		explicit Runner(std::span<Instruction const> program)
+		{
+			m_Grid.At(5, 3) = BlockType::Wall;
+			m_Grid.At(3, 5) = BlockType::Wall;
+			m_Grid.At(2, 4) = BlockType::Item;
+			m_Robot.LoadProgram(program);
+		}
+
+		bool IsDone() const
+		{
+			return m_Last.bHalted || m_Last.bCrashed;
+		}
+
+		Snapshot Tick()
+		{
+			if (!IsDone())
+			{
+				m_Last.bCrashed = m_Robot.Tick() != FaultCode::None;
+				m_Last.pos     = m_Robot.GetPos();
+				m_Last.bItem   = m_Robot.IsCarryingItem();
+				m_Last.bHalted = m_Robot.IsHalted();
+			}
+			return m_Last;
+		}
+
+		// Only keeps the ticks where something changed.
+		std::vector<Snapshot> Trace(std::size_t ticks)
+		{
+			std::vector<Snapshot> res{Tick()};
+			for (std::size_t i{1}; i < ticks && !IsDone(); ++i)
+			{
+				if (auto const snap {Tick()}; snap != res.back())
+				{
+					res.push_back(snap);
+				}
+			}
+			return res;
+		}
+
+	private:
+		Arge::Grid<BlockType> m_Grid{8, 8, 1.0f, 1.0f};
+		Robot m_Robot{m_Grid, 4, 4};
+		Snapshot m_Last{};
+	};
+
+	// Strict mode: the two robots must be indistinguishable on every single tick.
+	static void VerifyLockstep(std::span<Instruction const> original, std::size_t ticks)
+	{
+		auto const optimized {GenerateTestingInstance(true).Optimize(original)};
+		ASSERT_EQ(original.size(), optimized.size());
+
+		Runner lhs{original};
+		Runner rhs{optimized};
+		for (std::size_t i{}; i < ticks; ++i)
+		{
+			ASSERT_EQ(lhs.Tick(), rhs.Tick()) << "Diverged on tick " << i;
+		}
+	}
+
+	// Otherwise the optimized robot may skip ticks, but must never do something the original
+	// would not have done, and has to end up in the same place.
+	static void VerifyNoNewBehaviour(std::span<Instruction const> original, std::size_t ticks)
+	{
+		auto const optimized {GenerateTestingInstance(false).Optimize(original)};
+		ASSERT_LE(optimized.size(), original.size());
+
+		// The optimized program never needs more ticks to get anywhere, but may need far fewer.
+		auto const optTrace {Runner{optimized}.Trace(ticks)};
+		auto const origTrace {Runner{original}.Trace(ticks * (original.size() + 1))};
+
+		auto it {origTrace.begin()};
+		for (auto const& snap : optTrace)
+		{
+			it = std::ranges::find(it, origTrace.end(), snap);
+			ASSERT_NE(origTrace.end(), it) << "The optimized robot did something new";
+		}
+
+		if (optTrace.back().bHalted || optTrace.back().bCrashed)
+		{
+			ASSERT_EQ(origTrace.back(), optTrace.back());
+		}
+	}
+
+	static std::vector<Instruction> GenerateRandomProgram(std::mt19937& rng, std::size_t size)
+	{
+		using enum CommandType;
+		auto const pick {[&rng](std::int32_t min, std::int32_t max) {
+			return std::uniform_int_distribution<std::int32_t>{min, max}(rng);
+		}};
+
+		// Few addresses, so writes keep stepping on each other. 15 is the flag.
+		auto const addr {[&pick] { return pick(0, 1) ? 15 : pick(0, 2); }};
+		auto const target {[&pick, size] { return pick(0, static_cast<std::int32_t>(size)); }};
+
+		std::vector<Instruction> res{};
+		for (std::size_t i{}; i < size; ++i)
+		{
+			switch (pick(0, 10))
+			{
+			case 0:  res.push_back({Move, 10, pick(-1, 1), pick(-1, 1)});           break;
+			case 1:  res.push_back({DoNothing, 1});                                  break;
+			case 2:  res.push_back({CheckDir, 2, pick(-1, 1), pick(-1, 1), pick(0, 3)}); break;
+			case 3:  res.push_back({Jump, 1, target()});                             break;
+			case 4:  res.push_back({JumpTrue, 1, target()});                         break;
+			case 5:  res.push_back({JumpFalse, 1, target()});                        break;
+			case 6:  res.push_back({MemSet, 2, addr(), pick(0, 2)});                 break;
+			case 7:  res.push_back({MemCopy, 2, addr(), addr()});                    break;
+			case 8:  res.push_back({BinaryOp, 2, static_cast<std::int32_t>(OpCode::Sub), addr(), addr()}); break;
+			case 9:  res.push_back({PickUp, 5});                                     break;
+			default: res.push_back({Drop, 5});                                       break;
+			}
+		}
+		res.push_back({Halt, 1});
+		return res;
+	}
+};
+
+OPTIMIZER_TEST(Strict_mode_only_rewrites_in_place)
+{
+	auto constexpr program {R"(
+		Jump Next
+		: Next
+		MemSet 0, 1
+		MemSet 0, 2
+		MemCopy 1, 1
+		Check 1, 0, Wall
+		Move 1, 0
+		Move 1, 0
+	)"_arobot};
+
+	auto optimizer {GenerateTestingInstance(true)};
+	auto const res {optimizer.Optimize(program)};
+	ASSERT_EQ(program.size(), res.size());
+	ASSERT_EQ(4, optimizer.GetRewriteCount());
+
+	using enum CommandType;
+	auto const types {res | std::views::transform(&Instruction::type)};
+	ASSERT_TRUE(std::ranges::equal(types,
+		std::array {DoNothing, DoNothing, MemSet, DoNothing, DoNothing, Move, Move, Halt}));
+
+	// The ticks stay, in case cooldowns come back.
+	ASSERT_EQ(program[1].ticks, res[1].ticks);
+}
+
+OPTIMIZER_TEST(Loose_mode_removes_and_fuses)
+{
+	auto constexpr program {R"(
+		: Start
+		Move 1, 0
+		Move 1, 0
+		Move 0, -1
+		Check 1, 0, Wall
+		JumpTrue Hop
+		DoNothing
+		Jump Start
+		: Hop
+		Jump Start
+	)"_arobot};
+
+	auto const res {GenerateTestingInstance(false).Optimize(program)};
+
+	using enum CommandType;
+	auto const types {res | std::views::transform(&Instruction::type)};
+	ASSERT_TRUE(std::ranges::equal(types, std::array {Move, Move, CheckDir, JumpTrue, Jump, Jump, Halt}));
+	ASSERT_EQ(2, res[0].a);
+	ASSERT_EQ(0, res[0].b);
+	ASSERT_EQ(-1, res[1].b);
+	// Hop only jumps back to Start, so JumpTrue goes there directly.
+	ASSERT_EQ(0, res[3].a);
+}
+
+OPTIMIZER_TEST(Turns_are_not_fused)
+{
+	auto constexpr program {R"(
+		Move 1, 0
+		Move 0, 1
+		Move 0, 1
+	)"_arobot};
+
+	auto const res {GenerateTestingInstance(false).Optimize(program)};
+	ASSERT_EQ(3, res.size());
+	ASSERT_EQ((std::pair {1, 0}), (std::pair {res[0].a, res[0].b}));
+	ASSERT_EQ((std::pair {0, 2}), (std::pair {res[1].a, res[1].b}));
+
+	// Someone on the corner: going around it bumps into them, so a diagonal would have gone
+	// right past.
+	for (auto const candidate : {std::span<Instruction const> {program}, std::span<Instruction const> {res}})
+	{
+		Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+		auto index {OccupancyIndex {8, 8}};
+		Robot robot{grid, 4, 4};
+		Robot blocker{grid, 5, 4};
+		robot.SetOccupancy(&index, 0);
+		blocker.SetOccupancy(&index, 1);
+		robot.LoadProgram(candidate);
+
+		ASSERT_EQ(FaultCode::BumpedIntoRobot, robot.Tick());
+		ASSERT_EQ((std::pair {4, 4}), robot.GetPos());
+	}
+}
+
+OPTIMIZER_TEST(Robots_only_optimize_when_asked)
+{
+	// Nothing reads mem[15] again, but Deref still can.
+	Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+	Robot plain{grid};
+	Robot optimized{grid};
+	optimized.ToggleOptimizing(true);
+	for (auto* pRobot : {&plain, &optimized})
+	{
+		pRobot->AddCommand(Command::MakeMemSet(15, 7));
+		pRobot->AddCommand(Command::MakeHalt());
+		pRobot->Tick();
+	}
+	ASSERT_EQ(7, plain.Deref(15));
+	ASSERT_EQ(0, optimized.Deref(15));
+}
+
+OPTIMIZER_TEST(Lockstep_on_hand_written_programs)
+{
+	auto constexpr wallFollower {R"(
+		: Start
+		Move 1, 0
+		: RightWallCheck
+		Check 1, 0, Wall
+		JumpFalse Start
+		Check 0, 1, Wall
+		JumpFalse NoWall
+		Halt
+		: NoWall
+		Move 0, 1
+		Jump RightWallCheck
+	)"_arobot};
+
+	auto constexpr collector {R"(
+		MemSet 0, 3
+		MemSet 0, 2
+		MemSet 1, 1
+		: Loop
+		Check -1, 0, Item
+		Jump Skip
+		: Skip
+		JumpFalse Walk
+		Move -1, 0
+		PickUp
+		Halt
+		: Walk
+		Move -1, 0
+		Move 0, 0
+		Sub 0, 1
+		MemCopy 15, 0
+		JumpTrue Loop
+	)"_arobot};
+
+	VerifyLockstep(wallFollower, 100);
+	VerifyNoNewBehaviour(wallFollower, 100);
+	VerifyLockstep(collector, 100);
+	VerifyNoNewBehaviour(collector, 100);
+}
+
+OPTIMIZER_TEST(Lockstep_on_random_programs)
+{
+	std::mt19937 rng{12345};
+	for (std::size_t i{}; i < 500; ++i)
+	{
+		auto const program {GenerateRandomProgram(rng, 4 + i % 20)};
+		VerifyLockstep(program, 200);
+		VerifyNoNewBehaviour(program, 200);
+		if (HasFatalFailure())
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#include "pch.h"
+#include <BlockType.hpp>
+#include <Arge/Arge.hpp>
+
+#define PACKED_GRID_TEST(_testName) TEST_F(PackedGridTests, _testName)
+
+using namespace ArRobot;
+
+class PackedGridTests : public ::testing::Test
+{
+public:
+	// Wider than a word, and not a multiple of one either.
+	static Arge::Grid<BlockType> GenerateTestingInstance(std::size_t width = 70, std::size_t height = 9)
+	{
+		return Arge::Grid<BlockType> {width, height, 1.0f, 1.0f};
+	}
+
+	static void Scatter(Arge::Grid<BlockType>& grid, std::uint32_t seed)
+	{
+		std::mt19937 rng{seed};
+		std::uniform_int_distribution<std::int32_t> pick{0, 15};
+		for (std::size_t i{}; i < grid.GetSize(); ++i)
+		{
+			// Mostly empty, like a real field.
+			auto const roll {pick(rng)};
+			grid.AtIndex(i) = roll < 4 ? static_cast<BlockType>(roll) : BlockType::Nothing;
+		}
+	}
+};
+
+PACKED_GRID_TEST(Reads_back_what_was_written)
+{
+	auto grid {GenerateTestingInstance()};
+	grid.At(0, 0) = BlockType::Wall;
+	grid.At(31, 0) = BlockType::Item;
+	grid.At(32, 0) = BlockType::Pit;
+	grid.At(69, 8) = BlockType::Item;
+	grid.At(1, 0) = grid.At(31, 0);
+
+	ASSERT_EQ(BlockType::Wall, grid.At(0, 0));
+	ASSERT_EQ(BlockType::Item, grid.At(1, 0));
+	ASSERT_EQ(BlockType::Item, grid.At(31, 0));
+	ASSERT_EQ(BlockType::Pit, grid.At(32, 0));
+	ASSERT_EQ(BlockType::Nothing, grid.At(33, 0));
+	ASSERT_EQ(BlockType::Item, std::as_const(grid).AtIndex(69 + 8 * 70));
+	ASSERT_EQ(5, std::ranges::count_if(grid, [](BlockType block) { return block != BlockType::Nothing; }));
+}
+
+PACKED_GRID_TEST(Huge_grids_are_small)
+{
+	auto const grid {GenerateTestingInstance(10'000, 10'000)};
+	ASSERT_LE(grid.GetMemoryUsage(), 25'100'000);
+}
+
+PACKED_GRID_TEST(Count_matches_a_plain_loop)
+{
+	auto grid {GenerateTestingInstance()};
+	Scatter(grid, 37);
+
+	auto const naive {[&grid](BlockType block, std::size_t x, std::size_t y, std::size_t w, std::size_t h) {
+		std::size_t res{};
+		for (auto j {y}; j < std::min(y + h, grid.GetHeight()); ++j)
+		{
+			for (auto i {x}; i < std::min(x + w, grid.GetWidth()); ++i)
+			{
+				res += grid.At(i, j) == block;
+			}
+		}
+		return res;
+	}};
+
+	for (auto const block : {BlockType::Nothing, BlockType::Wall, BlockType::Pit, BlockType::Item})
+	{
+		ASSERT_EQ(naive(block, 0, 0, 70, 9), grid.Count(block, 0, 0, 70, 9));
+		ASSERT_EQ(naive(block, 30, 2, 5, 3), grid.Count(block, 30, 2, 5, 3));
+		ASSERT_EQ(naive(block, 1, 0, 63, 9), grid.Count(block, 1, 0, 63, 9));
+		ASSERT_EQ(naive(block, 64, 4, 100, 100), grid.Count(block, 64, 4, 100, 100));
+	}
+}
+
+PACKED_GRID_TEST(Finds_the_nearest_block)
+{
+	auto grid {GenerateTestingInstance()};
+	ASSERT_FALSE(grid.FindNearest(BlockType::Item, 10, 4));
+
+	grid.At(69, 0) = BlockType::Item;
+	ASSERT_EQ((std::pair<std::size_t, std::size_t> {69, 0}), grid.FindNearest(BlockType::Item, 10, 4));
+
+	// Diagonal steps count as one.
+	grid.At(13, 7) = BlockType::Item;
+	grid.At(10, 0) = BlockType::Item;
+	ASSERT_EQ((std::pair<std::size_t, std::size_t> {13, 7}), grid.FindNearest(BlockType::Item, 10, 4));
+
+	grid.At(8, 5) = BlockType::Item;
+	ASSERT_EQ((std::pair<std::size_t, std::size_t> {8, 5}), grid.FindNearest(BlockType::Item, 10, 4));
+	ASSERT_EQ((std::pair<std::size_t, std::size_t> {8, 5}), grid.FindNearest(BlockType::Item, 8, 5));
+}
@@ -0,0 +1,279 @@
+#include "pch.h"
+#include <Parser.hpp>
+#include <Compiler.hpp>
+#include <Assembler.hpp>
+
+#define PARSER_TEST(_testName)   TEST_F(ParserTests, _testName)
+#define COMPILER_TEST(_testName) TEST_F(CompilerTests, _testName)
+
+using namespace ArRobot;
+
+class ParserTests : public ::testing::Test
+{
+public:
+	static Parser GenerateTestingInstance()
+	{
+		return Parser {};
+	}
+};
+
+class CompilerTests : public ::testing::Test
+{
+public:
+	static Compiler GenerateTestingInstance()
+	{
+		return Compiler {};
+	}
+
+	static std::vector<CommandType> TypesOf(std::vector<Command> const& cmds, bool bSkipLabels = false)
+	{
+		std::vector<CommandType> res{};
+		for (auto const& cmd : cmds)
+		{
+			if (!bSkipLabels || cmd.GetType() != CommandType::MarkLabel)
+			{
+				res.push_back(cmd.GetType());
+			}
+		}
+		return res;
+	}
+};
+
+PARSER_TEST(Declarations)
+{
+	auto parser {GenerateTestingInstance()};
+	auto const tree {parser.Parse(
+		"#sticker WEST [-1, 0]\n"
+		"#proc main\n"
+		"{\n"
+		"	: Start\n"
+		"	Move $WEST\n"
+		"	Jump Start\n"
+		"}\n"
+		"#enum Block {\n"
+		"	Nothing,\n"
+		"	Wall,\n"
+		"}\n"
+	)};
+
+	auto const* pSticker {tree.FindSticker("WEST")};
+	ASSERT_NE(nullptr, pSticker);
+	ASSERT_EQ((std::vector {-1, 0}), (std::vector(pSticker->values.begin(), pSticker->values.end())));
+
+	auto const* pEnum {tree.FindEnum("Block")};
+	ASSERT_NE(nullptr, pEnum);
+	ASSERT_EQ(2, pEnum->members.size());
+	ASSERT_EQ(1, pEnum->IndexOf("Wall"));
+	ASSERT_FALSE(pEnum->IndexOf("Pit"));
+
+	auto const* pMain {tree.FindProc("main")};
+	ASSERT_NE(nullptr, pMain);
+	ASSERT_EQ(3, pMain->body.size());
+	ASSERT_EQ(Ast::StmtType::Label, pMain->body[0].type);
+	ASSERT_EQ("Start", pMain->body[0].name);
+	ASSERT_EQ(Ast::ArgType::Sticker, pMain->body[1].args.front().type);
+	ASSERT_EQ("Jump Start", tree.SpanToString(pMain->body[2].span));
+}
+
+PARSER_TEST(Procs_with_parameters)
+{
+	auto parser {GenerateTestingInstance()};
+	auto const tree {parser.Parse(
+		"#proc DoIfNotWall(cmd(int, int) func, int x, int y)\n"
+		"{\n"
+		"	Check x, y, Block.Wall\n"
+		"	JumpTrue Done\n"
+		"	func x, y\n"
+		"	: Done\n"
+		"}"
+	)};
+
+	auto const* pProc {tree.FindProc("DoIfNotWall")};
+	ASSERT_NE(nullptr, pProc);
+	ASSERT_EQ(3, pProc->params.size());
+	ASSERT_EQ("cmd", pProc->params[0].type);
+	ASSERT_EQ(2, pProc->params[0].typeArgs.size());
+	ASSERT_EQ("func", pProc->params[0].name);
+	ASSERT_TRUE(pProc->params[1].typeArgs.empty());
+
+	auto const& check {pProc->body[0]};
+	ASSERT_EQ(3, check.args.size());
+	ASSERT_EQ(Ast::ArgType::EnumMember, check.args[2].type);
+	ASSERT_EQ("Block", check.args[2].name);
+	ASSERT_EQ("Wall", check.args[2].member);
+}
+
+PARSER_TEST(Comments_and_invocations)
+{
+	auto parser {GenerateTestingInstance()};
+	auto const tree {parser.Parse(
+		"(* A comment\n spanning lines *)\n"
+		"#proc main { DoIfNotWall! Move, 1, 0 }"
+	)};
+
+	auto const& stmt {tree.FindProc("main")->body.front()};
+	ASSERT_EQ(Ast::StmtType::Invoke, stmt.type);
+	ASSERT_EQ("DoIfNotWall", stmt.name);
+	ASSERT_EQ(3, stmt.args.size());
+}
+
+PARSER_TEST(Syntax_errors)
+{
+	auto parser {GenerateTestingInstance()};
+	ASSERT_THROW(parser.Parse("#proc main { Move 1, 0"), ParseError);
+	ASSERT_THROW(parser.Parse("#proc main { Move 1 0 }"), ParseError);
+	ASSERT_THROW(parser.Parse("#proc main {}\n#proc main {}"), ParseError);
+	ASSERT_THROW(parser.Parse("#sticker A []"), ParseError);
+	ASSERT_THROW(parser.Parse("proc main {}"), ParseError);
+	ASSERT_THROW(parser.Parse("(* Never closed"), ParseError);
+}
+
+COMPILER_TEST(Lowers_main_into_commands)
+{
+	auto compiler {GenerateTestingInstance()};
+	auto const cmds {compiler.Compile(
+		"#sticker WEST [-1, 0]\n"
+		"#enum Block { Nothing, Wall }\n"
+		"#proc main\n"
+		"{\n"
+		"	: Start\n"
+		"	Check $WEST, Block.Wall\n"
+		"	JumpTrue Start\n"
+		"	Move $WEST\n"
+		"	Add 0, 1\n"
+		"	Not 2\n"
+		"}"
+	)};
+
+	using enum CommandType;
+	ASSERT_EQ((std::vector {MarkLabel, CheckDir, JumpTrue, Move, BinaryOp, BinaryOp}), TypesOf(cmds));
+
+	auto const& check {cmds[1].As<CheckDir>()};
+	ASSERT_EQ(-1, check.x);
+	ASSERT_EQ(BlockType::Wall, check.block);
+	ASSERT_EQ("Start", cmds[2].As<JumpTrue>().label);
+	ASSERT_EQ(OpCode::Not, cmds[5].As<BinaryOp>().opCode);
+	ASSERT_EQ(2, cmds[5].As<BinaryOp>().rhsAddr);
+}
+
+COMPILER_TEST(Semantic_errors)
+{
+	auto compiler {GenerateTestingInstance()};
+	ASSERT_THROW(compiler.Compile("#proc notMain {}"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { Fly 1, 2 }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { Move 1 }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { Move $NOWHERE }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { MemSet -1, 2 }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { Check 0, 1, 7 }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc main { Jump 5 }"), ParseError);
+}
+
+COMPILER_TEST(Procs_are_inlined)
+{
+	auto compiler {GenerateTestingInstance()};
+	auto const cmds {compiler.Compile(
+		"#sticker LEFT [-1, 0]\n"
+		"#proc main\n"
+		"{\n"
+		"	: Start\n"
+		"	DoIfNotWall! Move, $LEFT\n"
+		"	DoIfNotWall! Move, 1, 0\n"
+		"	Jump Start\n"
+		"}\n"
+		"#proc DoIfNotWall(cmd(int, int) func, int x, int y)\n"
+		"{\n"
+		"	Check x, y, Block.Wall\n"
+		"	JumpTrue Done\n"
+		"	func x, y\n"
+		"	: Done\n"
+		"}\n"
+		"#enum Block { Nothing, Wall, Pit, Item }\n"
+	)};
+
+	using enum CommandType;
+	ASSERT_EQ((std::vector {
+		MarkLabel, 
+		CheckDir, JumpTrue, Move, MarkLabel, 
+		CheckDir, JumpTrue, Move, MarkLabel, 
+		Jump,
+	}), TypesOf(cmds));
+	ASSERT_EQ(-1, cmds[3].As<Move>().x);
+	ASSERT_EQ(1, cmds[5].As<CheckDir>().x);
+
+	// Both expansions got a Done of their own.
+	ASSERT_EQ(cmds[2].As<JumpTrue>().label, cmds[4].As<MarkLabel>().label);
+	ASSERT_EQ(cmds[6].As<JumpTrue>().label, cmds[8].As<MarkLabel>().label);
+	ASSERT_NE(cmds[4].As<MarkLabel>().label, cmds[8].As<MarkLabel>().label);
+	ASSERT_NO_THROW(Asm::Assemble(cmds));
+}
+
+COMPILER_TEST(Known_arguments_remove_dead_branches)
+{
+	auto const code {
+		"#proc main\n"
+		"{\n"
+		"	MoveIf! 0\n"
+		"	MoveIf! 1\n"
+		"	Add 0, 1\n"
+		"}\n"
+		"#proc MoveIf(int cond)\n"
+		"{\n"
+		"	MemSet 15, cond\n"
+		"	JumpFalse Skip\n"
+		"	Move 1, 0\n"
+		"	: Skip\n"
+		"}\n"
+	};
+
+	using enum CommandType;
+	auto compiler {GenerateTestingInstance()};
+	compiler.SetOptimizing(false);
+	ASSERT_EQ((std::vector {MemSet, JumpFalse, Move, MemSet, JumpFalse, Move, BinaryOp}),
+		TypesOf(compiler.Compile(code), true));
+
+	compiler.SetOptimizing(true);
+	ASSERT_EQ((std::vector {Move, BinaryOp}), TypesOf(compiler.Compile(code), true));
+}
+
+COMPILER_TEST(Flag_reads_keep_their_checks)
+{
+	auto compiler {GenerateTestingInstance()};
+	auto const cmds {compiler.Compile(
+		"#proc main\n"
+		"{\n"
+		"	: Loop\n"
+		"	Check 1, 0, 1\n"
+		"	Check 0, 1, 1\n"
+		"	JumpFalse Loop\n"
+		"	MemSet 15, 3\n"
+		"	MemSet 0, 4\n"
+		"	Add 0, 15\n"
+		"	MemPrint 0\n"
+		"}\n"
+	)};
+
+	// The first Check gets overwritten before anyone reads it. Once the Add is folded, 
+	// nobody reads the MemSet to the flag either.
+	using enum CommandType;
+	ASSERT_EQ((std::vector {CheckDir, JumpFalse, MemSet, MemSet, MemPrint}), TypesOf(cmds, true));
+	ASSERT_EQ(1, cmds[1].As<CheckDir>().y);
+	ASSERT_EQ(7, cmds[4].As<MemSet>().value);
+}
+
+COMPILER_TEST(Invalid_invocations)
+{
+	auto compiler {GenerateTestingInstance()};
+	auto const withProc {[](std::string_view main) {
+		return std::format("#proc Go(cmd(int, int) func, int x) {{ func x, x }}\n"
+			"#proc main {{ {} }}", main);
+	}};
+
+	ASSERT_NO_THROW(compiler.Compile(withProc("Go! Move, 1")));
+	ASSERT_THROW(compiler.Compile(withProc("Go Move, 1")), ParseError);
+	ASSERT_THROW(compiler.Compile(withProc("Go! Move")), ParseError);
+	ASSERT_THROW(compiler.Compile(withProc("Go! 1, 1")), ParseError);
+	ASSERT_THROW(compiler.Compile(withProc("Go! Move, Move")), ParseError);
+	ASSERT_THROW(compiler.Compile(withProc("Go! PickUp, 1")), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc A { B! }\n#proc B { A! }\n#proc main { A! }"), ParseError);
+	ASSERT_THROW(compiler.Compile("#proc A(float x) {}\n#proc main { A! 1 }"), ParseError);
+}
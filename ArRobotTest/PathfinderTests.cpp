@@ -0,0 +1,150 @@
+#include "pch.h"
+#include <Pathfinder.hpp>
+#include <Assembler.hpp>
+#include <PlayField.hpp>
+
+#define PATHFINDER_TEST(_testName) TEST_F(PathfinderTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class PathfinderTests : public ::testing::Test
+{
+public:
+	// A wall down the middle with a gap at the bottom:
+	//   . . . # . .
+	//   . . . # . .
+	//   . . . # . .
+	//   . . . . . .
+	static Arge::Grid<BlockType> GenerateTestingInstance()
+	{
+		Arge::Grid<BlockType> res{6, 4, 1.0f, 1.0f};
+		for (std::size_t y{}; y < 3; ++y)
+		{
+			res.At(3, y) = BlockType::Wall;
+		}
+		return res;
+	}
+};
+
+PATHFINDER_TEST(A_star_goes_around_walls)
+{
+	auto const grid {GenerateTestingInstance()};
+	Pathfinder pathfinder{grid};
+
+	auto const path {pathfinder.FindPath({2, 0}, {4, 0})};
+	ASSERT_EQ(7, path.size());
+	ASSERT_EQ((std::pair {2, 0}), path.front());
+	ASSERT_EQ((std::pair {4, 0}), path.back());
+	ASSERT_EQ((std::pair {3, 3}), path[3]);
+	for (std::size_t i{1}; i < path.size(); ++i)
+	{
+		ASSERT_LE(std::abs(path[i].first - path[i - 1].first), 1);
+		ASSERT_LE(std::abs(path[i].second - path[i - 1].second), 1);
+		ASSERT_TRUE(Pathfinder::IsPassable(grid.At(path[i].first, path[i].second)));
+	}
+
+	ASSERT_EQ(1, pathfinder.FindPath({1, 1}, {1, 1}).size());
+	ASSERT_TRUE(pathfinder.FindPath({1, 1}, {3, 1}).empty());
+}
+
+PATHFINDER_TEST(Fields_count_steps_to_the_nearest)
+{
+	auto grid {GenerateTestingInstance()};
+	grid.At(5, 0) = BlockType::Item;
+	Pathfinder pathfinder{grid};
+
+	auto const& items {pathfinder.GetField(BlockType::Item)};
+	ASSERT_EQ(0, items.At(5, 0));
+	ASSERT_EQ(1, items.At(4, 1));
+	ASSERT_EQ(3, items.At(4, 3));
+	ASSERT_EQ(4, items.At(2, 3));
+	ASSERT_EQ(6, items.At(0, 0));
+	ASSERT_EQ(DistanceField::gc_Unreachable, items.At(3, 0));
+
+	// Going for walls, being next to one is as close as it gets.
+	auto const& walls {pathfinder.GetField(BlockType::Wall)};
+	ASSERT_EQ(0, walls.At(3, 1));
+	ASSERT_EQ(1, walls.At(2, 3));
+	ASSERT_EQ(3, walls.At(0, 3));
+	ASSERT_EQ((std::pair {0, 0}), walls.StepFrom(2, 3));
+	ASSERT_EQ((std::pair {1, 0}), walls.StepFrom(1, 0));
+
+	ASSERT_EQ((std::pair {0, 0}), pathfinder.StepToward(BlockType::Item, 5, 0));
+	ASSERT_EQ((std::pair {1, -1}), pathfinder.StepToward(BlockType::Item, 4, 1));
+	ASSERT_EQ(std::nullopt, pathfinder.StepToward(BlockType::Pit, 0, 0));
+	ASSERT_THROW(pathfinder.GetField(BlockType::Robot), GenericError);
+}
+
+PATHFINDER_TEST(Repairs_match_a_fresh_field)
+{
+	Arge::Grid<BlockType> grid{40, 30, 1.0f, 1.0f};
+	Pathfinder pathfinder{grid};
+	std::array constexpr targets {BlockType::Nothing, BlockType::Wall, BlockType::Pit, BlockType::Item};
+	for (auto const target : targets)
+	{
+		[[maybe_unused]] auto const& field {pathfinder.GetField(target)};
+	}
+
+	std::mt19937 rng{7};
+	std::uniform_int_distribution<std::int32_t> pickX{0, 39};
+	std::uniform_int_distribution<std::int32_t> pickY{0, 29};
+	// Mostly walls, so whole regions get cut off and opened up again.
+	std::discrete_distribution<std::int32_t> pickBlock{{3, 5, 1, 1}};
+	for (std::size_t i{}; i < 2000; ++i)
+	{
+		auto const x {pickX(rng)};
+		auto const y {pickY(rng)};
+		BlockType const oldBlock {grid.At(x, y)};
+		grid.At(x, y) = static_cast<BlockType>(pickBlock(rng));
+		pathfinder.OnBlockChanged(x, y, oldBlock);
+
+		if (i % 100 != 99)
+		{
+			continue;
+		}
+
+		for (auto const target : targets)
+		{
+			DistanceField const fresh{grid, target};
+			auto const& repaired {pathfinder.GetField(target)};
+			for (std::int32_t cy{}; cy < 30; ++cy)
+			{
+				for (std::int32_t cx{}; cx < 40; ++cx)
+				{
+					ASSERT_EQ(fresh.At(cx, cy), repaired.At(cx, cy))
+						<< "at " << cx << ", " << cy << " after " << i + 1 << " changes";
+				}
+			}
+		}
+	}
+}
+
+PATHFINDER_TEST(Robots_step_toward_items)
+{
+	auto constexpr program {R"(
+		: Walk
+		StepToward Item
+		JumpTrue Walk
+		PickUp
+		Halt
+	)"_arobot};
+
+	PlayField playField{};
+	playField.AddRobot(0, 0);
+	playField.SetBlock(2, 0, BlockType::Wall);
+	playField.SetBlock(2, 1, BlockType::Wall);
+	playField.SetBlock(4, 0, BlockType::Item);
+	playField.LoadProgram(program);
+
+	auto& robot {playField.GetRobot(0)};
+	for (std::size_t i{}; i < 30 && !robot.IsHalted(); ++i)
+	{
+		ASSERT_EQ(FaultCode::None, robot.Tick());
+	}
+	ASSERT_TRUE(robot.IsHalted());
+	ASSERT_EQ((std::pair {4, 0}), robot.GetPos());
+	ASSERT_TRUE(robot.IsCarryingItem());
+
+	ASSERT_THROW(Asm::ParseAssembly("StepToward Robot"), ParseError);
+}
@@ -0,0 +1,73 @@
+#include "pch.h"
+#include <Profiler.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+
+#define PROFILER_TEST(_testName) TEST_F(ProfilerTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class ProfilerTests : public ::testing::Test
+{
+public:
+	static Profiler GenerateTestingInstance()
+	{
+		return Profiler {};
+	}
+};
+
+namespace {
+	// Walks right until mem[0] runs out.
+	constexpr auto gc_Walker {R"(
+		MemSet 0, 3
+		MemSet 1, 1
+		: Loop
+		Move 1, 0
+		Sub 0, 1
+		MemCopy 15, 0
+		JumpTrue Loop
+	)"_arobot};
+}
+
+PROFILER_TEST(Counts_what_the_robot_ran)
+{
+	Arge::Grid<BlockType> grid{8, 8, 1.0f, 1.0f};
+	Robot robot{grid};
+	robot.ToggleProfiling(true);
+	robot.LoadProgram(gc_Walker);
+	for (std::size_t i{}; i < 100 && !robot.IsHalted(); ++i)
+	{
+		robot.Tick();
+	}
+
+	auto const& profiler {robot.GetProfiler()};
+	ASSERT_TRUE(std::ranges::equal(profiler.GetExecutionCounts(), std::array<std::uint64_t, 7> {1, 1, 3, 3, 3, 3, 0}));
+	ASSERT_EQ(2, profiler.GetBranchCounts()[5].taken);
+	ASSERT_EQ(1, profiler.GetBranchCounts()[5].notTaken);
+	ASSERT_EQ(3, profiler.GetTypeTotal(CommandType::Move));
+	ASSERT_EQ(14, profiler.GetTotal());
+
+	// The robot stops on the Halt, so it never runs it.
+	ASSERT_EQ(0, profiler.GetTypeTotal(CommandType::Halt));
+}
+
+PROFILER_TEST(Reports)
+{
+	auto profiler {GenerateTestingInstance()};
+	profiler.Reset(gc_Walker.size());
+	profiler.RecordExecution(2, CommandType::Move);
+	profiler.RecordExecution(2, CommandType::Move);
+	profiler.RecordExecution(5, CommandType::JumpTrue);
+	profiler.RecordBranch(5, true);
+
+	auto const text {profiler.ToText(gc_Walker)};
+	ASSERT_TRUE(text.starts_with("Ran 3 instructions\n"));
+	ASSERT_NE(std::string::npos, text.find("#2              2 (66.7%) [Move](x=1, y=0)\n"));
+	ASSERT_NE(std::string::npos, text.find("#5     taken 1, not taken 0 (100.0% taken)\n"));
+
+	auto const json {profiler.ToJson(gc_Walker)};
+	ASSERT_NE(std::string::npos, json.find("\"total\": 3"));
+	ASSERT_NE(std::string::npos, json.find("\"Move\": 2"));
+	ASSERT_NE(std::string::npos, json.find("{ \"index\": 5, \"type\": \"JumpTrue\", \"count\": 1, \"taken\": 1, \"notTaken\": 0 }"));
+}
@@ -0,0 +1,225 @@
+#include "pch.h"
+#include <Util/Random.hpp>
+#include <SimulationHost.hpp>
+
+#define RANDOM_TEST(_testName) TEST_F(RandomTests, _testName)
+
+using namespace ArRobot;
+
+class RandomTests : public ::testing::Test
+{
+public:
+	static Random::Stream GenerateTestingInstance()
+	{
+		return Random::Stream {0x1234'5678'9ABC'DEF0};
+	}
+
+	static std::vector<std::uint32_t> Draw(Random::Stream& rng, std::size_t count)
+	{
+		std::vector<std::uint32_t> res(count);
+		std::ranges::generate(res, std::ref(rng));
+		return res;
+	}
+};
+
+RANDOM_TEST(Matches_the_reference_philox)
+{
+	// From the Random123 known answers for philox4x32_10.
+	ASSERT_EQ((std::array<std::uint32_t, 4> {0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8}),
+		Random::Stream::Block({0, 0, 0, 0}, {0, 0}));
+
+	auto rng {Random::Stream {0}};
+	ASSERT_EQ(0x6627E8D5, rng());
+	ASSERT_EQ(0xE169C58D, rng());
+	static_assert(std::uniform_random_bit_generator<Random::Stream>);
+}
+
+RANDOM_TEST(Same_seed_same_numbers)
+{
+	auto lhs {GenerateTestingInstance()};
+	auto rhs {GenerateTestingInstance()};
+	ASSERT_EQ(Draw(lhs, 100), Draw(rhs, 100));
+
+	// Jumping ahead lands where drawing would have.
+	auto skipped {GenerateTestingInstance()};
+	skipped.Discard(37);
+	auto const all {Draw(rhs = GenerateTestingInstance(), 50)};
+	ASSERT_EQ(std::vector(all.begin() + 37, all.end()), Draw(skipped, 13));
+	ASSERT_EQ(50, skipped.GetPosition());
+}
+
+RANDOM_TEST(Splits_do_not_overlap)
+{
+	auto const root {GenerateTestingInstance()};
+	auto parent {root};
+	auto first {root.Split(0)};
+	auto again {root.Split(0)};
+	auto second {root.Split(1)};
+	ASSERT_EQ(Draw(first, 16), Draw(again, 16));
+
+	std::set<std::uint32_t> seen{};
+	for (auto* const pRng : {&parent, &first, &second})
+	{
+		for (auto const value : Draw(*pRng, 1000))
+		{
+			seen.insert(value);
+		}
+	}
+	// 3000 numbers out of four billion; a handful of repeats would already be suspicious.
+	ASSERT_GE(seen.size(), 2998);
+
+	// Splitting does not draw anything from the parent.
+	auto untouched {root};
+	auto const before {Draw(untouched, 4)};
+	[[maybe_unused]] auto const child {untouched.Split(5)};
+	ASSERT_EQ(4, untouched.GetPosition());
+	ASSERT_EQ(before, Draw(untouched = root, 4));
+}
+
+RANDOM_TEST(Fields_draw_the_same_on_any_number_of_threads)
+{
+	auto const drawAll {[](std::size_t threadCount) {
+		SimulationHost host{threadCount, 42};
+		std::vector<std::uint32_t> res{};
+		for (std::size_t i{}; i < 6; ++i)
+		{
+			auto& field {host.AddField()};
+			field.AddRobot(0, 0);
+			field.AddRobot(3, 3);
+			res.push_back(field.GetRng()());
+			field.ForEachRobot([&res](Robot& r) { res.push_back(r.GetRng()()); });
+		}
+		return res;
+	}};
+
+	auto const expected {drawAll(1)};
+	ASSERT_EQ(expected, drawAll(4));
+	ASSERT_EQ(18, std::set(expected.begin(), expected.end()).size());
+}
+
+RANDOM_TEST(Every_thread_starts_on_the_default_seed)
+{
+	std::array<std::uint32_t, 2> drawn{};
+	{
+		std::jthread first{[&drawn] { drawn[0] = Random::Engine()(); }};
+		std::jthread second{[&drawn] { drawn[1] = Random::Engine()(); }};
+	}
+	auto expected {Random::Stream {Random::gc_DefaultSeed}};
+	ASSERT_EQ(expected(), drawn[0]);
+	ASSERT_EQ(drawn[0], drawn[1]);
+}
+
+RANDOM_TEST(Bulk_fill_is_the_same_as_drawing)
+{
+	// Starting off a block boundary, and ending off one.
+	auto single {GenerateTestingInstance()};
+	auto bulk {GenerateTestingInstance()};
+	single.Discard(3);
+	bulk.Discard(3);
+
+	std::vector<std::uint32_t> filled(1001);
+	bulk.Fill(filled);
+	ASSERT_EQ(Draw(single, filled.size()), filled);
+	ASSERT_EQ(single(), bulk());
+}
+
+RANDOM_TEST(Filled_ints_are_in_range_and_even)
+{
+	auto rng {GenerateTestingInstance()};
+	std::vector<std::int32_t> values(60'000);
+	Random::FillInts(rng, values, -3, 2);
+
+	std::array<std::size_t, 6> counts{};
+	for (auto const value : values)
+	{
+		ASSERT_TRUE(-3 <= value && value <= 2) << value;
+		++counts[value + 3];
+	}
+	for (auto const count : counts)
+	{
+		// 10'000 expected, give or take about 90.
+		ASSERT_NEAR(10'000, count, 500);
+	}
+
+	// The whole range, and a range of one.
+	Random::FillInts(rng, values, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+	ASSERT_TRUE(std::ranges::any_of(values, [](std::int32_t value) { return value < 0; }));
+	Random::FillInts(rng, values, 7, 7);
+	ASSERT_TRUE(std::ranges::all_of(values, [](std::int32_t value) { return value == 7; }));
+
+	auto lhs {GenerateTestingInstance()};
+	auto rhs {GenerateTestingInstance()};
+	std::vector<std::int32_t> lhsValues(500), rhsValues(500);
+	Random::FillInts(lhs, lhsValues, 0, 1'000'000);
+	Random::FillInts(rhs, rhsValues, 0, 1'000'000);
+	ASSERT_EQ(lhsValues, rhsValues);
+}
+
+RANDOM_TEST(Filled_floats_and_bools)
+{
+	auto rng {GenerateTestingInstance()};
+	std::vector<float> floats(10'000);
+	Random::FillFloats(rng, floats, -2.0f, 6.0f);
+	ASSERT_TRUE(std::ranges::all_of(floats, [](float value) { return -2.0f <= value && value < 6.0f; }));
+	ASSERT_NEAR(2.0f, std::accumulate(floats.begin(), floats.end(), 0.0f) / 10'000.0f, 0.1f);
+
+	auto bools {std::make_unique<bool[]>(10'007)};
+	Random::FillBools(rng, {bools.get(), 10'007});
+	ASSERT_NEAR(5'003, std::count(bools.get(), bools.get() + 10'007, true), 300);
+}
+
+RANDOM_TEST(Filled_floats_never_reach_max)
+{
+	// Far from zero, floats are spaced too far apart for min + t * range to stay below max.
+	auto rng {GenerateTestingInstance()};
+	std::vector<float> floats(10'000);
+	auto const min {1'000'000.0f};
+	for (auto const max : {std::nextafter(min, 2'000'000.0f), min + 8.0f})
+	{
+		Random::FillFloats(rng, floats, min, max);
+		ASSERT_TRUE(std::ranges::all_of(floats, [&](float value) { return min <= value && value < max; }));
+	}
+}
+
+RANDOM_TEST(Filled_floats_cope_with_ranges_too_big_for_a_float)
+{
+	auto rng {GenerateTestingInstance()};
+	std::vector<float> floats(10'000);
+	auto const max {std::numeric_limits<float>::max()};
+	Random::FillFloats(rng, floats, -max, max);
+	ASSERT_TRUE(std::ranges::all_of(floats, [max](float value) { return -max <= value && value < max; }));
+	// Both halves get something, so it is not just stuck at one end.
+	ASSERT_TRUE(std::ranges::any_of(floats, [](float value) { return value < 0.0f; }));
+	ASSERT_TRUE(std::ranges::any_of(floats, [](float value) { return value > 0.0f; }));
+}
+
+// Not run by default; --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* to compare.
+RANDOM_TEST(DISABLED_Benchmark_fill_vs_generic)
+{
+	auto const time {[](std::string_view what, auto&& doWhat) {
+		auto const begin {std::chrono::steady_clock::now()};
+		auto const checksum {doWhat()};
+		std::chrono::duration<double, std::milli> const took {std::chrono::steady_clock::now() - begin};
+		std::cout << std::format("{:<24} {:>9.2f}ms (checksum {})\n", what, took.count(), checksum);
+	}};
+
+	std::vector<std::int32_t> ints(1 << 22);
+	time("Generic ints", [&] {
+		std::ranges::generate(ints, [] { return Random::Generic<std::int32_t>(0, 99); });
+		return std::accumulate(ints.begin(), ints.end(), std::int64_t{});
+	});
+	time("FillInts", [&] {
+		Random::FillInts(ints, 0, 99);
+		return std::accumulate(ints.begin(), ints.end(), std::int64_t{});
+	});
+
+	std::vector<float> floats(1 << 22);
+	time("Generic floats", [&] {
+		std::ranges::generate(floats, [] { return Random::Generic<float>(0.0f, 1.0f); });
+		return std::accumulate(floats.begin(), floats.end(), 0.0);
+	});
+	time("FillFloats", [&] {
+		Random::FillFloats(floats, 0.0f, 1.0f);
+		return std::accumulate(floats.begin(), floats.end(), 0.0);
+	});
+}
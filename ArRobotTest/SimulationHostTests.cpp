@@ -0,0 +1,126 @@
+#include "pch.h"
+#include <SimulationHost.hpp>
+#include <Assembler.hpp>
+
+#define SIMULATION_HOST_TEST(_testName) TEST_F(SimulationHostTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class SimulationHostTests : public ::testing::Test
+{
+public:
+	static SimulationHost GenerateTestingInstance(std::size_t threadCount)
+	{
+		return SimulationHost {threadCount};
+	}
+
+	// Counts to upTo in mem[0], then halts.
+	static std::vector<Instruction> MakeCounter(std::int32_t upTo)
+	{
+		return Asm::Assemble(std::format(R"(
+			MemSet 1, {}
+			MemSet 2, 1
+			: Loop
+			Add 0, 2
+			MemCopy 15, 0
+			Less 15, 1
+			JumpTrue Loop
+			Halt
+		)", upTo));
+	}
+};
+
+SIMULATION_HOST_TEST(Runs_every_field)
+{
+	auto host {GenerateTestingInstance(3)};
+	ASSERT_EQ(3, host.GetThreadCount());
+	host.Run(10); // Nothing to run yet.
+	ASSERT_EQ(0, host.GetFieldTicks());
+
+	for (std::size_t i{}; i < 8; ++i)
+	{
+		auto& field {host.AddField()};
+		field.AddRobot(0, 0);
+		field.AddRobot(1, 1);
+	}
+	host.Run(10);
+	host.Run(5);
+
+	// Robots without commands halt on their first tick, and done fields are not ticked again.
+	ASSERT_EQ(8, host.GetFieldTicks());
+	for (std::size_t i{}; i < host.GetFieldCount(); ++i)
+	{
+		ASSERT_EQ(1, host.GetStats(i).ticks);
+		ASSERT_EQ(2, host.GetStats(i).haltedCount);
+		ASSERT_EQ(0, host.GetStats(i).faultedCount);
+	}
+}
+
+SIMULATION_HOST_TEST(Same_results_on_any_number_of_threads)
+{
+	// Some fields are done way before the others.
+	std::vector<std::vector<Instruction>> programs{};
+	for (std::int32_t i{}; i < 12; ++i)
+	{
+		programs.push_back(MakeCounter(10 + i * 7));
+	}
+
+	std::vector<std::pair<std::int32_t, std::uint64_t>> expected{};
+	for (std::size_t const threadCount : {1, 2, 5})
+	{
+		auto host {GenerateTestingInstance(threadCount)};
+		for (auto const& program : programs)
+		{
+			auto& field {host.AddField()};
+			field.AddRobot(0, 0);
+			field.LoadProgram(program);
+		}
+		host.Run(100);
+		host.Run(1000);
+
+		std::vector<std::pair<std::int32_t, std::uint64_t>> found{};
+		for (std::size_t i{}; i < host.GetFieldCount(); ++i)
+		{
+			found.push_back({host.GetField(i).GetRobot(0).Deref(0), host.GetStats(i).ticks});
+			ASSERT_TRUE(host.GetField(i).IsDone());
+		}
+
+		if (expected.empty())
+		{
+			expected = found;
+		}
+		ASSERT_EQ(expected, found) << threadCount << " threads";
+		ASSERT_EQ(10 + 11 * 7, found.back().first);
+		ASSERT_GT(host.GetFieldTicksPerSecond(), 0.0);
+	}
+}
+
+// Not run by default; --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* to compare.
+SIMULATION_HOST_TEST(DISABLED_Benchmark_scaling)
+{
+	auto constexpr program {R"(
+		MemSet 2, 1
+		: Loop
+		Add 0, 2
+		Move 1, 0
+		Move -1, 0
+		Jump Loop
+	)"_arobot};
+
+	for (std::size_t threadCount {1}; threadCount <= SimulationHost::DefaultThreadCount(); threadCount *= 2)
+	{
+		auto host {GenerateTestingInstance(threadCount)};
+		for (std::size_t i{}; i < 256; ++i)
+		{
+			auto& field {host.AddField()};
+			for (std::int32_t y{}; y < 16; ++y)
+			{
+				field.AddRobot(0, y);
+			}
+			field.LoadProgram(program);
+		}
+		host.Run(2000);
+		std::cout << std::format("{:>3} threads {:>12.0f} field ticks/s\n", threadCount, host.GetFieldTicksPerSecond());
+	}
+}
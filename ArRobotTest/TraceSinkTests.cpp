@@ -0,0 +1,139 @@
+#include "pch.h"
+#include <TraceSink.hpp>
+#include <Assembler.hpp>
+#include <Robot.hpp>
+#include <PlayField.hpp>
+
+#define TRACE_SINK_TEST(_testName) TEST_F(TraceSinkTests, _testName)
+
+using namespace ArRobot;
+using namespace ArRobot::Literals;
+
+class TraceSinkTests : public ::testing::Test
+{
+public:
+	// Long enough that the background thread never gets there before Flush does.
+	static TraceSink GenerateTestingInstance(std::filesystem::path const& path)
+	{
+		return TraceSink {path, std::chrono::milliseconds{60'000}};
+	}
+
+	static std::string ReadFile(std::filesystem::path const& path)
+	{
+		std::ifstream file{path};
+		return std::string{std::istreambuf_iterator<char>{file}, {}};
+	}
+
+	std::filesystem::path GetLogPath() const
+	{
+		auto const* pInfo {::testing::UnitTest::GetInstance()->current_test_info()};
+		return std::filesystem::temp_directory_path() / std::format("ArRobot_{}.log", pInfo->name());
+	}
+};
+
+TRACE_SINK_TEST(Full_buffers_drop_instead_of_blocking)
+{
+	TraceBuffer buffer{"Test", 3};
+	ASSERT_EQ(4, buffer.GetCapacity());
+
+	TraceRecord const record{TraceKind::Tick};
+	for (std::size_t i{}; i < 4; ++i)
+	{
+		ASSERT_TRUE(buffer.TryPush(record));
+	}
+	ASSERT_FALSE(buffer.TryPush(record));
+
+	// All or nothing.
+	std::array<TraceRecord, 2> const pair {record, record};
+	ASSERT_FALSE(buffer.TryPush(pair));
+	ASSERT_EQ(3, buffer.GetDroppedCount());
+
+	std::vector<TraceRecord> drained{};
+	buffer.DrainInto(drained);
+	ASSERT_EQ(4, drained.size());
+	ASSERT_TRUE(buffer.TryPush(pair));
+}
+
+TRACE_SINK_TEST(Robots_trace_into_the_log)
+{
+	auto constexpr program {R"(
+		MemSet 0, 7
+		Move 1, 0
+		MemPrint 0
+		MemPrintAll
+	)"_arobot};
+
+	auto const path {GetLogPath()};
+	{
+		auto sink {GenerateTestingInstance(path)};
+		Arge::Grid<BlockType> grid{4, 4, 1.0f, 1.0f};
+		Robot robot{grid};
+		robot.ToggleDebugPrinting(true);
+		robot.SetTraceBuffer(sink.OpenBuffer("Bob"));
+		robot.LoadProgram(program);
+		for (std::size_t i{}; i < 4; ++i)
+		{
+			robot.Tick();
+		}
+		sink.Flush();
+	}
+
+	auto const log {ReadFile(path)};
+	std::filesystem::remove(path);
+
+	auto const memory {TraceSink::FormatMemory(std::array {7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0})};
+	ASSERT_EQ(
+		"[Bob] [MemSet](addr=0, val=7)\n"
+		"[Bob] [Move](x=1, y=0)\n"
+		"[Bob] mem[0] = 7\n"
+		"[Bob]\n" + memory, log);
+}
+
+TRACE_SINK_TEST(Memory_too_big_for_the_buffer_is_reported)
+{
+	auto constexpr program {R"(
+		MemPrintAll
+	)"_arobot};
+
+	auto const path {GetLogPath()};
+	{
+		auto sink {GenerateTestingInstance(path)};
+		Arge::Grid<BlockType> grid{4, 4, 1.0f, 1.0f};
+		Robot robot{grid};
+		auto const pBuffer {sink.OpenBuffer("Bob", 8)};
+		robot.SetTraceBuffer(pBuffer);
+		robot.LoadProgram(program, 16);
+		robot.Tick();
+		sink.Flush();
+		ASSERT_EQ(0, pBuffer->GetDroppedCount());
+	}
+
+	auto const log {ReadFile(path)};
+	std::filesystem::remove(path);
+	ASSERT_EQ("[Bob] memory of 16 cells does not fit in a buffer of 8 records\n", log);
+}
+
+TRACE_SINK_TEST(Robots_added_later_trace_too)
+{
+	auto constexpr program {R"(
+		MemSet 0, 7
+		MemPrint 0
+	)"_arobot};
+
+	auto const path {GetLogPath()};
+	{
+		auto sink {GenerateTestingInstance(path)};
+		PlayField playField{4, 4};
+		playField.AddRobot(0, 0);
+		playField.SetTraceSink(sink);
+		playField.AddRobot(1, 0);
+		playField.LoadProgram(program);
+		playField.ForEachRobot([](Robot& robot) { robot.Tick(); robot.Tick(); });
+		sink.Flush();
+	}
+
+	auto const log {ReadFile(path)};
+	std::filesystem::remove(path);
+	ASSERT_NE(std::string::npos, log.find("[Robot 0] mem[0] = 7\n"));
+	ASSERT_NE(std::string::npos, log.find("[Robot 1] mem[0] = 7\n"));
+}
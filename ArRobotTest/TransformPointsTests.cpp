@@ -0,0 +1,77 @@
+#include "pch.h"
+#include <Arge/Arge.hpp>
+
+#define TRANSFORM_POINTS_TEST(_testName) TEST_F(TransformPointsTests, _testName)
+
+class TransformPointsTests : public ::testing::Test
+{
+public:
+	static std::vector<Arge::Vec2> GenerateTestingInstance(std::size_t count)
+	{
+		std::mt19937 rng{7};
+		std::uniform_real_distribution<float> pick{-1000.0f, 1000.0f};
+		std::vector<Arge::Vec2> res(count);
+		for (auto& point : res)
+		{
+			point = {pick(rng), pick(rng)};
+		}
+		return res;
+	}
+
+	// What Camera::Trans does, one point at a time.
+	static Arge::Vec2 Trans(Arge::Vec2 const& point)
+	{
+		return (point - Translation) * Scale + Center;
+	}
+
+	static inline Arge::Vec2 const Translation {12.5f, -3.25f};
+	static inline Arge::Vec2 const Center {640.0f, 360.0f};
+	static constexpr float Scale {1.75f};
+};
+
+TRANSFORM_POINTS_TEST(Same_as_one_at_a_time)
+{
+	// Sizes around every vector width, so each leftover path gets a turn.
+	for (std::size_t count{}; count <= 19; ++count)
+	{
+		auto const points {GenerateTestingInstance(count)};
+		std::vector<Arge::Vec2> out(count);
+		Arge::TransformPoints(points, out, Translation, Scale, Center);
+		for (std::size_t i{}; i < count; ++i)
+		{
+			ASSERT_EQ(Trans(points[i]).x, out[i].x) << count << ' ' << i;
+			ASSERT_EQ(Trans(points[i]).y, out[i].y) << count << ' ' << i;
+		}
+	}
+}
+
+TRANSFORM_POINTS_TEST(Works_in_place)
+{
+	auto const points {GenerateTestingInstance(37)};
+	auto inPlace {points};
+	Arge::TransformPoints(inPlace, inPlace, Translation, Scale, Center);
+	for (std::size_t i{}; i < points.size(); ++i)
+	{
+		ASSERT_EQ(Trans(points[i]).x, inPlace[i].x);
+		ASSERT_EQ(Trans(points[i]).y, inPlace[i].y);
+	}
+}
+
+// Not run by default; --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* to compare.
+TRANSFORM_POINTS_TEST(DISABLED_Benchmark_batch_vs_one_at_a_time)
+{
+	auto const points {GenerateTestingInstance(1 << 20)};
+	std::vector<Arge::Vec2> out(points.size());
+	auto const time {[&out](std::string_view what, auto&& doWhat) {
+		auto const begin {std::chrono::steady_clock::now()};
+		for (std::size_t i{}; i < 20; ++i)
+		{
+			doWhat();
+		}
+		std::chrono::duration<double, std::milli> const took {std::chrono::steady_clock::now() - begin};
+		std::cout << std::format("{:<16} {:>8.2f}ms (checksum {})\n", what, took.count() / 20, out[out.size() / 2].x);
+	}};
+
+	time("One at a time", [&] { std::ranges::transform(points, out.begin(), Trans); });
+	time("TransformPoints", [&] { Arge::TransformPoints(points, out, Translation, Scale, Center); });
+}
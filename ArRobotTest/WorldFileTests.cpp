@@ -0,0 +1,169 @@
+#include "pch.h"
+#include <WorldFile.hpp>
+#include <Assembler.hpp>
+#include <MapGenerator.hpp>
+#include <PlayField.hpp>
+
+#define WORLD_FILE_TEST(_testName) TEST_F(WorldFileTests, _testName)
+
+using namespace ArRobot;
+
+class WorldFileTests : public ::testing::Test
+{
+public:
+	static constexpr std::string_view Source {
+		"#proc main\n"
+		"{\n"
+		"	Move 1, 0\n"
+		"	Move 1, 0\n"
+		"	Halt\n"
+		"}"
+	};
+
+	static WorldWriter GenerateTestingInstance()
+	{
+		Arge::Grid<BlockType> grid {101, 64, 25.0f, 30.0f};
+		MapGenerator generator {99, 1};
+		generator.Maze(grid);
+		generator.Scatter(grid, 0.05f, 0.0f);
+		// A straight corridor along the top row of rooms, for the robots to walk down.
+		for (std::size_t x {1}; x < 100; ++x)
+		{
+			grid.At(x, 1) = BlockType::Nothing;
+		}
+
+		WorldWriter writer {std::move(grid)};
+		auto const program {writer.AddSource(Source)};
+		writer.AddSpawn(1, 1, program);
+		writer.AddSpawn(7, 1, program);
+		return writer;
+	}
+
+	static std::filesystem::path TempPath()
+	{
+		return std::filesystem::temp_directory_path() / "ArRobotWorldFileTests.arworld";
+	}
+};
+
+WORLD_FILE_TEST(Round_trips_through_the_disk)
+{
+	auto writer {GenerateTestingInstance()};
+	auto const memory {writer.AddProgram(Asm::Assemble("Move 0, 1\nMemSet 20, 3"), 21)};
+	writer.AddSpawn(3, 1, memory);
+	writer.Write(TempPath());
+
+	{
+		WorldFile const world {TempPath()};
+		ASSERT_EQ(101, world.GetGrid().GetWidth());
+		ASSERT_EQ(64, world.GetGrid().GetHeight());
+		ASSERT_EQ(25.0f, world.GetCellWidth());
+		ASSERT_EQ(30.0f, world.GetCellHeight());
+		ASSERT_EQ(writer.Serialize().size(), world.GetBytes().size());
+
+		PlayField const playField {world};
+		auto const& grid {playField.GetGrid()};
+		for (std::size_t y{}; y < 64; ++y)
+		{
+			for (std::size_t x{}; x < 101; ++x)
+			{
+				ASSERT_EQ(grid.At(x, y), world.GetGrid().At(x, y));
+			}
+		}
+		ASSERT_GT(grid.Count(BlockType::Item, 0, 0, 101, 64), 0);
+
+		ASSERT_EQ((std::vector<Spawn> {{1, 1, 0}, {7, 1, 0}, {3, 1, 1}}),
+			std::vector(world.GetSpawns().begin(), world.GetSpawns().end()));
+		ASSERT_EQ(2, world.GetProgramCount());
+		ASSERT_EQ(21, world.GetMemorySize(1));
+		ASSERT_EQ(Cmd::gc_DefaultMemorySize, world.GetMemorySize(0));
+
+		// Nothing was copied out of the mapping.
+		auto const bytes {world.GetBytes()};
+		for (auto const* const pData : {
+			static_cast<void const*>(world.GetProgram(1).data()),
+			static_cast<void const*>(world.GetGrid().GetWords().data()),
+			static_cast<void const*>(world.GetSpawns().data())})
+		{
+			ASSERT_TRUE(bytes.data() <= pData && pData < bytes.data() + bytes.size());
+		}
+		ASSERT_EQ(CommandType::Move, world.GetProgram(1)[0].type);
+		ASSERT_EQ(20, world.GetProgram(1)[1].a);
+	}
+	std::filesystem::remove(TempPath());
+}
+
+WORLD_FILE_TEST(Robots_run_programs_straight_from_the_file)
+{
+	auto const bytes {GenerateTestingInstance().Serialize()};
+	WorldFile const world {bytes};
+	PlayField playField {world};
+	ASSERT_EQ(2, playField.GetRobotCount());
+	ASSERT_EQ(world.GetProgram(0).data(), playField.GetRobot(0).GetProgram().data());
+
+	playField.ToggleFaultPrinting(false);
+	for (std::size_t i{}; i < 100 && !playField.IsDone(); ++i)
+	{
+		playField.Tick();
+	}
+	ASSERT_TRUE(playField.IsDone());
+	for (auto const [index, x] : {std::pair {0, 3}, {1, 9}})
+	{
+		auto const& robot {playField.GetRobot(index)};
+		ASSERT_TRUE(robot.IsHalted());
+		ASSERT_EQ(std::pair(x, 1), robot.GetPos());
+	}
+}
+
+WORLD_FILE_TEST(Broken_files_are_rejected)
+{
+	using namespace WorldFormat;
+	auto const good {GenerateTestingInstance().Serialize()};
+	auto const open {[](std::vector<std::byte> const& bytes) { WorldFile const world {bytes}; }};
+	ASSERT_NO_THROW(open(good));
+
+	auto const broken {[&good](std::size_t offset, auto value) {
+		auto res {good};
+		std::memcpy(res.data() + offset, &value, sizeof(value));
+		return res;
+	}};
+	auto const sectionAt {[](std::size_t index) { return sizeof(Header) + index * sizeof(Section); }};
+
+	ASSERT_THROW(open({}), GenericError);
+	ASSERT_THROW(open(broken(0, 'X')), GenericError);
+	ASSERT_THROW(open(broken(offsetof(Header, version), std::uint32_t {2})), GenericError);
+	ASSERT_THROW(open(std::vector(good.begin(), good.end() - 1)), GenericError);
+	// A section that starts or ends past the end of the file.
+	ASSERT_THROW(open(broken(sectionAt(1) + offsetof(Section, offset), std::uint64_t {1} << 60)), GenericError);
+	ASSERT_THROW(open(broken(sectionAt(0) + offsetof(Section, size), std::uint64_t {16})), GenericError);
+	ASSERT_THROW(open(broken(sectionAt(0) + offsetof(Section, offset), std::uint64_t {4})), GenericError);
+	// No grid at all, then the same section twice.
+	ASSERT_THROW(open(broken(sectionAt(0) + offsetof(Section, type), std::uint32_t {77})), GenericError);
+	ASSERT_THROW(open(broken(sectionAt(1) + offsetof(Section, type), SectionType::Grid)), GenericError);
+
+	Section grid{};
+	std::memcpy(&grid, good.data() + sectionAt(0), sizeof(grid));
+	ASSERT_THROW(open(broken(grid.offset + offsetof(GridHeader, width), std::uint64_t {-1ULL})), GenericError);
+	ASSERT_THROW(open(broken(grid.offset + offsetof(GridHeader, bitsPerCell), std::uint32_t {4})), GenericError);
+
+	Section spawns{};
+	std::memcpy(&spawns, good.data() + sectionAt(1), sizeof(spawns));
+	ASSERT_THROW(open(broken(spawns.offset + offsetof(Spawn, program), std::uint32_t {1})), GenericError);
+	ASSERT_THROW(open(broken(spawns.offset + offsetof(Spawn, x), std::int32_t {-1})), GenericError);
+
+	Section programs{};
+	std::memcpy(&programs, good.data() + sectionAt(2), sizeof(programs));
+	ASSERT_THROW(open(broken(programs.offset, std::uint64_t {1'000'000})), GenericError);
+	ASSERT_THROW(open(broken(programs.offset + 8 + offsetof(ProgramEntry, instructionCount), std::uint64_t {1'000'000})),
+		GenericError);
+}
+
+WORLD_FILE_TEST(Writers_check_what_goes_in)
+{
+	auto writer {GenerateTestingInstance()};
+	ASSERT_THROW(writer.AddSpawn(101, 0, 0), GenericError);
+	ASSERT_THROW(writer.AddSpawn(0, 0, 1), GenericError);
+	ASSERT_THROW(writer.AddSource("#proc main { Move 1 }"), ParseError);
+	ASSERT_THROW(writer.AddProgram(Asm::Assemble("MemSet 16, 1")), ParseError);
+	ASSERT_THROW(writer.ImportSource("Does/Not/Exist.txt"), GenericError);
+	ASSERT_THROW(WorldFile {std::filesystem::path {"Does/Not/Exist.arworld"}}, GenericError);
+}